@@ -3,69 +3,68 @@
 #include <assert.h>
 #include <string.h>
 #include <stdbool.h>
-#include "list.h"
 #include "CleanCourse.h"
 
 
 /**
  * CleanCourse structure
  *
- * CleanCourse holds a list of courses with the last semesters the course was done by the student.
+ * CleanCourse holds every time a course was done by the student:
+ * the semester and the course grade itself (owned by the semester),
+ * sorted by semester, and in the order they were added inside a semester.
+ * The attempts are a sorted array carved from the course's arena, and a new attempt
+ * is put in its place with a binary search, so the array never needs sorting.
+ */
 
- * The following functions are available:
- * ff
+/**
+ * a time the course was done
  */
+typedef struct CourseAttempt_t{
+    int semester;
+    CourseGrade grade;
+} CourseAttempt;
 
 /**
- * definition of CleanCourse struct - a helper struct for printing clean sheets
+ * definition of CleanCourse struct - an index of a course in the grade sheet
  */
 struct CleanCourse_t{
     int course_id;
-    List last_semester;
+    CourseAttempt* attempts;
+    int attempts_count;
+    int attempts_capacity;
+    GradeArena arena;//the arena the course and its attempts came from
 };
 
-static ListElement lastSemesterCopy(ListElement element) {
-    if(element == NULL){
-        return NULL;
+//the place after the last attempt of the semester
+static int semesterEnd(CleanCourse course, int semester){
+    int low = 0, high = course->attempts_count;
+    while(low < high){
+        int middle = low + (high - low)/2;
+        if(course->attempts[middle].semester <= semester){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
     }
-    int *new = malloc(sizeof(int));
-    *new = *(int *)element;
-    return new? new : NULL;
+    return low;
 }
 
-static void freeLastSemester(ListElement element) {
-    free(element);
-}
-
-static int compareLastSemester(ListElement element1,ListElement element2,ListSortKey key) {
-    return *(int *)element1 - *(int *)element2;
-}
-
-CleanCourseResult cleanCourseCreate(int course_id,CleanCourse *course) {
+CleanCourseResult cleanCourseCreate(int course_id, GradeArena arena, CleanCourse *course) {
     if(course_id < 0 || course_id > 1000000){
         return CLEAN_COURSE_INVALID_PARAMETERS;
     }
-    *course = malloc(sizeof(struct CleanCourse_t));
+    *course = gradeArenaAlloc(arena,sizeof(struct CleanCourse_t));
     if((*course) == NULL){
         return CLEAN_COURSE_OUT_OF_MEMORY;
     }
-    (*course)->last_semester = listCreate(lastSemesterCopy,freeLastSemester);
     (*course)->course_id = course_id;
+    (*course)->attempts = NULL;
+    (*course)->attempts_count = 0;
+    (*course)->attempts_capacity = 0;
+    (*course)->arena = arena;
     return CLEAN_COURSE_SUCCESS;
 }
 
-CleanCourse cleanCourseCopy(CleanCourse course){
-    if(course == NULL){
-        return NULL;
-    }
-    CleanCourse new;
-    cleanCourseCreate(course->course_id,&new);
-    listDestroy(new->last_semester);
-    new->last_semester = listCopy(course->last_semester);
-    return new;
-}
-
-
 int getCleanCourseId(CleanCourse course){
     if(course==NULL){
         return -1;
@@ -73,18 +72,28 @@ int getCleanCourseId(CleanCourse course){
     return course->course_id;
 }
 
-CleanCourseResult cleanCourseAdd(CleanCourse course, int semester) {
-    if(course==NULL){
+CleanCourseResult cleanCourseAdd(CleanCourse course, int semester, CourseGrade grade) {
+    if(course==NULL || grade == NULL){
         return CLEAN_COURSE_INVALID_PARAMETERS;
     }
-    int *temp = malloc(sizeof(int));
-    if(temp == NULL){
-        return CLEAN_COURSE_OUT_OF_MEMORY;
+    if(course->attempts_count == course->attempts_capacity){
+        int capacity = course->attempts_capacity == 0 ? 1 : course->attempts_capacity*2;
+        CourseAttempt* attempts = gradeArenaRealloc(course->arena,course->attempts,
+                                                    sizeof(CourseAttempt)*course->attempts_capacity,
+                                                    sizeof(CourseAttempt)*capacity);
+        if(attempts == NULL){
+            return CLEAN_COURSE_OUT_OF_MEMORY;
+        }
+        course->attempts = attempts;
+        course->attempts_capacity = capacity;
     }
-    *temp = semester;
-    listInsertLast(course->last_semester,temp);
-    listSort(course->last_semester,compareLastSemester,0);
-    free(temp);
+    //the attempt goes after the other attempts of its semester
+    int place = semesterEnd(course,semester);
+    memmove(course->attempts + place + 1, course->attempts + place,
+            sizeof(CourseAttempt)*(course->attempts_count - place));
+    course->attempts[place].semester = semester;
+    course->attempts[place].grade = grade;
+    course->attempts_count++;
     return CLEAN_COURSE_SUCCESS;
 }
 
@@ -92,40 +101,141 @@ CleanCourseResult cleanCourseRemove(CleanCourse course, int semester) {
     if(course == NULL || semester<0){
         return CLEAN_COURSE_INVALID_PARAMETERS;
     }
-    LIST_FOREACH(int*,iterator,course->last_semester){
-        if(semester == *iterator){
-            listRemoveCurrent(course->last_semester);
-            return CLEAN_COURSE_SUCCESS;
-        }
+    int place = semesterEnd(course,semester) - 1;
+    if(place < 0 || course->attempts[place].semester != semester){
+        return CLEAN_COURSE_SEMESTER_NOT_EXISTS;
     }
-    return CLEAN_COURSE_SEMESTER_NOT_EXISTS;
+    memmove(course->attempts + place, course->attempts + place + 1,
+            sizeof(CourseAttempt)*(course->attempts_count - place - 1));
+    course->attempts_count--;
+    return CLEAN_COURSE_SUCCESS;
 }
 
 void print_check(CleanCourse course){
     if(course==NULL){
         return;
     }
-    LIST_FOREACH(int*,iterator,course->last_semester){
-        printf("%d,",*iterator);
+    for(int i = 0; i < course->attempts_count; i++){
+        printf("%d,",course->attempts[i].semester);
     }
     printf("\n");
 }
 /**
 * cleanCourseGetLastSemester-
  * @param- clean course
- * @return- last semester that course was done as int
+ * @return- last semester that course was done as int, -1 if it wasn't done
 */
 int cleanCourseGetLastSemester(CleanCourse course){
-    int last_semester = -1;
-    LIST_FOREACH(int*,iterator,course->last_semester){
-        last_semester=*iterator;
+    if(course->attempts_count == 0){
+        return -1;
+    }
+    return course->attempts[course->attempts_count-1].semester;
+}
+
+/**
+ * cleanCourseGetLatestGrade: returns the last time the course was done
+ * @param course
+ * @return
+ * NULL - if the course wasn't done
+ * the course grade - otherwise
+ */
+CourseGrade cleanCourseGetLatestGrade(CleanCourse course){
+    if(course->attempts_count == 0){
+        return NULL;
+    }
+    return course->attempts[course->attempts_count-1].grade;
+}
+
+/**
+ * cleanCourseGetBestGrade: returns the best grade the course was done with
+ * @param course
+ * @return
+ * -1 - if the course wasn't done
+ * the grade - otherwise
+ */
+int cleanCourseGetBestGrade(CleanCourse course){
+    int best = -1;
+    for(int i = 0; i < course->attempts_count; i++){
+        int grade = courseGradeReturnCourseGrade(course->attempts[i].grade);
+        if(grade > best){
+            best = grade;
+        }
+    }
+    return best;
+}
+
+//is the attempt the last one of its semester
+static bool lastInSemester(CleanCourse course, int i){
+    return i == course->attempts_count - 1 ||
+           course->attempts[i].semester != course->attempts[i+1].semester;
+}
+
+/**
+ * cleanCourseEffective: returns the effective points (doubled) and grade sum
+ * of the course
+ * @param course
+ * @param every_semester - count the last time in every semester (sport courses)
+ * @param points
+ * @param grade_sum
+ */
+void cleanCourseEffective(CleanCourse course, bool every_semester, int* points, int* grade_sum){
+    *points = 0;
+    *grade_sum = 0;
+    int first = every_semester ? 0 : course->attempts_count - 1;
+    for(int i = first; i >= 0 && i < course->attempts_count; i++){
+        if(lastInSemester(course,i)){
+            int course_points = courseGradeReturnCourseHalfPoints(course->attempts[i].grade);
+            *points += course_points;
+            *grade_sum += course_points*courseGradeReturnCourseGrade(course->attempts[i].grade);
+        }
+    }
+}
+
+/**
+ * cleanCourseNextEffective: returns the next effective time the course was done
+ * @param course
+ * @param every_semester - every semester counts (sport courses)
+ * @param place - where to continue from, moved past the time returned
+ * @param semester
+ * @return
+ * NULL - there are no more times
+ * the course grade - otherwise
+ */
+CourseGrade cleanCourseNextEffective(CleanCourse course, bool every_semester,
+                                     int* place, int* semester){
+    if(!every_semester && *place < course->attempts_count - 1){
+        *place = course->attempts_count - 1;
+    }
+    for(int i = *place; i >= 0 && i < course->attempts_count; i++){
+        if(lastInSemester(course,i)){
+            *place = i + 1;
+            *semester = course->attempts[i].semester;
+            return course->attempts[i].grade;
+        }
+    }
+    *place = course->attempts_count;
+    return NULL;
+}
+
+/**
+ * cleanCoursePrint: prints the effective grades of the course
+ * @param course
+ * @param file
+ * @param every_semester - print the last time in every semester (sport courses)
+ */
+void cleanCoursePrint(CleanCourse course, FILE* file, bool every_semester){
+    int first = every_semester ? 0 : course->attempts_count - 1;
+    for(int i = first; i >= 0 && i < course->attempts_count; i++){
+        if(lastInSemester(course,i)){
+            courseGradePrintCourseGrade(course->attempts[i].grade,file);
+        }
     }
-    return last_semester;
 }
 
 void destroyCleanCourse(CleanCourse course) {
     if(course != NULL){
-        listDestroy(course->last_semester);
+        gradeArenaFree(course->arena,course->attempts,
+                       sizeof(CourseAttempt)*course->attempts_capacity);
+        gradeArenaFree(course->arena,course,sizeof(struct CleanCourse_t));
     }
-    free(course);
 }
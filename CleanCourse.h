@@ -1,14 +1,30 @@
-
 #ifndef CLEANCOURSE_H
 #define CLEANCOURSE_H
 
+#include <stdio.h>
+#include <stdbool.h>
+#include "GradeArena.h"
+#include "CourseGrades.h"
+
 /**
  * CleanCourse structure
  *
- * CleanCourse holds a list of courses with the last semesters the course was done by the student.
+ * CleanCourse holds every time a course was done by the student:
+ * the semester and the course grade itself (owned by the semester),
+ * sorted by semester, and in the order they were added inside a semester.
 
  * The following functions are available:
- * ff
+ * cleanCourseCreate:           create a new cleanCourse
+ * getCleanCourseId:            returns the id of the course
+ * cleanCourseGetLastSemester:  returns the last semester the course was done
+ * cleanCourseGetLatestGrade:   returns the last time the course was done
+ * cleanCourseGetBestGrade:     returns the best grade of the course
+ * cleanCourseEffective:        returns the effective points and grade sum of the course
+ * cleanCourseNextEffective:    goes over the effective times the course was done
+ * cleanCourseAdd:              adds a time the course was done
+ * cleanCourseRemove:           removes the last time the course was done in a semester
+ * cleanCoursePrint:            prints the effective grades of the course
+ * destroyCleanCourse:          De-allocates a cleanCourse
  */
 
 typedef struct CleanCourse_t *CleanCourse;
@@ -24,13 +40,14 @@ typedef enum CleanCourseResult_t {
 /**
  * cleanCourseCreate: create a new cleanCourse
  * @param course_id
+ * @param arena - the arena the course and its semesters are allocated from (NULL for the heap)
  * @param course - pointer for creating the structure
  * @return
  * GRADE_SHEET_SUCCESS - grade added
  * GRADE_SHEET_OUT_OF_MEMORY - parameters aren't valid
  * GRADE_SHEET_INVALID_PARAMETERS - parameters aren't valid
  */
-CleanCourseResult cleanCourseCreate(int course_id,CleanCourse *course);
+CleanCourseResult cleanCourseCreate(int course_id, GradeArena arena, CleanCourse *course);
 
 /**
  * getCleanCourseId: returns the id of the course
@@ -43,29 +60,87 @@ int getCleanCourseId(CleanCourse course);
 /**
 * cleanCourseGetLastSemester-
  * @param- clean course
- * @return- last semester that course was done as int
+ * @return- last semester that course was done as int, -1 if it wasn't done
 */
 int cleanCourseGetLastSemester(CleanCourse course);
+
 /**
- * cleanCourseCopy: adds a semester the course was made
+ * cleanCourseGetLatestGrade: returns the last time the course was done
+ * (the last one added in its last semester)
  * @param course
  * @return
- * -1 - if null
- * course_id - otherwise - what we wanted
+ * NULL - if the course wasn't done
+ * the course grade - otherwise
  */
-CleanCourse cleanCourseCopy(CleanCourse course);
+CourseGrade cleanCourseGetLatestGrade(CleanCourse course);
 
 /**
- * cleanCourseAdd: adds a semester the course was made
+ * cleanCourseGetBestGrade: returns the best grade the course was done with
  * @param course
  * @return
- * -1 - if null
- * course_id - otherwise - what we wanted
+ * -1 - if the course wasn't done
+ * the grade - otherwise
  */
-CleanCourseResult cleanCourseAdd(CleanCourse course, int semester);
+int cleanCourseGetBestGrade(CleanCourse course);
 
+/**
+ * cleanCourseEffective: returns the effective points (doubled) and grade sum
+ * of the course - the last time it was done, or if every_semester is true
+ * the last time it was done in every semester (sport courses)
+ * @param course
+ * @param every_semester
+ * @param points - pointer for the effective points
+ * @param grade_sum - pointer for the effective grade sum
+ */
+void cleanCourseEffective(CleanCourse course, bool every_semester, int* points, int* grade_sum);
+
+/**
+ * cleanCourseNextEffective: goes over the times the course counts in the transcript -
+ * the last time it was done, or if every_semester is true the last time it was
+ * done in every semester (sport courses), ordered by semester
+ * @param course
+ * @param every_semester
+ * @param place - where to continue from (0 for the first time), moved past the time returned
+ * @param semester - pointer for the semester of the time returned
+ * @return
+ * NULL - there are no more times
+ * the course grade - otherwise
+ */
+CourseGrade cleanCourseNextEffective(CleanCourse course, bool every_semester,
+                                     int* place, int* semester);
+
+/**
+ * cleanCourseAdd: adds a time the course was done, after the other times of the semester
+ * @param course
+ * @param semester
+ * @param grade - the course grade added to the semester (not copied)
+ * @return
+ * CLEAN_COURSE_SUCCESS - added
+ * CLEAN_COURSE_INVALID_PARAMETERS - course or grade are NULL
+ * CLEAN_COURSE_OUT_OF_MEMORY - memory problem occurred
+ */
+CleanCourseResult cleanCourseAdd(CleanCourse course, int semester, CourseGrade grade);
+
+/**
+ * cleanCourseRemove: removes the last time the course was done in the semester
+ * @param course
+ * @param semester
+ * @return
+ * CLEAN_COURSE_SUCCESS - removed
+ * CLEAN_COURSE_INVALID_PARAMETERS - course is NULL or semester is negative
+ * CLEAN_COURSE_SEMESTER_NOT_EXISTS - the course wasn't done in the semester
+ */
 CleanCourseResult cleanCourseRemove(CleanCourse course, int semester);
 
+/**
+ * cleanCoursePrint: prints the last time the course was done, or if every_semester
+ * is true the last time it was done in every semester (sport courses)
+ * @param course
+ * @param file
+ * @param every_semester
+ */
+void cleanCoursePrint(CleanCourse course, FILE* file, bool every_semester);
+
 void print_check(CleanCourse course);
 
 void destroyCleanCourse(CleanCourse course);
@@ -0,0 +1,188 @@
+#define _POSIX_C_SOURCE 200112L//for pthread
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "CommandRing.h"
+
+/**
+ * CommandRing structure
+ *
+ * head - the number of entries the executor released, written by the executor only
+ * tail - the number of entries the reader published, written by the reader only
+ * the entry of a count is entries[count & mask], so the ring is full when the
+ * reader is capacity entries ahead of the executor, and empty when they are equal.
+ * every side keeps the last index it read of the other side, and reads the
+ * other side again only when the ring looks full (or empty) by it.
+ *
+ * waiting for the other side spins a little, and then sleeps on the lock.
+ * a side that goes to sleep marks itself waiting before checking the ring once
+ * more, and a side that moves its index checks the mark after moving it, so
+ * either the sleeper sees the new index or the other side sees the mark and
+ * wakes it up.
+ */
+
+#define CACHE_LINE 64
+#define SPINS 128//checks of the other side before going to sleep
+
+//the atomic operations are the builtins of gcc, since C99 has none
+#define LOAD(place) __atomic_load_n(&(place),__ATOMIC_SEQ_CST)
+#define STORE(place,value) __atomic_store_n(&(place),(value),__ATOMIC_SEQ_CST)
+
+/**
+ * definition of CommandRing struct
+ * the sides are kept in different cache lines, so moving one index doesn't
+ * take the line of the other side from its thread
+ */
+struct CommandRing_t{
+    CommandLineEntry* entries;
+    size_t mask;
+    //the executor's side
+    char executor_padding[CACHE_LINE];
+    size_t head;
+    size_t executor_tail;//the last tail the executor read
+    bool executor_waiting;
+    //the reader's side
+    char reader_padding[CACHE_LINE];
+    size_t tail;
+    size_t reader_head;//the last head the reader read
+    bool reader_waiting;
+    bool finished;
+    char end_padding[CACHE_LINE];
+    pthread_mutex_t lock;//only for sleeping, the entries are passed without it
+    pthread_cond_t room;
+    pthread_cond_t lines;
+};
+
+/**
+ * commandRingCreate: Creates a new empty ring.
+ * @return
+ * COMMAND_RING_SUCCESS - ring created
+ * COMMAND_RING_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandRingResult commandRingCreate(int capacity, CommandRing *ring){
+    assert(capacity > 0);
+    size_t size = 1;
+    while(size < (size_t)capacity){
+        size *= 2;
+    }
+    *ring = malloc(sizeof(struct CommandRing_t));
+    if(*ring == NULL){
+        return COMMAND_RING_OUT_OF_MEMORY;
+    }
+    (*ring)->entries = malloc(size*sizeof(CommandLineEntry));
+    if((*ring)->entries == NULL){
+        free(*ring);
+        *ring = NULL;
+        return COMMAND_RING_OUT_OF_MEMORY;
+    }
+    (*ring)->mask = size - 1;
+    (*ring)->head = 0;
+    (*ring)->executor_tail = 0;
+    (*ring)->executor_waiting = false;
+    (*ring)->tail = 0;
+    (*ring)->reader_head = 0;
+    (*ring)->reader_waiting = false;
+    (*ring)->finished = false;
+    pthread_mutex_init(&(*ring)->lock,NULL);
+    pthread_cond_init(&(*ring)->room,NULL);
+    pthread_cond_init(&(*ring)->lines,NULL);
+    return COMMAND_RING_SUCCESS;
+}
+
+static bool isFull(CommandRing ring){
+    return ring->tail - ring->reader_head > ring->mask;
+}
+
+//wakes the other side up if it's sleeping on condition
+static void wake(CommandRing ring, bool* waiting, pthread_cond_t* condition){
+    if(LOAD(*waiting)){
+        pthread_mutex_lock(&ring->lock);
+        pthread_cond_signal(condition);
+        pthread_mutex_unlock(&ring->lock);
+    }
+}
+
+CommandLineEntry* commandRingReserve(CommandRing ring){
+    for(int i = 0; i < SPINS && isFull(ring); i++){
+        ring->reader_head = LOAD(ring->head);
+    }
+    if(isFull(ring)){
+        pthread_mutex_lock(&ring->lock);
+        STORE(ring->reader_waiting,true);
+        ring->reader_head = LOAD(ring->head);
+        while(isFull(ring)){
+            pthread_cond_wait(&ring->room,&ring->lock);
+            ring->reader_head = LOAD(ring->head);
+        }
+        STORE(ring->reader_waiting,false);
+        pthread_mutex_unlock(&ring->lock);
+    }
+    return &ring->entries[ring->tail & ring->mask];
+}
+
+void commandRingPublish(CommandRing ring){
+    STORE(ring->tail,ring->tail + 1);
+    wake(ring,&ring->executor_waiting,&ring->lines);
+}
+
+void commandRingFinish(CommandRing ring){
+    STORE(ring->finished,true);
+    wake(ring,&ring->executor_waiting,&ring->lines);
+}
+
+/**
+ * readTail: reads the tail of the reader
+ * @return
+ * true - there's an entry to execute, or the reader finished
+ * false - the ring is empty, and more entries may come
+ */
+static bool readTail(CommandRing ring){
+    //the tail is read after the finished mark, so a finished ring has its last tail
+    bool finished = LOAD(ring->finished);
+    ring->executor_tail = LOAD(ring->tail);
+    return finished || ring->executor_tail != ring->head;
+}
+
+CommandLineEntry* commandRingPeek(CommandRing ring){
+    if(ring->executor_tail == ring->head){
+        bool ready = false;
+        for(int i = 0; i < SPINS && !ready; i++){
+            ready = readTail(ring);
+        }
+        if(!ready){
+            pthread_mutex_lock(&ring->lock);
+            STORE(ring->executor_waiting,true);
+            while(!readTail(ring)){
+                pthread_cond_wait(&ring->lines,&ring->lock);
+            }
+            STORE(ring->executor_waiting,false);
+            pthread_mutex_unlock(&ring->lock);
+        }
+        if(ring->executor_tail == ring->head){
+            return NULL;//finished, and everything was executed
+        }
+    }
+    return &ring->entries[ring->head & ring->mask];
+}
+
+void commandRingRelease(CommandRing ring){
+    STORE(ring->head,ring->head + 1);
+    wake(ring,&ring->reader_waiting,&ring->room);
+}
+
+/**
+ * commandRingDestroy: De-allocates a ring.
+ * @param ring
+ */
+void commandRingDestroy(CommandRing ring){
+    if(ring == NULL){
+        return;
+    }
+    pthread_mutex_destroy(&ring->lock);
+    pthread_cond_destroy(&ring->room);
+    pthread_cond_destroy(&ring->lines);
+    free(ring->entries);
+    free(ring);
+}
@@ -0,0 +1,107 @@
+#ifndef COMMANDRING_H
+#define COMMANDRING_H
+
+#include <stdbool.h>
+#include "mtm_ex3.h"
+#include "CommandStream.h"
+/**
+ * CommandRing structure
+ *
+ * CommandRing is a bounded queue of parsed lines passed from one thread that
+ * reads and parses a script to one thread that executes it, in the order they
+ * were read. Each side owns its own index, and an entry is handed over by
+ * publishing the index, so passing a line takes no lock.
+ * A side sleeps only when the ring is full (the reader) or empty (the executor),
+ * and is woken by the other side once there's room or a line again.
+ *
+ * An entry is filled in place: the reader reserves the next free entry, reads
+ * the line into it (or points its commands somewhere that outlives the ring),
+ * and publishes it. The executor peeks at the oldest entry, executes it and
+ * releases it back to the reader.
+
+ * The following functions are available:
+ * commandRingCreate:  Creates a new empty ring
+ * commandRingReserve: Returns the next free entry for the reader to fill
+ * commandRingPublish: Passes the reserved entry to the executor
+ * commandRingFinish:  Tells the executor there are no more entries
+ * commandRingPeek:    Returns the oldest entry for the executor
+ * commandRingRelease: Passes the oldest entry back to the reader
+ * commandRingDestroy: De-allocates a ring.
+ */
+
+#define COMMAND_RING_LINE_COMMANDS 3//a line runs up to 3 commands
+
+/** a parsed line: its commands, room for the line if it has to be read somewhere,
+ * and room for the strings of the commands */
+typedef struct CommandLineEntry_t {
+    Command commands[COMMAND_RING_LINE_COMMANDS];
+    int count;
+    char line[MAX_LEN+1];
+    char strings[MAX_LEN+1];
+} CommandLineEntry;
+
+/** Type for defining the ring */
+typedef struct CommandRing_t *CommandRing;
+
+/** Type used for returning error codes from ring functions */
+typedef enum CommandRingResult_t {
+    COMMAND_RING_OUT_OF_MEMORY,
+    COMMAND_RING_SUCCESS
+} CommandRingResult;
+
+/**
+ * commandRingCreate: Creates a new empty ring.
+ * @param capacity - the number of entries, rounded up to a power of 2
+ * @param ring - pointer to the ring created
+ * @return
+ * COMMAND_RING_SUCCESS - ring created
+ * COMMAND_RING_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandRingResult commandRingCreate(int capacity, CommandRing *ring);
+
+/**
+ * commandRingReserve: returns the next free entry, waiting for the executor
+ * to release one if the ring is full. Called by the reader only.
+ * @param ring
+ * @return the entry to fill, it's passed on only when it's published
+ */
+CommandLineEntry* commandRingReserve(CommandRing ring);
+
+/**
+ * commandRingPublish: passes the reserved entry to the executor.
+ * Called by the reader only.
+ * @param ring
+ */
+void commandRingPublish(CommandRing ring);
+
+/**
+ * commandRingFinish: tells the executor no more entries will be published.
+ * Called by the reader only, a reserved entry that wasn't published is dropped.
+ * @param ring
+ */
+void commandRingFinish(CommandRing ring);
+
+/**
+ * commandRingPeek: returns the oldest published entry, waiting for the reader
+ * to publish one if the ring is empty. Called by the executor only.
+ * @param ring
+ * @return
+ * NULL - the reader finished and all its entries were released
+ * the oldest entry - otherwise
+ */
+CommandLineEntry* commandRingPeek(CommandRing ring);
+
+/**
+ * commandRingRelease: passes the oldest entry back to the reader, after the
+ * executor is done with it. Called by the executor only.
+ * @param ring
+ */
+void commandRingRelease(CommandRing ring);
+
+/**
+ * commandRingDestroy: De-allocates a ring, once both sides are done with it.
+ * @param ring
+ */
+void commandRingDestroy(CommandRing ring);
+
+#endif //COMMANDRING_H
@@ -0,0 +1,430 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "CommandStream.h"
+
+/**
+ * CommandStream structure
+ *
+ * a created stream writes its commands to the file as they come, and keeps
+ * the strings (with a hash table from a string to its index) until it's closed.
+ * a loaded stream holds the whole file, with the strings copied out and terminated.
+ */
+
+#define STREAM_MAGIC "MTMB"
+#define STREAM_VERSION 1
+#define HEADER_SIZE 24//magic, version, commands, strings, strings offset (8 bytes)
+#define INITIAL_CAPACITY 16
+
+//how many numbers and strings every command type has
+static const int numbers_count[COMMAND_TYPES_COUNT] = {1,1,1,0,1,1,1,3,2,2,0,0,1,1,2,1};
+static const int strings_count[COMMAND_TYPES_COUNT] = {2,0,0,0,0,1,0,1,0,0,0,0,0,0,0,1};
+
+/**
+ * definition of CommandStream struct
+ */
+struct CommandStream_t{
+    FILE* file;//of a created stream
+    char** strings;
+    uint32_t* lengths;
+    int strings_count;
+    int strings_capacity;
+    int* slots;//hash table of string indexes, -1 for an empty slot
+    int slots_capacity;//always a power of 2
+    uint32_t commands_count;
+    unsigned char* data;//of a loaded stream
+    size_t size;
+    size_t place;//the next command to read
+    size_t commands_end;
+};
+
+int commandGetNumbersCount(CommandType type){
+    assert(type >= 0 && type < COMMAND_TYPES_COUNT);
+    return numbers_count[type];
+}
+
+int commandGetStringsCount(CommandType type){
+    assert(type >= 0 && type < COMMAND_TYPES_COUNT);
+    return strings_count[type];
+}
+
+static void writeNumber(unsigned char* bytes, uint32_t number){
+    for(int i = 0; i < 4; i++){
+        bytes[i] = (unsigned char)(number >> (8*i));
+    }
+}
+
+static uint32_t readNumber(const unsigned char* bytes){
+    uint32_t number = 0;
+    for(int i = 0; i < 4; i++){
+        number |= (uint32_t)bytes[i] << (8*i);
+    }
+    return number;
+}
+
+static uint32_t hashString(const char* string, size_t length){
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < length; i++){
+        hash = (hash ^ (unsigned char)string[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static CommandStream streamCreateEmpty(void){
+    CommandStream stream = malloc(sizeof(struct CommandStream_t));
+    if(stream == NULL){
+        return NULL;
+    }
+    stream->file = NULL;
+    stream->strings = NULL;
+    stream->lengths = NULL;
+    stream->strings_count = 0;
+    stream->strings_capacity = 0;
+    stream->slots = NULL;
+    stream->slots_capacity = 0;
+    stream->commands_count = 0;
+    stream->data = NULL;
+    stream->size = 0;
+    stream->place = 0;
+    stream->commands_end = 0;
+    return stream;
+}
+
+static void streamFree(CommandStream stream){
+    for(int i = 0; i < stream->strings_count; i++){
+        free(stream->strings[i]);
+    }
+    free(stream->strings);
+    free(stream->lengths);
+    free(stream->slots);
+    free(stream->data);
+    free(stream);
+}
+
+/**
+ * commandStreamCreate: Creates a new stream file to write commands to.
+ * @return
+ * COMMAND_STREAM_SUCCESS - stream created
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - the file can't be written
+ * COMMAND_STREAM_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandStreamResult commandStreamCreate(const char* path, CommandStream *stream){
+    *stream = streamCreateEmpty();
+    if(*stream == NULL){
+        return COMMAND_STREAM_OUT_OF_MEMORY;
+    }
+    (*stream)->file = fopen(path,"wb");
+    if((*stream)->file == NULL){
+        streamFree(*stream);
+        return COMMAND_STREAM_CANNOT_OPEN_FILE;
+    }
+    //the header is written when the stream is closed
+    unsigned char header[HEADER_SIZE] = {0};
+    if(fwrite(header,1,HEADER_SIZE,(*stream)->file) != HEADER_SIZE){
+        fclose((*stream)->file);
+        streamFree(*stream);
+        return COMMAND_STREAM_CANNOT_OPEN_FILE;
+    }
+    return COMMAND_STREAM_SUCCESS;
+}
+
+//rehashes the strings into a table twice as big
+static bool growSlots(CommandStream stream){
+    int capacity = stream->slots_capacity == 0 ? INITIAL_CAPACITY : stream->slots_capacity*2;
+    int* slots = malloc(sizeof(int)*capacity);
+    if(slots == NULL){
+        return false;
+    }
+    for(int i = 0; i < capacity; i++){
+        slots[i] = -1;
+    }
+    for(int i = 0; i < stream->strings_count; i++){
+        uint32_t slot = hashString(stream->strings[i],stream->lengths[i]) & (capacity - 1);
+        while(slots[slot] != -1){
+            slot = (slot + 1) & (capacity - 1);
+        }
+        slots[slot] = i;
+    }
+    free(stream->slots);
+    stream->slots = slots;
+    stream->slots_capacity = capacity;
+    return true;
+}
+
+/**
+ * internString: returns the index of the string in the stream,
+ * adding it if it's new. -1 if memory problem occurred
+ */
+static int internString(CommandStream stream, const char* string){
+    size_t length = strlen(string);
+    if((stream->strings_count + 1)*2 > stream->slots_capacity && !growSlots(stream)){
+        return -1;
+    }
+    uint32_t slot = hashString(string,length) & (stream->slots_capacity - 1);
+    while(stream->slots[slot] != -1){
+        int index = stream->slots[slot];
+        if(stream->lengths[index] == length && memcmp(stream->strings[index],string,length) == 0){
+            return index;
+        }
+        slot = (slot + 1) & (stream->slots_capacity - 1);
+    }
+    if(stream->strings_count == stream->strings_capacity){
+        int capacity = stream->strings_capacity == 0 ? INITIAL_CAPACITY :
+                       stream->strings_capacity*2;
+        char** strings = realloc(stream->strings,sizeof(char*)*capacity);
+        if(strings == NULL){
+            return -1;
+        }
+        stream->strings = strings;
+        uint32_t* lengths = realloc(stream->lengths,sizeof(uint32_t)*capacity);
+        if(lengths == NULL){
+            return -1;
+        }
+        stream->lengths = lengths;
+        stream->strings_capacity = capacity;
+    }
+    char* copy = malloc(length + 1);
+    if(copy == NULL){
+        return -1;
+    }
+    memcpy(copy,string,length + 1);
+    stream->strings[stream->strings_count] = copy;
+    stream->lengths[stream->strings_count] = (uint32_t)length;
+    stream->slots[slot] = stream->strings_count;
+    return stream->strings_count++;
+}
+
+/**
+ * commandStreamWrite: writes a command to the end of a created stream.
+ * @return
+ * COMMAND_STREAM_SUCCESS - command written
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - writing to the file failed
+ * COMMAND_STREAM_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandStreamResult commandStreamWrite(CommandStream stream, const Command* command){
+    assert(command->type >= 0 && command->type < COMMAND_TYPES_COUNT);
+    unsigned char bytes[1 + 4*(COMMAND_MAX_NUMBERS + COMMAND_MAX_STRINGS)];
+    size_t size = 0;
+    bytes[size++] = (unsigned char)command->type;
+    for(int i = 0; i < numbers_count[command->type]; i++){
+        writeNumber(bytes + size,(uint32_t)command->numbers[i]);
+        size += 4;
+    }
+    for(int i = 0; i < strings_count[command->type]; i++){
+        int index = internString(stream,command->strings[i]);
+        if(index < 0){
+            return COMMAND_STREAM_OUT_OF_MEMORY;
+        }
+        writeNumber(bytes + size,(uint32_t)index);
+        size += 4;
+    }
+    if(fwrite(bytes,1,size,stream->file) != size){
+        return COMMAND_STREAM_CANNOT_OPEN_FILE;
+    }
+    stream->commands_count++;
+    return COMMAND_STREAM_SUCCESS;
+}
+
+/**
+ * commandStreamClose: writes the strings and the header of a created stream,
+ * closes its file and de-allocates it.
+ * @return
+ * COMMAND_STREAM_SUCCESS - stream written
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - writing to the file failed
+ */
+CommandStreamResult commandStreamClose(CommandStream stream){
+    bool written = true;
+    long strings_offset = ftell(stream->file);
+    for(int i = 0; i < stream->strings_count && written; i++){
+        unsigned char length[4];
+        writeNumber(length,stream->lengths[i]);
+        written = fwrite(length,1,4,stream->file) == 4 &&
+                  fwrite(stream->strings[i],1,stream->lengths[i],stream->file) == stream->lengths[i];
+    }
+    unsigned char header[HEADER_SIZE];
+    memcpy(header,STREAM_MAGIC,4);
+    writeNumber(header + 4,STREAM_VERSION);
+    writeNumber(header + 8,stream->commands_count);
+    writeNumber(header + 12,(uint32_t)stream->strings_count);
+    writeNumber(header + 16,(uint32_t)((uint64_t)strings_offset & 0xFFFFFFFFu));
+    writeNumber(header + 20,(uint32_t)((uint64_t)strings_offset >> 32));
+    written = written && strings_offset >= 0 && fseek(stream->file,0,SEEK_SET) == 0 &&
+              fwrite(header,1,HEADER_SIZE,stream->file) == HEADER_SIZE;
+    written = (fclose(stream->file) == 0) && written;
+    streamFree(stream);
+    return written ? COMMAND_STREAM_SUCCESS : COMMAND_STREAM_CANNOT_OPEN_FILE;
+}
+
+//reads the whole file into the stream
+static CommandStreamResult readFile(const char* path, CommandStream stream){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return COMMAND_STREAM_CANNOT_OPEN_FILE;
+    }
+    size_t capacity = 0;
+    size_t read = 0;
+    do{
+        stream->size += read;
+        if(stream->size == capacity){
+            capacity = capacity == 0 ? 4096 : capacity*2;
+            unsigned char* data = realloc(stream->data,capacity);
+            if(data == NULL){
+                fclose(file);
+                return COMMAND_STREAM_OUT_OF_MEMORY;
+            }
+            stream->data = data;
+        }
+    } while((read = fread(stream->data + stream->size,1,capacity - stream->size,file)) > 0);
+    bool failed = ferror(file);
+    fclose(file);
+    return failed ? COMMAND_STREAM_CANNOT_OPEN_FILE : COMMAND_STREAM_SUCCESS;
+}
+
+//copies the strings out of the loaded file, terminated. they end the file.
+static CommandStreamResult loadStrings(CommandStream stream, size_t offset, uint32_t count){
+    //every string takes at least its length, so a bigger count isn't allocated
+    if(count > (stream->size - offset)/4){
+        return COMMAND_STREAM_BAD_FORMAT;
+    }
+    stream->strings = malloc(sizeof(char*)*(count > 0 ? count : 1));
+    if(stream->strings == NULL){
+        return COMMAND_STREAM_OUT_OF_MEMORY;
+    }
+    for(uint32_t i = 0; i < count; i++){
+        if(stream->size - offset < 4){
+            return COMMAND_STREAM_BAD_FORMAT;
+        }
+        uint32_t length = readNumber(stream->data + offset);
+        offset += 4;
+        if(stream->size - offset < length){
+            return COMMAND_STREAM_BAD_FORMAT;
+        }
+        char* string = malloc(length + 1);
+        if(string == NULL){
+            return COMMAND_STREAM_OUT_OF_MEMORY;
+        }
+        memcpy(string,stream->data + offset,length);
+        string[length] = '\0';
+        stream->strings[stream->strings_count++] = string;
+        offset += length;
+    }
+    return offset == stream->size ? COMMAND_STREAM_SUCCESS : COMMAND_STREAM_BAD_FORMAT;
+}
+
+//the size of the command in place, 0 if it doesn't fit the commands of the stream
+static size_t commandSize(CommandStream stream, size_t place){
+    unsigned char type = stream->data[place];
+    if(type >= COMMAND_TYPES_COUNT){
+        return 0;
+    }
+    size_t size = 1 + 4*(size_t)(numbers_count[type] + strings_count[type]);
+    if(stream->commands_end - place < size){
+        return 0;
+    }
+    const unsigned char* indexes = stream->data + place + 1 + 4*numbers_count[type];
+    for(int i = 0; i < strings_count[type]; i++){
+        if(readNumber(indexes + 4*i) >= (uint32_t)stream->strings_count){
+            return 0;
+        }
+    }
+    return size;
+}
+
+//checks that the commands of the header fill the commands part of the file exactly
+static bool checkCommands(CommandStream stream){
+    size_t place = HEADER_SIZE;
+    for(uint32_t i = 0; i < stream->commands_count; i++){
+        size_t size = place < stream->commands_end ? commandSize(stream,place) : 0;
+        if(size == 0){
+            return false;
+        }
+        place += size;
+    }
+    return place == stream->commands_end;
+}
+
+/**
+ * commandStreamLoad: loads a stream file to read its commands.
+ * @return
+ * COMMAND_STREAM_SUCCESS - stream loaded
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - the file can't be read
+ * COMMAND_STREAM_BAD_FORMAT - the file isn't a whole stream of this version
+ * COMMAND_STREAM_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandStreamResult commandStreamLoad(const char* path, CommandStream *stream){
+    *stream = streamCreateEmpty();
+    if(*stream == NULL){
+        return COMMAND_STREAM_OUT_OF_MEMORY;
+    }
+    CommandStreamResult result = readFile(path,*stream);
+    if(result != COMMAND_STREAM_SUCCESS){
+        streamFree(*stream);
+        return result;
+    }
+    unsigned char* data = (*stream)->data;
+    if((*stream)->size < HEADER_SIZE || memcmp(data,STREAM_MAGIC,4) != 0 ||
+       readNumber(data + 4) != STREAM_VERSION){
+        streamFree(*stream);
+        return COMMAND_STREAM_BAD_FORMAT;
+    }
+    uint64_t offset = readNumber(data + 16) | ((uint64_t)readNumber(data + 20) << 32);
+    if(offset < HEADER_SIZE || offset > (*stream)->size){
+        streamFree(*stream);
+        return COMMAND_STREAM_BAD_FORMAT;
+    }
+    result = loadStrings(*stream,(size_t)offset,readNumber(data + 12));
+    if(result != COMMAND_STREAM_SUCCESS){
+        streamFree(*stream);
+        return result;
+    }
+    (*stream)->commands_count = readNumber(data + 8);
+    (*stream)->place = HEADER_SIZE;
+    (*stream)->commands_end = (size_t)offset;
+    //a damaged or cut stream isn't executed at all, instead of running up to the damage
+    if(!checkCommands(*stream)){
+        streamFree(*stream);
+        return COMMAND_STREAM_BAD_FORMAT;
+    }
+    return COMMAND_STREAM_SUCCESS;
+}
+
+/**
+ * commandStreamNext: reads the next command of a loaded stream.
+ * the commands were all checked when the stream was loaded, so false is
+ * always the end of the stream and never a damaged command.
+ * @return
+ * true - a command was read
+ * false - there are no more commands
+ */
+bool commandStreamNext(CommandStream stream, Command* command){
+    if(stream->commands_count == 0){
+        return false;
+    }
+    unsigned char type = stream->data[stream->place];
+    assert(commandSize(stream,stream->place) > 0);
+    const unsigned char* bytes = stream->data + stream->place + 1;
+    command->type = (CommandType)type;
+    for(int i = 0; i < numbers_count[type]; i++, bytes += 4){
+        command->numbers[i] = (int)readNumber(bytes);
+    }
+    for(int i = 0; i < strings_count[type]; i++, bytes += 4){
+        command->strings[i] = stream->strings[readNumber(bytes)];
+    }
+    stream->place = (size_t)(bytes - stream->data);
+    stream->commands_count--;
+    return true;
+}
+
+/**
+ * commandStreamDestroy: De-allocates a loaded stream.
+ * @param stream
+ */
+void commandStreamDestroy(CommandStream stream){
+    if(stream == NULL){
+        return;
+    }
+    streamFree(stream);
+}
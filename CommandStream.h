@@ -0,0 +1,150 @@
+#ifndef COMMANDSTREAM_H
+#define COMMANDSTREAM_H
+
+#include <stdio.h>
+#include <stdbool.h>
+/**
+ * CommandStream structure
+ *
+ * CommandStream is a compiled command script: the commands of the script already
+ * parsed, with their numbers as ints and their words (names, points, actions)
+ * kept once in a table of strings. A script is compiled once, and the stream
+ * can then be executed many times without parsing the text again.
+ *
+ * The file starts with a header (magic, version, number of commands, number of
+ * strings and the offset of the strings), then the commands (a type byte followed
+ * by the numbers and the string indexes of the type), and then the strings.
+ * All the numbers in the file are little endian.
+
+ * The following functions are available:
+ * commandStreamCreate: Creates a new stream file to write commands to
+ * commandStreamWrite:  Writes a command to the end of the stream
+ * commandStreamClose:  Finishes writing the stream and de-allocates it
+ * commandStreamLoad:   Loads a stream file to read commands from
+ * commandStreamNext:   Reads the next command of a loaded stream
+ * commandStreamDestroy: De-allocates a loaded stream.
+ * commandGetNumbersCount: Returns how many numbers a command type has
+ * commandGetStringsCount: Returns how many strings a command type has
+ */
+
+#define COMMAND_MAX_NUMBERS 3
+#define COMMAND_MAX_STRINGS 2
+
+/** the commands of the course manager */
+typedef enum CommandType_t {
+    COMMAND_STUDENT_ADD,//id, first name, last name
+    COMMAND_STUDENT_REMOVE,//id
+    COMMAND_STUDENT_LOGIN,//id
+    COMMAND_STUDENT_LOGOUT,
+    COMMAND_STUDENT_FRIEND_REQUEST,//id
+    COMMAND_STUDENT_HANDLE_REQUEST,//id, action
+    COMMAND_STUDENT_UNFRIEND,//id
+    COMMAND_GRADE_SHEET_ADD,//semester, course id, grade, points
+    COMMAND_GRADE_SHEET_REMOVE,//semester, course id
+    COMMAND_GRADE_SHEET_UPDATE,//course id, grade
+    COMMAND_REPORT_FULL,
+    COMMAND_REPORT_CLEAN,
+    COMMAND_REPORT_BEST,//amount
+    COMMAND_REPORT_WORST,//amount
+    COMMAND_REPORT_REFERENCE,//course id, amount
+    COMMAND_REPORT_FACULTY_REQUEST,//course id, request
+    COMMAND_TYPES_COUNT
+} CommandType;
+
+/** a parsed command - the numbers and strings it uses, in the order listed above */
+typedef struct Command_t {
+    CommandType type;
+    int numbers[COMMAND_MAX_NUMBERS];
+    char* strings[COMMAND_MAX_STRINGS];
+} Command;
+
+/**
+ * commandGetNumbersCount: returns how many numbers a command of the type has
+ * @param type
+ * @return the number of numbers the command uses
+ */
+int commandGetNumbersCount(CommandType type);
+
+/**
+ * commandGetStringsCount: returns how many strings a command of the type has
+ * @param type
+ * @return the number of strings the command uses
+ */
+int commandGetStringsCount(CommandType type);
+
+/** Type for defining the stream */
+typedef struct CommandStream_t *CommandStream;
+
+/** Type used for returning error codes from stream functions */
+typedef enum CommandStreamResult_t {
+    COMMAND_STREAM_OUT_OF_MEMORY,
+    COMMAND_STREAM_CANNOT_OPEN_FILE,
+    COMMAND_STREAM_BAD_FORMAT,
+    COMMAND_STREAM_SUCCESS
+} CommandStreamResult;
+
+/**
+ * commandStreamCreate: Creates a new stream file to write commands to.
+ * @param path - the file created (overwritten if it exists)
+ * @param stream - pointer to the stream created
+ * @return
+ * COMMAND_STREAM_SUCCESS - stream created
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - the file can't be written
+ * COMMAND_STREAM_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandStreamResult commandStreamCreate(const char* path, CommandStream *stream);
+
+/**
+ * commandStreamWrite: writes a command to the end of a created stream.
+ * the strings of the command are copied to the stream once each.
+ * @param stream
+ * @param command
+ * @return
+ * COMMAND_STREAM_SUCCESS - command written
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - writing to the file failed
+ * COMMAND_STREAM_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandStreamResult commandStreamWrite(CommandStream stream, const Command* command);
+
+/**
+ * commandStreamClose: writes the strings and the header of a created stream,
+ * closes its file and de-allocates it.
+ * @param stream
+ * @return
+ * COMMAND_STREAM_SUCCESS - stream written
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - writing to the file failed
+ */
+CommandStreamResult commandStreamClose(CommandStream stream);
+
+/**
+ * commandStreamLoad: loads a stream file to read its commands.
+ * @param path
+ * @param stream - pointer to the stream loaded
+ * @return
+ * COMMAND_STREAM_SUCCESS - stream loaded
+ * COMMAND_STREAM_CANNOT_OPEN_FILE - the file can't be read
+ * COMMAND_STREAM_BAD_FORMAT - the file isn't a whole stream of this version
+ * (it was cut, or a command or a string in it is damaged)
+ * COMMAND_STREAM_OUT_OF_MEMORY - memory problem occurred
+ */
+CommandStreamResult commandStreamLoad(const char* path, CommandStream *stream);
+
+/**
+ * commandStreamNext: reads the next command of a loaded stream.
+ * the strings of the command belong to the stream. a loaded stream was checked
+ * whole, so reading it can't fail.
+ * @param stream
+ * @param command - filled with the command read
+ * @return
+ * true - a command was read
+ * false - there are no more commands
+ */
+bool commandStreamNext(CommandStream stream, Command* command);
+
+/**
+ * commandStreamDestroy: De-allocates a loaded stream.
+ * @param stream
+ */
+void commandStreamDestroy(CommandStream stream);
+
+#endif //COMMANDSTREAM_H
@@ -18,8 +18,9 @@
 struct CourseGrade_t{
     int course_id;
     char* points;
+    int half_points;//points doubled, so X.5 points are a whole number
     int grade;
-    int helper;
+    GradeArena arena;//the arena the course grade and its points came from
 };
 
 
@@ -49,32 +50,51 @@ static bool checkPoint(char* points){
     }
     return true;
 }
+//converts points already checked by checkPoint to doubled points
+static int pointsToHalfPoints(char* points){
+    int half_points = 0;
+    while(*points != '\0' && *points != '.'){
+        half_points = half_points*10 + (*points - '0');
+        points++;
+    }
+    half_points *= 2;
+    if(*points == '.' && *(points+1) == '5'){
+        half_points++;
+    }
+    return half_points;
+}
+
 /**
  * courseGradeCreate: Allocates a new empty CourseGrade.
  * @param course_id
  * @param points
  * @param grades
+ * @param arena - the arena the course grade is allocated from (NULL for the heap)
  * @param courseGrade - a pointer to return the created courseGrade
  * @return
  * COURSE_GRADE_SUCCESS - new grade sheet created
  * COURSE_GRADE_OUT_OF_MEMORY - memory problem occurred
  * COURSE_GRADE_INVALID_PARAMETERS
  */
-CourseGradeResult courseGradeCreate(int course_id, char* points,
-                                    int grade,CourseGrade *courseGrade){
+CourseGradeResult courseGradeCreate(int course_id, char* points, int grade,
+                                    GradeArena arena, CourseGrade *courseGrade){
     if(course_id >= 10000000 || course_id <= 0 ||grade < 0
        || grade > 100 || !checkPoint(points)){
         return COURSE_GRADE_INVALID_PARAMETERS;
     }
-    *courseGrade = malloc(sizeof(struct CourseGrade_t));
+    *courseGrade = gradeArenaAlloc(arena,sizeof(struct CourseGrade_t));
     if((*courseGrade) == NULL){
         return COURSE_GRADE_OUT_OF_MEMORY;
     }
-    (*courseGrade)->points = malloc(sizeof(char)*((strlen(points))+1));
+    (*courseGrade)->points = gradeArenaAlloc(arena,sizeof(char)*((strlen(points))+1));
     if((*courseGrade)->points == NULL){
+        gradeArenaFree(arena,*courseGrade,sizeof(struct CourseGrade_t));
+        *courseGrade = NULL;
         return COURSE_GRADE_OUT_OF_MEMORY;
     }
+    (*courseGrade)->arena = arena;
     strcpy((*courseGrade)->points,points);
+    (*courseGrade)->half_points = pointsToHalfPoints(points);
     (*courseGrade)->course_id = course_id;
     (*courseGrade)->grade = grade;
     return COURSE_GRADE_SUCCESS;
@@ -97,29 +117,6 @@ CourseGradeResult courseGradeUpdateGrade(CourseGrade courseGrade, int grade){
     courseGrade->grade = grade;
     return COURSE_GRADE_SUCCESS;
 }
-static int convertStringToInt(char* string){
-    while(*string == '0'){
-        string++;
-    }
-    char *temp = string;//will iterate to get number of digits that's not 0
-    int counter = 1;
-    temp++;
-    while(*temp != '\0' && *temp != '.'){
-        counter*=10;
-        temp++;
-    }
-    double num = 0;
-    while(*string != '\0' && *string != '.'){
-        num+= (double)(*string - '0')*counter;
-        string++;
-        counter/=10;
-    }
-    if(*string!='\0'){
-        string++;
-        num+= (double)((*string)-'0')/10;
-    }
-    return (int)(num*2);
-}
 /**
  * courseGradePrintCourseGrade: prints a course grade with the given output functions
  * @param courseGrade
@@ -132,7 +129,7 @@ CourseGradeResult courseGradePrintCourseGrade(CourseGrade courseGrade, FILE* fil
         return COURSE_GRADE_INVALID_PARAMETERS;
     }
     mtmPrintGradeInfo(file,courseGrade->course_id,
-                      convertStringToInt(courseGrade->points),courseGrade->grade);
+                      courseGrade->half_points,courseGrade->grade);
     return COURSE_GRADE_SUCCESS;
 }
 
@@ -152,15 +149,19 @@ int courseGradeCompareGrade(CourseGrade courseGrade1,CourseGrade courseGrade2){
 /**
  * courseGradeCopy: compare the courses by Id
  * @param courseGrade1
+ * @param arena - the arena the copy is allocated from (NULL for the heap)
  * @return
  * copies courseGrade 1 into a new courseGrade structure (with allocation of memory)
  */
-CourseGrade courseGradeCopy(CourseGrade courseGrade1){
+CourseGrade courseGradeCopy(CourseGrade courseGrade1, GradeArena arena){
     if(courseGrade1 == NULL){
         return NULL;
     }
     CourseGrade new;
-    courseGradeCreate(courseGrade1->course_id, courseGrade1->points,courseGrade1->grade,&new);
+    if(courseGradeCreate(courseGrade1->course_id, courseGrade1->points,
+                         courseGrade1->grade,arena,&new) != COURSE_GRADE_SUCCESS){
+        return NULL;
+    }
     return new;
 }
 
@@ -202,31 +203,16 @@ char* courseGradeReturnCoursePoints(CourseGrade courseGrade){
     return  courseGrade->points;
 }
 /**
- * courseGradeInsertHelper: insert the helper in to course grade
- * @param courseGrade
- * @return
- * COURSE_GRADE_SUCCESS - new grade sheet created
- * COURSE_GRADE_INVALID_PARAMETERS - if NULL
- */
-CourseGradeResult courseGradeInsertHelper(CourseGrade courseGrade,int helper){
-    if(courseGrade == NULL){
-        return COURSE_GRADE_INVALID_PARAMETERS;
-    }
-    courseGrade->helper = helper;
-    return COURSE_GRADE_SUCCESS;
-}
-/**
- * courseGradeGetHelper- get the helper from the coursegrade
+ * courseGradeReturnCourseHalfPoints: gets a courseGrade and returns its points doubled
  * @param courseGrade
  * @return
- * -1 if course is null
- * else - helper
+ * doubled points or -1 if courseGrade is NULL
  */
-int courseGradeGetHelper(CourseGrade courseGrade){
+int courseGradeReturnCourseHalfPoints(CourseGrade courseGrade){
     if(courseGrade == NULL){
         return -1;
     }
-    return courseGrade->helper;
+    return courseGrade->half_points;
 }
 /**
  * courseGradeDestroy: De-allocates a new empty CourseGrade.
@@ -234,8 +220,9 @@ int courseGradeGetHelper(CourseGrade courseGrade){
  * @return
  */
 void courseGradeDestroy(CourseGrade courseGrade){
-    free(courseGrade->points);
-    free(courseGrade);
+    gradeArenaFree(courseGrade->arena,courseGrade->points,
+                   sizeof(char)*((strlen(courseGrade->points))+1));
+    gradeArenaFree(courseGrade->arena,courseGrade,sizeof(struct CourseGrade_t));
 }
 
 
@@ -2,6 +2,8 @@
 #ifndef COURSEGRADES_H
 #define COURSEGRADES_H
 
+#include "GradeArena.h"
+
 /**
  * CourseGrade structure
  *
@@ -28,13 +30,15 @@ typedef enum CourseGradeResult_t {
  * @param course_id
  * @param points
  * @param grades
+ * @param arena - the arena the course grade is allocated from (NULL for the heap)
  * @param courseGrade - a pointer to return the created courseGrade
  * @return
  * COURSE_GRADE_SUCCESS - new grade sheet created
  * COURSE_GRADE_OUT_OF_MEMORY - memory problem occurred
  * COURSE_GRADE_INVALID_PARAMETERS
  */
-CourseGradeResult courseGradeCreate(int course_id, char* points, int grade,CourseGrade *courseGrade);
+CourseGradeResult courseGradeCreate(int course_id, char* points, int grade,
+                                    GradeArena arena, CourseGrade *courseGrade);
 
 /**
  * courseGradeUpdateGrade: updates a grade for CourseGrade.
@@ -68,10 +72,11 @@ int courseGradeCompareGrade(CourseGrade courseGrade1,CourseGrade courseGrade2);
 /**
  * courseGradeCopy: compare the courses by Id
  * @param courseGrade1
+ * @param arena - the arena the copy is allocated from (NULL for the heap)
  * @return
  * copies courseGrade 1 into a new courseGrade structure (with allocation of memory)
  */
-CourseGrade courseGradeCopy(CourseGrade courseGrade1);
+CourseGrade courseGradeCopy(CourseGrade courseGrade1, GradeArena arena);
 
 /**
  * courseGradeReturnCourseid: gets a courseGrade and returns the id of the course
@@ -96,28 +101,18 @@ int courseGradeReturnCourseGrade(CourseGrade courseGrade);
  */
 char* courseGradeReturnCoursePoints(CourseGrade courseGrade);
 /**
- * courseGradeInsertHelper: insert the helper in to course grade
+ * courseGradeReturnCourseHalfPoints: gets a courseGrade and returns its points doubled
  * @param courseGrade
  * @return
- * COURSE_GRADE_SUCCESS - new grade sheet created
- * COURSE_GRADE_INVALID_PARAMETERS - if NULL
+ * doubled points or -1 if courseGrade is NULL
  */
-CourseGradeResult courseGradeInsertHelper(CourseGrade courseGrade,int helper);
+int courseGradeReturnCourseHalfPoints(CourseGrade courseGrade);
 /**
  * courseGradeDestroy: De-allocates a new empty CourseGrade.
  * @param course_id
  * @return
  * COURSE_GRADE_SUCCESS - new grade sheet created
  */
-int courseGradeGetHelper(CourseGrade courseGrade);
-
-/**
- * courseGradeGetHelper- get the helper from the coursegrade
- * @param courseGrade
- * @return
- * -1 if course is null
- * else - helper
- */
 void courseGradeDestroy(CourseGrade courseGrade);
 
 
@@ -1,17 +1,28 @@
+#define _POSIX_C_SOURCE 200112L//flockfile and the threads
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
 #include <stdbool.h>
-#include "list.h"
+#include <pthread.h>
 #include "mtm_ex3.h"
 #include "GradeSheet.h"
 #include "CleanCourse.h"
 #include "SemesterGrades.h"
 #include "CourseGrades.h"
 #include "Student.h"
+#include "StudentTable.h"
+#include "RequestTable.h"
+#include "EnrollmentTable.h"
+#include "GradeRanking.h"
+#include "Snapshot.h"
+#include "CommandStream.h"
+#include "Journal.h"
 #include "CourseManager.h"
 #define  MTM_SUCCESS -1
+#ifndef JOURNAL_COMPACT_SIZE
+#define JOURNAL_COMPACT_SIZE 100000//changes in the journal that start a compaction
+#endif
 
 /**
  * Generic CourseManager System
@@ -37,87 +48,79 @@
  *   reportWorst            - Prints the worst grades of the logged student
  *   reportReference        - Prints all the students who have done the course and received a grade
  *   reportFacultyRequest   - Prints an answer to a faculty request
+ *   courseManagerSave      - Writes the whole state of the system to a snapshot file
+ *   courseManagerLoad      - Creates a system from a snapshot file
+ *   courseManagerRecover   - Creates a system from a snapshot and the journal after it
+ *   courseManagerCompact   - Folds the journal into a new snapshot in the background
+ *   sessionOpen            - Opens a session of a student, beside the logged in student
+ *   sessionClose           - Closes a session
+ *   session*               - The student and grade sheet functions and the reports,
+ *                            for the student of a session
  *
  *   Errors - all the functions will return error codes as fragged in ex3.h or -1 if success
  *   MTM_SUCCESS = -1!!!
  */
 
-typedef struct Request_t{
-    int id_asking;
-    int id_asked;
-}*Request;
+/**
+ * Locking
+ *
+ * the system may be called from many threads at once, each serving its own sessions.
+ * lock - taken shared by every function of a student (so no student is removed
+ *        under it), and alone by the functions that add or remove students, log in
+ *        and out, or go over the whole system (saving and compacting).
+ * student_locks - the grade sheet and the friends of a student are under the lock
+ *        of its id. a function of two students takes both locks, the lower one first.
+ *        the reports only read the student, so they take its lock shared.
+ * enrollment_locks - the enrollments are split by course id into tables of their
+ *        own, each under its lock, so grade changes in different courses don't wait
+ *        for each other.
+ * requests_lock, sessions_lock - the shared tables, taken last and for a short while.
+ * journal_lock - the sequence and the journal. a change is recorded before it's made,
+ *        under the locks of its students, so changes to the same students are journaled
+ *        in the order they were made, and a change that can't be recorded isn't made.
+ * compaction_lock - tells when a compaction is due, and when the thread saving a
+ *        compaction is done. a change checks if it made a compaction due under this
+ *        lock alone, so it doesn't wait for the journal to be written again.
+ */
+#define STUDENT_LOCK_STRIPES 256
+#define ENROLLMENT_STRIPES 16
+
+//a lock in cache lines of its own, so the locks of an array taken by different
+//threads don't share a line
+typedef union StripeLock_t {
+    pthread_rwlock_t lock;
+    char lines[128];
+} StripeLock;
 
 /** Type for defining the student */
 struct CourseManager_t {
-    List students;
-    int connectedStudent;
-    List friendshipRequest;
+    StudentTable students;
+    Session loggedIn;//the session of the logged in student, NULL when no one is logged in
+    Session sessions;//all the open sessions, the logged in student's among them
+    RequestTable friendshipRequest;
+    EnrollmentTable enrollments[ENROLLMENT_STRIPES];//the students of every course, with
+                                                    //their best grades, by course id
+    int sequence;//the number of changes made to the system, kept in its snapshots
+    Journal journal;//where the changes are recorded, NULL when there's no journal
+    char* snapshot_path;//the snapshot the journal is compacted into
+    char* journal_path;
+    bool old_journal;//a rotated journal is waiting to be folded into the snapshot
+    bool journal_failed;//the journal doesn't match the system, until it's compacted
+    pthread_t compaction;//the thread saving the snapshot of a compaction
+    bool compaction_due;//the journal grew too big or failed, and wasn't compacted yet
+    bool compacting;//there's a compaction thread to join
+    bool compaction_done;//the thread is done saving
+    bool compaction_saved;//the thread saved the snapshot and removed the old journal
+    Snapshot compaction_snapshot;//the snapshot the thread saves
+    pthread_rwlock_t lock;
+    StripeLock student_locks[STUDENT_LOCK_STRIPES];
+    StripeLock enrollment_locks[ENROLLMENT_STRIPES];
+    pthread_mutex_t requests_lock;
+    pthread_mutex_t sessions_lock;
+    pthread_mutex_t journal_lock;
+    pthread_mutex_t compaction_lock;
 };
 
-static void RequestFreeForList(Request request){
-    assert(request!=NULL);
-    free(request);
-}
-static void freeRequest(ListElement element) {
-    RequestFreeForList(element);
-}
-
-static int getIdAsked(Request request){
-    assert(request!=NULL);
-    return request->id_asked;
-}
-static int getIdAsking(Request request){
-    assert(request!=NULL);
-    return request->id_asking;
-}
-
-static Request RequestCopyForList(Request request){
-    assert(request!=NULL);
-    Request new = malloc(sizeof(struct Request_t));
-    //new->id_asked = malloc(sizeof(int));
-    new->id_asked = getIdAsked(request);
-    //new->id_asking = malloc(sizeof(int));
-    new->id_asking = getIdAsking(request);
-    return new;
-}
-static ListElement RequestCopy(ListElement element) {
-    if(element == NULL){
-        return NULL;
-    }
-    Request new = RequestCopyForList(element);
-    return new ? new : NULL;
-}
-
-static ListElement copyStudent(ListElement element) {
-    if(element == NULL){
-        return NULL;
-    }
-    Student new = studentCopy(element);
-    return new? new : NULL;
-}
-static void freeStudent(ListElement element) {
-    studentDestroy(element);
-}
-
-/**
- * compareStudents
- * a compare function for 2 students- first based on their grades and the id
- */
-
-static int compareStudents(ListElement element1, ListElement element2, ListSortKey key){
-    assert(element1 != NULL || element2 != NULL);
-    //check grade distance for students
-    int distance = studentGetHelper(element1) -
-                   studentGetHelper(element2);
-    distance = (distance*(*(int *)key));
-    //if points are equal, check student id
-    if(distance == 0) {
-        distance = studentGetStudentId(element1) -
-                   studentGetStudentId(element2);
-    }
-    return distance;
-}
-
 /**
  * CourseManagerCreate: Allocates a new empty student.
  *
@@ -135,18 +138,178 @@ MtmErrorCode courseManagerCreate(CourseManager *courseManager){
     if(*courseManager == NULL){
         return MTM_OUT_OF_MEMORY;
     }
-    (*courseManager)->connectedStudent = -1;//value for unlogged student
-    (*courseManager)->friendshipRequest = listCreate(RequestCopy,freeRequest);
-    if((*courseManager)->friendshipRequest == NULL){
+    (*courseManager)->loggedIn = NULL;//value for unlogged student
+    (*courseManager)->sessions = NULL;
+    (*courseManager)->sequence = 0;
+    (*courseManager)->journal = NULL;
+    (*courseManager)->snapshot_path = NULL;
+    (*courseManager)->journal_path = NULL;
+    (*courseManager)->old_journal = false;
+    (*courseManager)->journal_failed = false;
+    (*courseManager)->compaction_due = false;
+    (*courseManager)->compacting = false;
+    (*courseManager)->compaction_done = false;
+    (*courseManager)->compaction_saved = false;
+    (*courseManager)->compaction_snapshot = NULL;
+    pthread_rwlock_init(&(*courseManager)->lock,NULL);
+    for(int i = 0; i < STUDENT_LOCK_STRIPES; i++){
+        pthread_rwlock_init(&(*courseManager)->student_locks[i].lock,NULL);
+    }
+    for(int i = 0; i < ENROLLMENT_STRIPES; i++){
+        pthread_rwlock_init(&(*courseManager)->enrollment_locks[i].lock,NULL);
+    }
+    pthread_mutex_init(&(*courseManager)->requests_lock,NULL);
+    pthread_mutex_init(&(*courseManager)->sessions_lock,NULL);
+    pthread_mutex_init(&(*courseManager)->journal_lock,NULL);
+    pthread_mutex_init(&(*courseManager)->compaction_lock,NULL);
+    if(requestTableCreate(&(*courseManager)->friendshipRequest) != REQUEST_TABLE_SUCCESS){
         return MTM_OUT_OF_MEMORY;
     }
-    (*courseManager)->students = listCreate(copyStudent,freeStudent);
-    if((*courseManager)->students == NULL){
+    if(studentTableCreate(&(*courseManager)->students) != STUDENT_TABLE_SUCCESS){
         return MTM_OUT_OF_MEMORY;
     }
+    for(int i = 0; i < ENROLLMENT_STRIPES; i++){
+        if(enrollmentTableCreate(&(*courseManager)->enrollments[i]) != ENROLLMENT_TABLE_SUCCESS){
+            return MTM_OUT_OF_MEMORY;
+        }
+    }
     return MTM_SUCCESS;//success flag
 }
 
+/**
+ * Session - a student being served by the system. a session holds the student
+ * from sessionOpen until sessionClose, or until the student is removed from
+ * the system (which ends the session, but leaves closing it to its owner).
+ */
+struct Session_t {
+    CourseManager courseManager;
+    int student_id;
+    Student student;//NULL once the student was removed from the system
+    Session previous;//in the open sessions of the system
+    Session next;
+};
+
+//the lock of the student with the given id (ids from the input may be anything)
+static pthread_rwlock_t* studentLock(CourseManager courseManager, int id){
+    return &courseManager->student_locks[(unsigned)id % STUDENT_LOCK_STRIPES].lock;
+}
+
+//the enrollments of the course, and their lock, by the course id
+static int enrollmentStripe(int course_id){
+    return (int)((unsigned)course_id % ENROLLMENT_STRIPES);
+}
+
+//takes the locks of two students, in the order of the locks so two functions never wait for each other
+static void lockStudents(CourseManager courseManager, int id, int other_id){
+    pthread_rwlock_t* first = studentLock(courseManager,id);
+    pthread_rwlock_t* second = studentLock(courseManager,other_id);
+    if(first > second){
+        pthread_rwlock_t* swap = first;
+        first = second;
+        second = swap;
+    }
+    pthread_rwlock_wrlock(first);
+    if(second != first){
+        pthread_rwlock_wrlock(second);
+    }
+}
+
+static void unlockStudents(CourseManager courseManager, int id, int other_id){
+    pthread_rwlock_t* first = studentLock(courseManager,id);
+    pthread_rwlock_t* second = studentLock(courseManager,other_id);
+    if(second != first){
+        pthread_rwlock_unlock(second);
+    }
+    pthread_rwlock_unlock(first);
+}
+
+static bool isCompactionDue(CourseManager courseManager){
+    return courseManager->journal_failed ||
+           journalGetSize(courseManager->journal) >= JOURNAL_COMPACT_SIZE;
+}
+
+//tells compactIfDue whether a compaction is due, with the journal locked
+static void markCompaction(CourseManager courseManager){
+    bool due = courseManager->journal != NULL && isCompactionDue(courseManager);
+    pthread_mutex_lock(&courseManager->compaction_lock);
+    courseManager->compaction_due = due;
+    pthread_mutex_unlock(&courseManager->compaction_lock);
+}
+
+/**
+ * recordChange: appends a change that is about to be made to the journal, if
+ * there is one, and counts it. the change is made only if it was recorded.
+ * once a change failed to be written (maybe in part), no change is recorded
+ * until a compaction saves the system and starts the journal over.
+ * @param student - the student who makes the change, 0 for a change of the system
+ *
+ * @return
+ * 	MTM_OUT_OF_MEMORY - the change couldn't be recorded for lack of memory
+ * 	MTM_CANNOT_OPEN_FILE - the change couldn't be written to the journal
+ * 	MTM_SUCCESS - the change was recorded
+ */
+static MtmErrorCode recordChange(CourseManager courseManager, int student,
+                                 const Command* change){
+    pthread_mutex_lock(&courseManager->journal_lock);
+    JournalResult result = JOURNAL_SUCCESS;
+    if(courseManager->journal_failed){
+        result = JOURNAL_CANNOT_OPEN_FILE;
+    } else if(courseManager->journal != NULL){
+        result = journalAppend(courseManager->journal,student,change);
+    }
+    if(result == JOURNAL_SUCCESS){
+        courseManager->sequence++;
+    } else if(result == JOURNAL_CANNOT_OPEN_FILE){
+        courseManager->journal_failed = true;
+    }
+    if(courseManager->journal != NULL && isCompactionDue(courseManager)){
+        markCompaction(courseManager);
+    }
+    pthread_mutex_unlock(&courseManager->journal_lock);
+    if(result != JOURNAL_SUCCESS){
+        return result == JOURNAL_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE;
+    }
+    return MTM_SUCCESS;
+}
+
+/**
+ * missChange: a recorded change couldn't be made for lack of memory, so the journal
+ * doesn't match the system any more. no change is recorded until a compaction
+ * saves the system (a recovery before it makes the change).
+ */
+static void missChange(CourseManager courseManager){
+    pthread_mutex_lock(&courseManager->journal_lock);
+    courseManager->journal_failed = courseManager->journal != NULL;
+    markCompaction(courseManager);
+    pthread_mutex_unlock(&courseManager->journal_lock);
+}
+
+static MtmErrorCode compactJournal(CourseManager courseManager);
+
+/**
+ * compactIfDue: compacts a journal that grew too big. called after a change,
+ * once the locks of the change were released.
+ */
+static void compactIfDue(CourseManager courseManager){
+    if(courseManager->journal == NULL){
+        return;
+    }
+    pthread_mutex_lock(&courseManager->compaction_lock);
+    bool due = courseManager->compaction_due;
+    pthread_mutex_unlock(&courseManager->compaction_lock);
+    if(!due){
+        return;
+    }
+    pthread_rwlock_wrlock(&courseManager->lock);
+    pthread_mutex_lock(&courseManager->journal_lock);
+    if(isCompactionDue(courseManager)){//another thread may have compacted it meanwhile
+        compactJournal(courseManager);//on failure it's tried again after the next change
+    }
+    markCompaction(courseManager);
+    pthread_mutex_unlock(&courseManager->journal_lock);
+    pthread_rwlock_unlock(&courseManager->lock);
+}
+
 /**
  * addStudent: Add a student to the System.
  *
@@ -159,26 +322,59 @@ MtmErrorCode courseManagerCreate(CourseManager *courseManager){
  * 	MTM_INVALID_PARAMETERS - id illegal
  * 	MTM_STUDENT_ALREADY_EXISTS - if student exists already
  */
-MtmErrorCode addStudent(CourseManager courseManager, int id,
-                        char* first_name, char* last_name){
-    if(courseManager == NULL || id<=0 || id >= 1000000000){
-        return MTM_INVALID_PARAMETERS;
+static MtmErrorCode insertStudent(CourseManager courseManager, int id,
+                                  char* first_name, char* last_name){
+    if(studentTableFind(courseManager->students,id) != NULL){
+        return MTM_STUDENT_ALREADY_EXISTS;
     }
-    LIST_FOREACH(Student,iterator,courseManager->students){
-        //search for student in students list
-        if(studentGetStudentId(iterator) == id){
-            return MTM_STUDENT_ALREADY_EXISTS;
-        }
+    Command change = {COMMAND_STUDENT_ADD,{id,0,0},{first_name,last_name}};
+    MtmErrorCode result = recordChange(courseManager,0,&change);
+    if(result != MTM_SUCCESS){
+        return result;
     }
     Student new;//create new student
     studentCreate(id,first_name,last_name,&new);
     if(new == NULL){
+        missChange(courseManager);
         return MTM_OUT_OF_MEMORY;
     }
-    listInsertLast(courseManager->students,new);//insert to students list
-    studentDestroy(new);
-    return MTM_SUCCESS;//success
+    //the table takes the new student as is
+    if(studentTableInsert(courseManager->students,new) != STUDENT_TABLE_SUCCESS){
+        studentDestroy(new);
+        missChange(courseManager);
+        return MTM_OUT_OF_MEMORY;
+    }
+    return MTM_SUCCESS;
 }
+
+MtmErrorCode addStudent(CourseManager courseManager, int id,
+                        char* first_name, char* last_name){
+    if(courseManager == NULL || id<=0 || id >= 1000000000){
+        return MTM_INVALID_PARAMETERS;
+    }
+    pthread_rwlock_wrlock(&courseManager->lock);
+    MtmErrorCode result = insertStudent(courseManager,id,first_name,last_name);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+//takes a session out of the open sessions of the system and de-allocates it
+static void closeSession(Session session){
+    CourseManager courseManager = session->courseManager;
+    pthread_mutex_lock(&courseManager->sessions_lock);
+    if(session->previous != NULL){
+        session->previous->next = session->next;
+    } else {
+        courseManager->sessions = session->next;
+    }
+    if(session->next != NULL){
+        session->next->previous = session->previous;
+    }
+    pthread_mutex_unlock(&courseManager->sessions_lock);
+    free(session);
+}
+
 /**
  * removeStudent- Removes a student from the System
  *
@@ -187,37 +383,121 @@ MtmErrorCode addStudent(CourseManager courseManager, int id,
  * 	MTM_STUDENT_DOES_NOT_EXIST - the student is not in the system
  * 	MTM_SUCCESS - student removed
  */
-MtmErrorCode removeStudent(CourseManager courseManager, int id){
-    assert(courseManager!=NULL);
-    bool exists = false;
-    LIST_FOREACH(Student,iterator,courseManager->students){
-        //search for student in students list
-        if(studentGetStudentId(iterator) == id){
-            exists = true;
-            listRemoveCurrent(courseManager->students);//delete student from courseManager
-            break;
+static MtmErrorCode deleteStudent(CourseManager courseManager, int id){
+    Student student = getStudentFromId(courseManager,id);
+    if(student == NULL){
+        return MTM_STUDENT_DOES_NOT_EXIST;
+    }
+    Command change = {COMMAND_STUDENT_REMOVE,{id,0,0},{NULL,NULL}};
+    MtmErrorCode result = recordChange(courseManager,0,&change);
+    if(result != MTM_SUCCESS){
+        return result;
+    }
+    //friendship is mutual - remove the student only from the lists of his friends
+    int friends_count;
+    int* friends = studentReturnFriends(student,&friends_count);
+    for(int i = 0; i < friends_count; i++){
+        studentRemoveFriend(getStudentFromId(courseManager,friends[i]),id);
+    }
+    //delete student from courseManager
+    studentTableRemove(courseManager->students,id);
+    //if this student is connected - disconnect (as part of this change)
+    if(courseManager->loggedIn != NULL && courseManager->loggedIn->student_id == id){
+        closeSession(courseManager->loggedIn);
+        courseManager->loggedIn = NULL;
+    }
+    //the other sessions of the student end, their owners still close them
+    pthread_mutex_lock(&courseManager->sessions_lock);
+    for(Session session = courseManager->sessions; session != NULL; session = session->next){
+        if(session->student_id == id){
+            session->student = NULL;
         }
     }
-    if(exists == false){
+    pthread_mutex_unlock(&courseManager->sessions_lock);
+    //each request of the student or from the student will be deleted
+    requestTableRemoveStudent(courseManager->friendshipRequest,id);
+    for(int i = 0; i < ENROLLMENT_STRIPES; i++){
+        enrollmentTableRemoveStudent(courseManager->enrollments[i],id);
+    }
+    return MTM_SUCCESS;
+}
+
+MtmErrorCode removeStudent(CourseManager courseManager, int id){
+    assert(courseManager!=NULL);
+    pthread_rwlock_wrlock(&courseManager->lock);
+    MtmErrorCode result = deleteStudent(courseManager,id);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+//opens a session, while the students are locked
+static MtmErrorCode openSession(CourseManager courseManager, int id, Session *session){
+    Student student = getStudentFromId(courseManager,id);
+    if(student == NULL){
         return MTM_STUDENT_DOES_NOT_EXIST;
     }
-    //if this student is connected - disconnect
-    if(courseManager->connectedStudent == id){
-        studentLogOut(courseManager);
+    *session = malloc(sizeof(struct Session_t));
+    if(*session == NULL){
+        return MTM_OUT_OF_MEMORY;
     }
-    //removing the student from the friends request list
-    LIST_FOREACH(Request,iterator,courseManager->friendshipRequest){
-        if(iterator->id_asking == id || iterator->id_asked == id){
-            listRemoveCurrent(courseManager->friendshipRequest);
-            //each request of the student or from the student will be deleted
-        }
+    (*session)->courseManager = courseManager;
+    (*session)->student_id = id;
+    (*session)->student = student;
+    (*session)->previous = NULL;
+    pthread_mutex_lock(&courseManager->sessions_lock);
+    (*session)->next = courseManager->sessions;
+    if(courseManager->sessions != NULL){
+        courseManager->sessions->previous = *session;
     }
-    //remove the student from all friendship lists of every student
-    LIST_FOREACH(Student,iterator,courseManager->students){
-        if(studentGetStudentId(iterator))
-            studentRemoveFriend(iterator,id);
+    courseManager->sessions = *session;
+    pthread_mutex_unlock(&courseManager->sessions_lock);
+    return MTM_SUCCESS;
+}
+
+/**
+ * sessionOpen- Opens a session of a student. any number of sessions may be open
+ * at once, for the same student or for different students.
+ *
+ * @param id - the student of the session
+ * @param session - pointer to the session opened
+ * @return
+ * 	MTM_STUDENT_DOES_NOT_EXIST - the student is not in the system
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_SUCCESS - session opened
+ */
+MtmErrorCode sessionOpen(CourseManager courseManager, int id, Session *session){
+    pthread_rwlock_rdlock(&courseManager->lock);
+    MtmErrorCode result = openSession(courseManager,id,session);
+    pthread_rwlock_unlock(&courseManager->lock);
+    return result;
+}
+
+/**
+ * sessionClose- Closes a session and de-allocates it
+ *
+ * @param session - to close, the session of the logged in student is closed by
+ * studentLogOut
+ */
+void sessionClose(Session session){
+    if(session == NULL){
+        return;
     }
-    return MTM_SUCCESS;//success
+    closeSession(session);
+}
+
+/**
+ * sessionGetStudentId- returns the student of a session
+ *
+ * @return
+ * 	-1 - the student was removed from the system
+ * 	the id of the student otherwise
+ */
+int sessionGetStudentId(Session session){
+    pthread_rwlock_rdlock(&session->courseManager->lock);
+    int id = session->student == NULL ? -1 : session->student_id;
+    pthread_rwlock_unlock(&session->courseManager->lock);
+    return id;
 }
 
 /**
@@ -229,22 +509,32 @@ MtmErrorCode removeStudent(CourseManager courseManager, int id){
  * 	MTM_ALREADY_LOGGED_IN - the student is already logged in
  * 	MTM_SUCCESS - student removed
  */
-MtmErrorCode studentLogIn(CourseManager courseManager, int id){
-    if(courseManager->connectedStudent != -1){
+static MtmErrorCode logIn(CourseManager courseManager, int id){
+    if(courseManager->loggedIn != NULL){
         return MTM_ALREADY_LOGGED_IN;
     }
-    bool exists = false;
-    LIST_FOREACH(Student,iterator,courseManager->students){
-        if(studentGetStudentId(iterator) == id){
-            exists = true;
-            break;
-        }
-    }
-    if(exists == false){
+    if(getStudentFromId(courseManager,id) == NULL){
         return MTM_STUDENT_DOES_NOT_EXIST;
     }
-    courseManager->connectedStudent = id;
-    return MTM_SUCCESS;//success
+    Command change = {COMMAND_STUDENT_LOGIN,{id,0,0},{NULL,NULL}};
+    MtmErrorCode result = recordChange(courseManager,id,&change);
+    if(result != MTM_SUCCESS){
+        return result;
+    }
+    result = openSession(courseManager,id,&courseManager->loggedIn);
+    if(result != MTM_SUCCESS){
+        courseManager->loggedIn = NULL;
+        missChange(courseManager);
+    }
+    return result;
+}
+
+MtmErrorCode studentLogIn(CourseManager courseManager, int id){
+    pthread_rwlock_wrlock(&courseManager->lock);
+    MtmErrorCode result = logIn(courseManager,id);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
 }
 
 /**
@@ -255,118 +545,148 @@ MtmErrorCode studentLogIn(CourseManager courseManager, int id){
  * 	MTM_NOT_LOGGED_IN - the student is not logged in
  * 	MTM_SUCCESS - student logged out
  */
-MtmErrorCode studentLogOut(CourseManager courseManager){
-    if(courseManager->connectedStudent == -1){
+static MtmErrorCode logOut(CourseManager courseManager){
+    if(courseManager->loggedIn == NULL){
         return MTM_NOT_LOGGED_IN;
     }
-    courseManager->connectedStudent = -1;
-    return MTM_SUCCESS;//success
+    int id = courseManager->loggedIn->student_id;
+    Command change = {COMMAND_STUDENT_LOGOUT,{0,0,0},{NULL,NULL}};
+    MtmErrorCode result = recordChange(courseManager,id,&change);
+    if(result != MTM_SUCCESS){
+        return result;
+    }
+    closeSession(courseManager->loggedIn);
+    courseManager->loggedIn = NULL;
+    return MTM_SUCCESS;
+}
+
+MtmErrorCode studentLogOut(CourseManager courseManager){
+    pthread_rwlock_wrlock(&courseManager->lock);
+    MtmErrorCode result = logOut(courseManager);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
 }
 
 /**
- * studentFriendRequest - friend request from another student
+ * friendRequest - friend request from the student of the session to another student
  *
  * @param other_id - student to be asked friends from
  * @return
- * 	MTM_NOT_LOGGED_IN - the student is not logged in
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
  * 	MTM_ALREADY_FRIEND - the students are already friends
  * 	MTM_STUDENT_DOES_NOT_EXIST - there's no such student
  * 	MTM_ALREADY_REQUESTED - there's a request waiting
  * 	MTM_SUCCESS - student logged out
  */
-MtmErrorCode studentFriendRequest(CourseManager courseManager, int other_id){
-    if (courseManager->connectedStudent == -1) {
+static MtmErrorCode friendRequest(Session session, int other_id){
+    if (session->student == NULL) {
         return MTM_NOT_LOGGED_IN;
     }
-    int appeared = 0;
-    int asking_id=courseManager->connectedStudent;
+    CourseManager courseManager = session->courseManager;
+    int asking_id = session->student_id;
     int asked_id = other_id;
     if (asked_id==asking_id){
         return MTM_ALREADY_FRIEND; //lonely student asks himself
     }
-    LIST_FOREACH(Student, iterator, courseManager->students) {
-        int temp_id = studentGetStudentId(iterator);
-        if (temp_id == other_id) {
-            appeared = 1;
-            break;
-        }
-    }
-    if (appeared == 0) {
+    Student other = getStudentFromId(courseManager, other_id);
+    if (other == NULL) {
         return MTM_STUDENT_DOES_NOT_EXIST;// no such student in system
     }
-    LIST_FOREACH(Request, iterator, courseManager->friendshipRequest) {
-        asking_id = getIdAsking(iterator);
-        asked_id = getIdAsked(iterator);
-        if (asking_id == courseManager->connectedStudent &&
-            asked_id == other_id) {// request appeared
-            return MTM_ALREADY_REQUESTED;
-        }
+    lockStudents(courseManager, asking_id, other_id);
+    MtmErrorCode result = MTM_SUCCESS;
+    //the requests between the two students change only under both their locks
+    pthread_mutex_lock(&courseManager->requests_lock);
+    if (requestTableContains(courseManager->friendshipRequest,
+                             asking_id, other_id)) {// request appeared
+        result = MTM_ALREADY_REQUESTED;
+    } else if (studentCheckIfFriends(session->student, other_id) == 1) {
+        result = MTM_ALREADY_FRIEND;
     }
-    asking_id = courseManager->connectedStudent;
-    Student connected = getStudentFromId(courseManager,asking_id);
-    if (studentCheckIfFriends(connected, other_id) == 1) {
-        return MTM_ALREADY_FRIEND;
+    pthread_mutex_unlock(&courseManager->requests_lock);
+    if (result == MTM_SUCCESS) {
+        Command change = {COMMAND_STUDENT_FRIEND_REQUEST,{other_id,0,0},{NULL,NULL}};
+        result = recordChange(courseManager, asking_id, &change);
     }
-    Request new_request = malloc(sizeof(new_request));
-    new_request->id_asked = other_id;
-    new_request->id_asking = courseManager->connectedStudent;
-    listInsertLast(courseManager->friendshipRequest,new_request);
-    freeRequest(new_request);
-    return MTM_SUCCESS;
+    if (result == MTM_SUCCESS) {
+        pthread_mutex_lock(&courseManager->requests_lock);
+        if (requestTableAdd(courseManager->friendshipRequest, asking_id, other_id)
+                == REQUEST_TABLE_OUT_OF_MEMORY) {
+            result = MTM_OUT_OF_MEMORY;
+        }
+        pthread_mutex_unlock(&courseManager->requests_lock);
+        if (result != MTM_SUCCESS) {
+            missChange(courseManager);
+        }
+    }
+    unlockStudents(courseManager, asking_id, other_id);
+    return result;
 }
+
 /**
- * studentHandleRequest- Handles friendship request for logged in student
+ * handleRequest- Handles friendship request for the student of the session
  *
- * @param other_id - id of student who requested a friendship from the logged user
+ * @param other_id - id of student who requested a friendship from the student
  * @param action - Accept/Reject request
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
  * 	MTM_STUDENT_DOES_NOT_EXIST - student requested to be friends with is not in the system
  * 	MTM_ALREADY_FRIEND - the students are already friends
  * 	MTM_NOT_REQUESTED - the request has not been not made
  * 	MTM_INVALID_PARAMETERS - the action is illegal
  * 	MTM_SUCCESS - Request handled
  */
-MtmErrorCode studentHandleRequest(CourseManager courseManager, int other_id, char* action) {
-    if (courseManager->connectedStudent == -1) {
+static MtmErrorCode handleRequest(Session session, int other_id, char* action) {
+    if (session->student == NULL) {
         return MTM_NOT_LOGGED_IN;
     }
-    int appeared = 0, friend_added;
-    LIST_FOREACH(Student, iterator, courseManager->students) {
-        int temp_id = studentGetStudentId(iterator);
-        if (temp_id == other_id) {
-            appeared = 1;
-            break;
-        }
-    }
-    if (appeared == 0) {
+    CourseManager courseManager = session->courseManager;
+    int friend_added = 0;
+    Student other = getStudentFromId(courseManager, other_id);
+    if (other == NULL) {
         return MTM_STUDENT_DOES_NOT_EXIST;// no such student in system
     }
-    Student connected = getStudentFromId(courseManager,
-            courseManager->connectedStudent);
+    Student connected = session->student;
+    int asked_id = session->student_id;
+    lockStudents(courseManager, asked_id, other_id);
     if (studentCheckIfFriends(connected, other_id) == 1) {
+        unlockStudents(courseManager, asked_id, other_id);
         return MTM_ALREADY_FRIEND;
     }
-    int asked_id = courseManager->connectedStudent;
-    Student asked = getStudentFromId(courseManager, asked_id);
-    Student asking = getStudentFromId(courseManager, other_id);
-    int asking_id;
-    LIST_FOREACH(Request, iterator, courseManager->friendshipRequest) {
-        asking_id = getIdAsking(iterator);
-        asked_id = getIdAsked(iterator);
-        if (asked_id == courseManager->connectedStudent &&
-              asking_id == other_id)  {
-            if (strcmp(action, "accept")==0){
-                studentAddFriend(asked, other_id);
-                studentAddFriend(asking, asked_id);
-                friend_added = 1;
+    //requests are dropped even when the action fails
+    pthread_mutex_lock(&courseManager->requests_lock);
+    bool changed = requestTableContains(courseManager->friendshipRequest,
+                                        other_id, asked_id) ||
+                   requestTableContains(courseManager->friendshipRequest,
+                                        asked_id, other_id);
+    pthread_mutex_unlock(&courseManager->requests_lock);
+    //an action that isn't "accept" drops the requests as "reject" does, and is
+    //recorded as one, so the journal only holds the change really made
+    bool accept = strcmp(action, "accept") == 0;
+    MtmErrorCode recorded = MTM_SUCCESS;
+    if (changed) {
+        Command change = {COMMAND_STUDENT_HANDLE_REQUEST,{other_id,0,0},
+                          {accept ? "accept" : "reject",NULL}};
+        recorded = recordChange(courseManager, asked_id, &change);
+    }
+    if (changed && recorded == MTM_SUCCESS) {
+        pthread_mutex_lock(&courseManager->requests_lock);
+        //the request of the other student to the student of the session
+        if (requestTableRemove(courseManager->friendshipRequest, other_id, asked_id)
+                == REQUEST_TABLE_SUCCESS && accept) {
+            if (studentAddFriend(connected, other_id) != STUDENT_SUCCESS ||
+                studentAddFriend(other, asked_id) != STUDENT_SUCCESS) {
+                missChange(courseManager);
             }
-            listRemoveCurrent(courseManager->friendshipRequest);
-        }
-        if (asking_id == courseManager->connectedStudent &&
-             asked_id == other_id) {
-            listRemoveCurrent(courseManager->friendshipRequest);
+            friend_added = 1;
         }
+        //a request of the student of the session to the other student is dropped as well
+        requestTableRemove(courseManager->friendshipRequest, asked_id, other_id);
+        pthread_mutex_unlock(&courseManager->requests_lock);
+    }
+    unlockStudents(courseManager, asked_id, other_id);
+    if (recorded != MTM_SUCCESS) {
+        return recorded;
     }
     if (strcmp(action, "reject") != 0 && strcmp(action, "accept") != 0) {
         return MTM_INVALID_PARAMETERS;
@@ -378,43 +698,63 @@ MtmErrorCode studentHandleRequest(CourseManager courseManager, int other_id, cha
 }
 
 /**
- * studentUnFriend- Unfriends a student from the logged student friends list
- * and also the connected student from the unfriended student
- * @param other_id - id of student who is to be removed from the logged in student friends list
+ * unFriend- Unfriends a student from the friends list of the student of the
+ * session and also the student of the session from the unfriended student
+ * @param other_id - id of student who is to be removed from the friends list
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
  * 	MTM_STUDENT_DOES_NOT_EXIST - student to be unfriended is not in the system
  * 	MTM_NOT_FRIEND - the students are not friends
  * 	MTM_SUCCESS - students unfriend
  */
-MtmErrorCode studentUnFriend(CourseManager courseManager, int other_id){
-    if (courseManager->connectedStudent == -1) {
+static MtmErrorCode unFriend(Session session, int other_id){
+    if (session->student == NULL) {
         return MTM_NOT_LOGGED_IN;
     }
-    int appeared = 0;
-    LIST_FOREACH(Student, iterator, courseManager->students) {
-        int temp_id = studentGetStudentId(iterator);
-        if (temp_id == other_id) {
-            appeared = 1;
-            break;
-        }
-    }
-    if (appeared == 0) {
+    CourseManager courseManager = session->courseManager;
+    Student other = getStudentFromId(courseManager, other_id);
+    if (other == NULL) {
         return MTM_STUDENT_DOES_NOT_EXIST;// no such student in system
     }
-    int asking_id= courseManager->connectedStudent;
-    Student asking=getStudentFromId(courseManager,asking_id);
-    if (studentCheckIfFriends(asking,other_id)==0){
-        return MTM_NOT_FRIEND;
+    int asking_id = session->student_id;
+    Student asking = session->student;
+    lockStudents(courseManager, asking_id, other_id);
+    MtmErrorCode result = MTM_NOT_FRIEND;
+    if (studentCheckIfFriends(asking,other_id)==1){
+        Command change = {COMMAND_STUDENT_UNFRIEND,{other_id,0,0},{NULL,NULL}};
+        result = recordChange(courseManager, asking_id, &change);
     }
-    studentRemoveFriend(asking, other_id);
-    Student asked = getStudentFromId(courseManager, other_id);
-    studentRemoveFriend(asked, asking_id);
-    return MTM_SUCCESS;
+    if (result == MTM_SUCCESS){
+        studentRemoveFriend(asking, other_id);
+        studentRemoveFriend(other, asking_id);
+    }
+    unlockStudents(courseManager, asking_id, other_id);
+    return result;
 }
 
 /**
- * grade_sheet_add- adds a grade to the sheet of the logged in student
+ * updateEnrollment- copies the best grade of the student of the session in the course
+ * from the student's transcript into the enrollments of the course.
+ * only a student new to the course needs memory, so after a remove or an update
+ * of a grade the enrollment can't fail.
+ *
+ * @return
+ * 	MTM_OUT_OF_MEMORY - memory problem occurred
+ * 	MTM_SUCCESS - the enrollment is up to date
+ */
+static MtmErrorCode updateEnrollment(Session session, int course_id){
+    CourseManager courseManager = session->courseManager;
+    int best_grade = studentGetBestGrade(session->student,course_id);
+    int stripe = enrollmentStripe(course_id);
+    pthread_rwlock_wrlock(&courseManager->enrollment_locks[stripe].lock);
+    EnrollmentTableResult result = enrollmentTableSet(courseManager->enrollments[stripe],
+                                                      course_id,session->student_id,best_grade);
+    pthread_rwlock_unlock(&courseManager->enrollment_locks[stripe].lock);
+    return result == ENROLLMENT_TABLE_SUCCESS ? MTM_SUCCESS : MTM_OUT_OF_MEMORY;
+}
+
+/**
+ * gradeSheetAdd- adds a grade to the sheet of the student of the session
  *
  * @param semester - semester to be added to
  * @param course_id - the courses id
@@ -422,243 +762,976 @@ MtmErrorCode studentUnFriend(CourseManager courseManager, int other_id){
  * @param grade - courses grade
 
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
  * 	MTM_INVALID_PARAMETERS - one of the parameters are not valid
+ * 	MTM_OUT_OF_MEMORY - memory problem occurred, the sheet wasn't changed
  * 	MTM_SUCCESS - grades was added
  */
-MtmErrorCode grade_sheet_add(CourseManager courseManager, int semester,
-                             int course_id, char* points, int grade){
-    if (courseManager->connectedStudent == -1) {
+static MtmErrorCode gradeSheetAdd(Session session, int semester,
+                                  int course_id, char* points, int grade){
+    if (session->student == NULL) {
         return MTM_NOT_LOGGED_IN;
     }
-    Student loggedin = getStudentFromId(courseManager,courseManager->connectedStudent);
     if(semester <= 0 || course_id >= 1000000 || course_id <=0 || grade < 0 ||
-            grade > 100 ||
-            studentAddGrade(loggedin,semester,course_id,points,grade) !=
-                    STUDENT_SUCCESS){
+            grade > 100){
         return MTM_INVALID_PARAMETERS;
     }
-    return MTM_SUCCESS;
+    Student loggedin = session->student;
+    pthread_rwlock_t* lock = studentLock(session->courseManager,session->student_id);
+    pthread_rwlock_wrlock(lock);
+    Command change = {COMMAND_GRADE_SHEET_ADD,{semester,course_id,grade},{points,NULL}};
+    MtmErrorCode result = recordChange(session->courseManager,session->student_id,&change);
+    if(result != MTM_SUCCESS){
+        pthread_rwlock_unlock(lock);
+        return result;
+    }
+    StudentResult added = studentAddGrade(loggedin,semester,course_id,points,grade);
+    if(added == STUDENT_SUCCESS){
+        result = updateEnrollment(session,course_id);
+        if(result != MTM_SUCCESS){
+            //the grade added is the last one of the course in the semester,
+            //so removing it leaves the transcript as it was before
+            studentRemoveGrade(loggedin,semester,course_id);
+        }
+    } else {
+        result = added == STUDENT_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY : MTM_INVALID_PARAMETERS;
+    }
+    if(result == MTM_OUT_OF_MEMORY){
+        missChange(session->courseManager);
+    }
+    pthread_rwlock_unlock(lock);
+    return result;
 }
 
 /**
- * grade_sheet_remove- remove a grade from the sheet of the logged in student
+ * gradeSheetRemove- remove a grade from the sheet of the student of the session
  *
  * @param semester - semester to be added to
  * @param course_id - the courses id
 
 
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
  * 	MTM_COURSE_DOES_NOT_EXIST - the course does not exist in the system
  * 	MTM_SUCCESS - grades was added
  */
-MtmErrorCode grade_sheet_remove(CourseManager courseManager,int semester, int course_id){
-    if (courseManager->connectedStudent == -1) {
+static MtmErrorCode gradeSheetRemove(Session session, int semester, int course_id){
+    if (session->student == NULL) {
         return MTM_NOT_LOGGED_IN;
     }
-    Student loggedin = getStudentFromId(courseManager,courseManager->connectedStudent);
-    if(studentRemoveGrade(loggedin,semester,course_id) == STUDENT_COURSE_NOT_EXIST){
-        return MTM_COURSE_DOES_NOT_EXIST;
+    Student loggedin = session->student;
+    pthread_rwlock_t* lock = studentLock(session->courseManager,session->student_id);
+    pthread_rwlock_wrlock(lock);
+    if(studentDoesGradeExistsInSemester(loggedin,semester,course_id) == 0){
+        //nothing is removed, so nothing is recorded. the sheet still gives the
+        //answer, as a semester and a course it never had are removed with success
+        StudentResult removed = studentRemoveGrade(loggedin,semester,course_id);
+        pthread_rwlock_unlock(lock);
+        return removed == STUDENT_COURSE_NOT_EXIST ? MTM_COURSE_DOES_NOT_EXIST : MTM_SUCCESS;
     }
-    return MTM_SUCCESS;
+    Command change = {COMMAND_GRADE_SHEET_REMOVE,{semester,course_id,0},{NULL,NULL}};
+    MtmErrorCode result = recordChange(session->courseManager,session->student_id,&change);
+    if(result == MTM_SUCCESS){
+        studentRemoveGrade(loggedin,semester,course_id);
+        updateEnrollment(session,course_id);//a removed grade doesn't need memory
+    }
+    pthread_rwlock_unlock(lock);
+    return result;
 }
 
 /**
- * grade_sheet_update- update a grade from the sheet of the logged in student
+ * gradeSheetUpdate- update a grade from the sheet of the student of the session
  *
  * @param course_id - the courses id
  * @param new_grade - grade to be updated
 
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
  * 	MTM_COURSE_DOES_NOT_EXIST - the course does not exist in the system
  * 	MTM_INVALID_PARAMETERS - the parameters arent valid
  * 	MTM_SUCCESS - grades was added
  */
-MtmErrorCode grade_sheet_update(CourseManager courseManager,int course_id,int grade){
-    if (courseManager->connectedStudent == -1) {
+static MtmErrorCode gradeSheetUpdate(Session session, int course_id, int grade){
+    if (session->student == NULL) {
         return MTM_NOT_LOGGED_IN;
     }
-    Student loggedin = getStudentFromId(courseManager,courseManager->connectedStudent);
-    if(studentUpdateGrade(loggedin,course_id,grade) == STUDENT_COURSE_NOT_EXIST){
-        return MTM_COURSE_DOES_NOT_EXIST;
+    Student loggedin = session->student;
+    pthread_rwlock_t* lock = studentLock(session->courseManager,session->student_id);
+    pthread_rwlock_wrlock(lock);
+    MtmErrorCode result = MTM_SUCCESS;
+    if(studentDoesGradeExists(loggedin,course_id) == 0){
+        result = MTM_COURSE_DOES_NOT_EXIST;
+    } else if(grade<0 || grade > 100){
+        result = MTM_INVALID_PARAMETERS;
+    } else {
+        Command change = {COMMAND_GRADE_SHEET_UPDATE,{course_id,grade,0},{NULL,NULL}};
+        result = recordChange(session->courseManager,session->student_id,&change);
+    }
+    if(result == MTM_SUCCESS){
+        studentUpdateGrade(loggedin,course_id,grade);
+        updateEnrollment(session,course_id);//an updated grade doesn't need memory
     }
-    if(grade<0 || grade > 100){
+    pthread_rwlock_unlock(lock);
+    return result;
+}
+
+/**
+ * the transcript reports - print the grade sheet of the student of the session
+ * with its lock taken shared, and keep the lines of the report together in the file
+ *
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
+ * 	MTM_INVALID_PARAMETERS - amount isn't positive
+ * 	MTM_SUCCESS - printed
+ */
+typedef enum TranscriptReport_t {
+    REPORT_FULL,
+    REPORT_CLEAN,
+    REPORT_BEST,
+    REPORT_WORST
+} TranscriptReport;
+
+static MtmErrorCode reportTranscript(Session session, FILE* file, TranscriptReport report,
+                                     int amount){
+    if (session->student == NULL) {
+        return MTM_NOT_LOGGED_IN;
+    }
+    if ((report == REPORT_BEST || report == REPORT_WORST) && amount<=0){
         return MTM_INVALID_PARAMETERS;
     }
+    pthread_rwlock_t* lock = studentLock(session->courseManager,session->student_id);
+    pthread_rwlock_rdlock(lock);
+    flockfile(file);
+    switch(report){
+        case REPORT_FULL:
+            studentPrintGradesFull(session->student,file);
+            break;
+        case REPORT_CLEAN:
+            studentPrintClean(session->student,file);
+            break;
+        case REPORT_BEST:
+            studentPrintBest(session->student,file,amount);
+            break;
+        case REPORT_WORST:
+            studentPrintWorst(session->student,file,amount);
+            break;
+    }
+    funlockfile(file);
+    pthread_rwlock_unlock(lock);
     return MTM_SUCCESS;
 }
 
 /**
- * reportFull- prints a transcript
+ * reportReference- prints the friends of the student of the session with
+ * the best grades in a course
+ *
+ * @param course_id - the course
+ * @param amount - how many friends to print
  *
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
+ * 	MTM_INVALID_PARAMETERS - parameter arent valid
+ * 	MTM_OUT_OF_MEMORY - memory problem occurred
  * 	MTM_SUCCESS - printed
  */
-MtmErrorCode reportFull(CourseManager courseManager,FILE* file){
-    if (courseManager->connectedStudent == -1) {
-        return MTM_NOT_LOGGED_IN;
+static MtmErrorCode rankFriends(Session session, int course_id, GradeRanking ranking) {
+    CourseManager courseManager = session->courseManager;
+    Student logged = session->student;
+    int friends_count;
+    int* friends = studentReturnFriends(logged, &friends_count);
+    int enrolled_count;
+    EnrollmentTable enrollments = courseManager->enrollments[enrollmentStripe(course_id)];
+    const Enrollment* enrolled = enrollmentTableGetCourse(enrollments, course_id,
+                                                          &enrolled_count);
+    //the friends who took the course - going over the smaller of the two sets
+    bool by_friends = friends_count <= enrolled_count;
+    int candidates = by_friends ? friends_count : enrolled_count;
+    //both sets are sorted by id, so friends with the same grade stay ordered by id
+    for (int i = 0; i < candidates; i++) {
+        int id, grade;
+        if (by_friends) {
+            id = friends[i];
+            grade = enrollmentTableGetBestGrade(enrollments, course_id, id);
+        } else {
+            id = enrolled[i].student_id;
+            grade = studentCheckIfFriends(logged, id) == 1 ? enrolled[i].best_grade : -1;
+        }
+        if (grade < 0) {
+            continue;
+        }
+        if (gradeRankingAdd(ranking, grade, 0, getStudentFromId(courseManager, id)) !=
+            GRADE_RANKING_SUCCESS) {
+            return MTM_OUT_OF_MEMORY;
+        }
     }
-    Student loggedin = getStudentFromId(courseManager,courseManager->connectedStudent);
-    studentPrintGradesFull(loggedin,file);
     return MTM_SUCCESS;
 }
 
+static MtmErrorCode reportReferenceOf(Session session, FILE* file, int course_id, int amount) {
+    if (session->student == NULL) {
+        return MTM_NOT_LOGGED_IN;
+    }
+    if (amount <= 0 || course_id < 0 || course_id > 1000000) {
+        return MTM_INVALID_PARAMETERS;
+    }
+    CourseManager courseManager = session->courseManager;
+    GradeRanking ranking;
+    if (gradeRankingCreate(GRADE_RANKING_DESCENDING, 1, amount, &ranking) !=
+        GRADE_RANKING_SUCCESS) {
+        return MTM_OUT_OF_MEMORY;
+    }
+    //the friends are the student's, the grades are the course's
+    pthread_rwlock_t* lock = studentLock(courseManager,session->student_id);
+    pthread_rwlock_t* enrollments_lock =
+            &courseManager->enrollment_locks[enrollmentStripe(course_id)].lock;
+    pthread_rwlock_rdlock(lock);
+    pthread_rwlock_rdlock(enrollments_lock);
+    MtmErrorCode result = rankFriends(session, course_id, ranking);
+    pthread_rwlock_unlock(enrollments_lock);
+    pthread_rwlock_unlock(lock);
+    if (result == MTM_SUCCESS && gradeRankingSort(ranking) != GRADE_RANKING_SUCCESS) {
+        result = MTM_OUT_OF_MEMORY;
+    }
+    if (result == MTM_SUCCESS) {
+        //the names of the students don't change, so they are printed unlocked
+        flockfile(file);
+        for (int i = 0; i < amount && i < gradeRankingGetSize(ranking); i++) {
+            studentPrintStudentName(gradeRankingGet(ranking, i), file);
+        }
+        funlockfile(file);
+    }
+    gradeRankingDestroy(ranking);
+    return result;
+}
 
 /**
- * reportClean- prints a clean transcript
+ * reportFacultyRequestOf- Prints an answer to a faculty request of the
+ * student of the session
+ * @param course_id - to which course the request is relevant
+ * @param request - Remove, Cancel, Register
  *
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
+ * 	MTM_NOT_LOGGED_IN - the student of the session was removed
+ * 	MTM_COURSE_DOES_NOT_EXIST - the course is not in the student's transcript
  * 	MTM_SUCCESS - grades was added
  */
-MtmErrorCode reportClean(CourseManager courseManager,FILE* file){
-    if (courseManager->connectedStudent == -1) {
+static MtmErrorCode reportFacultyRequestOf(Session session, FILE* file, int course_id,
+                                           char* request){
+    if(session->student == NULL){
         return MTM_NOT_LOGGED_IN;
     }
-    Student loggedin = getStudentFromId(courseManager,courseManager->connectedStudent);
-    studentPrintClean(loggedin,file);
+    if(strcmp(request,"remove_course") == 0){
+        //check if the course was taken by the student of the session
+        CourseManager courseManager = session->courseManager;
+        int stripe = enrollmentStripe(course_id);
+        pthread_rwlock_rdlock(&courseManager->enrollment_locks[stripe].lock);
+        int best_grade = enrollmentTableGetBestGrade(courseManager->enrollments[stripe],
+                                                     course_id,session->student_id);
+        pthread_rwlock_unlock(&courseManager->enrollment_locks[stripe].lock);
+        if(best_grade < 0){
+            return MTM_COURSE_DOES_NOT_EXIST;
+        }
+    }
+    if(strcmp(request,"cancel_course") != 0 && strcmp(request,"remove_course") != 0
+       && strcmp(request,"register_course") != 0){
+        return MTM_INVALID_PARAMETERS;
+    }
+    mtmFacultyResponse(file,"your request was rejected");
     return MTM_SUCCESS;
 }
 
 /**
- * reportBest- prints the best grades in the transcript
- *
- * @param amount - how many grades to print
- *
+ * the functions of a session - the functions above, with the students locked
+ * shared (so the student of the session isn't removed meanwhile)
+ */
+MtmErrorCode sessionFriendRequest(Session session, int other_id){
+    CourseManager courseManager = session->courseManager;
+    pthread_rwlock_rdlock(&courseManager->lock);
+    MtmErrorCode result = friendRequest(session,other_id);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode sessionHandleRequest(Session session, int other_id, char* action){
+    CourseManager courseManager = session->courseManager;
+    pthread_rwlock_rdlock(&courseManager->lock);
+    MtmErrorCode result = handleRequest(session,other_id,action);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode sessionUnFriend(Session session, int other_id){
+    CourseManager courseManager = session->courseManager;
+    pthread_rwlock_rdlock(&courseManager->lock);
+    MtmErrorCode result = unFriend(session,other_id);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode sessionGradeSheetAdd(Session session, int semester, int course_id,
+                                  char* points, int grade){
+    CourseManager courseManager = session->courseManager;
+    pthread_rwlock_rdlock(&courseManager->lock);
+    MtmErrorCode result = gradeSheetAdd(session,semester,course_id,points,grade);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode sessionGradeSheetRemove(Session session, int semester, int course_id){
+    CourseManager courseManager = session->courseManager;
+    pthread_rwlock_rdlock(&courseManager->lock);
+    MtmErrorCode result = gradeSheetRemove(session,semester,course_id);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode sessionGradeSheetUpdate(Session session, int course_id, int grade){
+    CourseManager courseManager = session->courseManager;
+    pthread_rwlock_rdlock(&courseManager->lock);
+    MtmErrorCode result = gradeSheetUpdate(session,course_id,grade);
+    pthread_rwlock_unlock(&courseManager->lock);
+    compactIfDue(courseManager);
+    return result;
+}
+
+static MtmErrorCode sessionReportTranscript(Session session, FILE* file,
+                                            TranscriptReport report, int amount){
+    pthread_rwlock_rdlock(&session->courseManager->lock);
+    MtmErrorCode result = reportTranscript(session,file,report,amount);
+    pthread_rwlock_unlock(&session->courseManager->lock);
+    return result;
+}
+
+MtmErrorCode sessionReportFull(Session session, FILE* file){
+    return sessionReportTranscript(session,file,REPORT_FULL,0);
+}
+
+MtmErrorCode sessionReportClean(Session session, FILE* file){
+    return sessionReportTranscript(session,file,REPORT_CLEAN,0);
+}
+
+MtmErrorCode sessionReportBest(Session session, FILE* file, int amount){
+    return sessionReportTranscript(session,file,REPORT_BEST,amount);
+}
+
+MtmErrorCode sessionReportWorst(Session session, FILE* file, int amount){
+    return sessionReportTranscript(session,file,REPORT_WORST,amount);
+}
+
+MtmErrorCode sessionReportReference(Session session, FILE* file, int course_id, int amount){
+    pthread_rwlock_rdlock(&session->courseManager->lock);
+    MtmErrorCode result = reportReferenceOf(session,file,course_id,amount);
+    pthread_rwlock_unlock(&session->courseManager->lock);
+    return result;
+}
+
+MtmErrorCode sessionReportFacultyRequest(Session session, FILE* file, int course_id,
+                                         char* request){
+    pthread_rwlock_rdlock(&session->courseManager->lock);
+    MtmErrorCode result = reportFacultyRequestOf(session,file,course_id,request);
+    pthread_rwlock_unlock(&session->courseManager->lock);
+    return result;
+}
+
+/**
+ * the functions of the logged in student - the same as the functions of a session,
+ * for the session of the logged in student
  * @return
  * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
- * 	MTM_INVALID_PARAMETERS - amount isn't positive
- * 	MTM_SUCCESS - grades was added
+ * 	the result of the function of the session otherwise
  */
+static Session lockLoggedIn(CourseManager courseManager){
+    pthread_rwlock_rdlock(&courseManager->lock);
+    return courseManager->loggedIn;
+}
+
+static void unlockLoggedIn(CourseManager courseManager){
+    pthread_rwlock_unlock(&courseManager->lock);
+}
+
+MtmErrorCode studentFriendRequest(CourseManager courseManager, int other_id){
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          friendRequest(loggedIn,other_id);
+    unlockLoggedIn(courseManager);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode studentHandleRequest(CourseManager courseManager, int other_id, char* action) {
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          handleRequest(loggedIn,other_id,action);
+    unlockLoggedIn(courseManager);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode studentUnFriend(CourseManager courseManager, int other_id){
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          unFriend(loggedIn,other_id);
+    unlockLoggedIn(courseManager);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode grade_sheet_add(CourseManager courseManager, int semester,
+                             int course_id, char* points, int grade){
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          gradeSheetAdd(loggedIn,semester,course_id,points,grade);
+    unlockLoggedIn(courseManager);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode grade_sheet_remove(CourseManager courseManager,int semester, int course_id){
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          gradeSheetRemove(loggedIn,semester,course_id);
+    unlockLoggedIn(courseManager);
+    compactIfDue(courseManager);
+    return result;
+}
+
+MtmErrorCode grade_sheet_update(CourseManager courseManager,int course_id,int grade){
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          gradeSheetUpdate(loggedIn,course_id,grade);
+    unlockLoggedIn(courseManager);
+    compactIfDue(courseManager);
+    return result;
+}
+
+static MtmErrorCode reportLoggedInTranscript(CourseManager courseManager, FILE* file,
+                                             TranscriptReport report, int amount){
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          reportTranscript(loggedIn,file,report,amount);
+    unlockLoggedIn(courseManager);
+    return result;
+}
+
+MtmErrorCode reportFull(CourseManager courseManager,FILE* file){
+    return reportLoggedInTranscript(courseManager,file,REPORT_FULL,0);
+}
+
+MtmErrorCode reportClean(CourseManager courseManager,FILE* file){
+    return reportLoggedInTranscript(courseManager,file,REPORT_CLEAN,0);
+}
+
 MtmErrorCode reportBest(CourseManager courseManager,FILE* file, int amount){
-    if (courseManager->connectedStudent == -1) {
-        return MTM_NOT_LOGGED_IN;
+    return reportLoggedInTranscript(courseManager,file,REPORT_BEST,amount);
+}
+
+MtmErrorCode reportWorst(CourseManager courseManager,FILE* file, int amount){
+    return reportLoggedInTranscript(courseManager,file,REPORT_WORST,amount);
+}
+
+MtmErrorCode reportReference(CourseManager courseManager,FILE* file, int course_id, int amount) {
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          reportReferenceOf(loggedIn,file,course_id,amount);
+    unlockLoggedIn(courseManager);
+    return result;
+}
+
+MtmErrorCode reportFacultyRequest(CourseManager courseManager,FILE* file, int course_id, char* request){
+    Session loggedIn = lockLoggedIn(courseManager);
+    MtmErrorCode result = loggedIn == NULL ? MTM_NOT_LOGGED_IN :
+                          reportFacultyRequestOf(loggedIn,file,course_id,request);
+    unlockLoggedIn(courseManager);
+    return result;
+}
+
+/**
+ * getStudentFromId- returns the pointer to the student needed
+ *
+ * @param id - student to searched for
+ * @return
+ * 	NULL - if the student is not logged in
+ *  pointer  to student else
+ */
+Student getStudentFromId(CourseManager courseManager, int student_id) {
+    if (student_id < 0 || student_id > 1000000000) {
+        return NULL;
     }
-    if (amount<=0){
-        return MTM_INVALID_PARAMETERS;
+    return studentTableFind(courseManager->students, student_id);
+}
+
+/**
+ * writeSystem- Writes the state of the system to a new snapshot in memory:
+ * the number of changes made to it, the logged in student, the students in
+ * the order they were added and the pending requests. the enrollments of the
+ * courses aren't saved, they are built again from the transcripts.
+ *
+ * @param snapshot - the snapshot written, to be closed (or destroyed)
+ * @return
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_SUCCESS - snapshot written
+ */
+static MtmErrorCode writeSystem(CourseManager courseManager, const char* path,
+                                Snapshot* snapshot){
+    if(snapshotCreate(path,snapshot) != SNAPSHOT_SUCCESS){
+        return MTM_OUT_OF_MEMORY;
+    }
+    snapshotWriteNumber(*snapshot,courseManager->sequence);
+    snapshotWriteNumber(*snapshot,courseManager->loggedIn == NULL ? -1 :
+                                  courseManager->loggedIn->student_id);
+    snapshotWriteNumber(*snapshot,studentTableGetSize(courseManager->students));
+    STUDENT_TABLE_FOREACH(student,courseManager->students){
+        studentSave(student,*snapshot);
     }
+    requestTableSave(courseManager->friendshipRequest,*snapshot);
+    return MTM_SUCCESS;
+}
 
-    if(amount<=0){
-        return MTM_INVALID_PARAMETERS;
+//puts a written snapshot in its file
+static MtmErrorCode closeSystem(Snapshot snapshot){
+    SnapshotResult result = snapshotClose(snapshot);
+    if(result != SNAPSHOT_SUCCESS){
+        return result == SNAPSHOT_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE;
     }
-    Student loggedin = getStudentFromId(courseManager,courseManager->connectedStudent);
-    studentPrintBest(loggedin,file,amount);
     return MTM_SUCCESS;
 }
+
 /**
- * reportWorst- prints the worst grades in the transcript
- *
- * @param amount - how many grades to print
+ * courseManagerSave- Writes the state of the system to a snapshot file.
  *
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
- * 	MTM_INVALID_PARAMETERS - parameter arent valid
- * 	MTM_SUCCESS - grades was added
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the file can't be written
+ * 	MTM_SUCCESS - snapshot written
  */
-MtmErrorCode reportWorst(CourseManager courseManager,FILE* file, int amount){
-    if (courseManager->connectedStudent == -1) {
-        return MTM_NOT_LOGGED_IN;
+static MtmErrorCode saveSystem(CourseManager courseManager, const char* path){
+    Snapshot snapshot;
+    MtmErrorCode result = writeSystem(courseManager,path,&snapshot);
+    if(result != MTM_SUCCESS){
+        return result;
     }
-    if (amount<=0) {
-        return MTM_INVALID_PARAMETERS;
+    return closeSystem(snapshot);
+}
+
+static bool compactionRunning(CourseManager courseManager, bool wait);
+
+MtmErrorCode courseManagerSave(CourseManager courseManager, const char* path){
+    pthread_rwlock_wrlock(&courseManager->lock);
+    compactionRunning(courseManager,true);//it may be saving to the same file
+    MtmErrorCode result = saveSystem(courseManager,path);
+    pthread_rwlock_unlock(&courseManager->lock);
+    return result;
+}
+
+//every friend of a loaded student is a student that has it as a friend too
+static bool checkFriends(CourseManager courseManager, Student student){
+    int id = studentGetStudentId(student);
+    int friends_count;
+    int* friends = studentReturnFriends(student,&friends_count);
+    for(int i = 0; i < friends_count; i++){
+        Student friend = getStudentFromId(courseManager,friends[i]);
+        if(friend == NULL || studentCheckIfFriends(friend,id) != 1){
+            return false;
+        }
     }
-    if(amount<=0){
-        return MTM_INVALID_PARAMETERS;
+    return true;
+}
+
+//a loaded request is between two students that aren't friends
+static bool checkRequest(int id_asking, int id_asked, void* data){
+    CourseManager courseManager = data;
+    Student asking = getStudentFromId(courseManager,id_asking);
+    return asking != NULL && getStudentFromId(courseManager,id_asked) != NULL &&
+           studentCheckIfFriends(asking,id_asked) != 1;
+}
+
+//builds the enrollments of the courses from the transcripts of the students
+static SnapshotResult loadEnrollments(CourseManager courseManager){
+    STUDENT_TABLE_FOREACH(student,courseManager->students){
+        int id = studentGetStudentId(student);
+        int course_id;
+        for(int place = 0; (course_id = studentGetCourse(student,place)) != -1; place++){
+            int best_grade = studentGetBestGrade(student,course_id);
+            if(best_grade >= 0 &&
+               enrollmentTableSet(courseManager->enrollments[enrollmentStripe(course_id)],
+                                  course_id,id,best_grade) != ENROLLMENT_TABLE_SUCCESS){
+                return SNAPSHOT_OUT_OF_MEMORY;
+            }
+        }
     }
-    Student loggedin = getStudentFromId(courseManager,courseManager->connectedStudent);
-    studentPrintWorst(loggedin,file,amount);
-    return MTM_SUCCESS;
+    return SNAPSHOT_SUCCESS;
 }
 
-MtmErrorCode reportReference(CourseManager courseManager,FILE* file, int course_id, int amount) {
-    if (courseManager->connectedStudent == -1) {
-        return MTM_NOT_LOGGED_IN;
+//reads the state written by courseManagerSave into an empty system
+static SnapshotResult loadCourseManager(CourseManager courseManager, Snapshot snapshot){
+    int sequence, logged_in, count;
+    if(!snapshotReadNumber(snapshot,&sequence) || !snapshotReadNumber(snapshot,&logged_in) ||
+       !snapshotReadNumber(snapshot,&count) || sequence < 0 || count < 0){
+        return SNAPSHOT_BAD_FORMAT;
     }
-    if (amount <= 0 || course_id < 0 || course_id > 1000000) {
-        return MTM_INVALID_PARAMETERS;
+    for(int i = 0; i < count; i++){
+        Student student;
+        SnapshotResult result = studentLoad(snapshot,&student);
+        if(result != SNAPSHOT_SUCCESS){
+            return result;
+        }
+        StudentTableResult inserted = studentTableInsert(courseManager->students,student);
+        if(inserted != STUDENT_TABLE_SUCCESS){
+            studentDestroy(student);
+            return inserted == STUDENT_TABLE_OUT_OF_MEMORY ? SNAPSHOT_OUT_OF_MEMORY :
+                   SNAPSHOT_BAD_FORMAT;
+        }
     }
-    Student logged = getStudentFromId(courseManager, courseManager->connectedStudent);
-    List reference = listCreate(copyStudent, freeStudent);
-    List friends = studentReturnFriends(logged);
-    Student temp;
-    LIST_FOREACH(int*, iter, friends) {
-        temp = getStudentFromId(courseManager, *iter);
-        int tempgrade = studentGetBestGrade(temp, course_id);
-        if (tempgrade >= 0) {
-            studentInsertHelper(temp, tempgrade);
-            listInsertLast(reference, temp);
+    STUDENT_TABLE_FOREACH(student,courseManager->students){
+        if(!checkFriends(courseManager,student)){
+            return SNAPSHOT_BAD_FORMAT;
         }
     }
-    int *key = malloc(sizeof(int));
-    *key = 1;
-    listSort(reference, compareStudents, key);
-    int i = 1;
-    LIST_FOREACH(Student, iter2, reference) {
-        if (i <= amount) {
-            studentPrintStudentName(iter2, file);
-        } else {
-            break;
+    SnapshotResult result = requestTableLoad(courseManager->friendshipRequest,snapshot,
+                                             checkRequest,courseManager);
+    if(result == SNAPSHOT_SUCCESS){
+        result = loadEnrollments(courseManager);
+    }
+    if(result != SNAPSHOT_SUCCESS){
+        return result;
+    }
+    if(!snapshotIsAtEnd(snapshot)){
+        return SNAPSHOT_BAD_FORMAT;
+    }
+    if(logged_in != -1){
+        MtmErrorCode opened = sessionOpen(courseManager,logged_in,&courseManager->loggedIn);
+        if(opened != MTM_SUCCESS){
+            return opened == MTM_OUT_OF_MEMORY ? SNAPSHOT_OUT_OF_MEMORY : SNAPSHOT_BAD_FORMAT;
         }
-        i++;
     }
-    listDestroy(reference);
-    free(key);
-    return MTM_SUCCESS;
+    courseManager->sequence = sequence;
+    return SNAPSHOT_SUCCESS;
 }
 
 /**
- * reportFacultyRequest- Prints an answer to a faculty request
- * @param course_id - to which course the request is relevant
- * @param request - Remove, Cancel, Register
+ * courseManagerLoad- Creates a system in the state saved by courseManagerSave
  *
  * @return
- * 	MTM_NOT_LOGGED_IN - there's no student logged to the system
- * 	MTM_COURSE_DOES_NOT_EXIST - the course is not in the student's transcript
- * 	MTM_SUCCESS - grades was added
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the file can't be read, or isn't a valid snapshot
+ * 	MTM_SUCCESS - system created
  */
+MtmErrorCode courseManagerLoad(const char* path, CourseManager *courseManager){
+    *courseManager = NULL;
+    Snapshot snapshot;
+    SnapshotResult result = snapshotLoad(path,&snapshot);
+    if(result != SNAPSHOT_SUCCESS){
+        return result == SNAPSHOT_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE;
+    }
+    CourseManager loaded;
+    if(courseManagerCreate(&loaded) != MTM_SUCCESS){
+        snapshotDestroy(snapshot);
+        return MTM_OUT_OF_MEMORY;
+    }
+    result = loadCourseManager(loaded,snapshot);
+    snapshotDestroy(snapshot);
+    if(result != SNAPSHOT_SUCCESS){
+        courseManagerDestroy(loaded);
+        return result == SNAPSHOT_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE;
+    }
+    *courseManager = loaded;
+    return MTM_SUCCESS;
+}
 
-MtmErrorCode reportFacultyRequest(CourseManager courseManager,FILE* file, int course_id, char* request){
-    if(courseManager->connectedStudent == -1){
-        return MTM_NOT_LOGGED_IN;
+/**
+ * applySessionChange- makes a change of a student read from the journal,
+ * in a session of the student
+ */
+static void applySessionChange(Session session, const Command* change){
+    const int* numbers = change->numbers;
+    char* const* strings = change->strings;
+    switch(change->type){
+        case COMMAND_STUDENT_FRIEND_REQUEST:
+            sessionFriendRequest(session,numbers[0]);
+            break;
+        case COMMAND_STUDENT_HANDLE_REQUEST:
+            sessionHandleRequest(session,numbers[0],strings[0]);
+            break;
+        case COMMAND_STUDENT_UNFRIEND:
+            sessionUnFriend(session,numbers[0]);
+            break;
+        case COMMAND_GRADE_SHEET_ADD:
+            sessionGradeSheetAdd(session,numbers[0],numbers[1],strings[0],numbers[2]);
+            break;
+        case COMMAND_GRADE_SHEET_REMOVE:
+            sessionGradeSheetRemove(session,numbers[0],numbers[1]);
+            break;
+        case COMMAND_GRADE_SHEET_UPDATE:
+            sessionGradeSheetUpdate(session,numbers[0],numbers[1]);
+            break;
+        default://reports don't change the system, and aren't journaled
+            break;
     }
-    if(strcmp(request,"remove_course") == 0){
-        LIST_FOREACH(Student,iterator,courseManager->students){
-            if(studentGetStudentId(iterator) == courseManager->connectedStudent){
-                //we found the connected student in the list, now we'll check if the course was taken
-                if(studentDoesGradeExists(iterator,course_id) == 0){
-                    return MTM_COURSE_DOES_NOT_EXIST;
-                }
+}
+
+/**
+ * applyChange- makes a change read from the journal, the same way it was made
+ * @param student - the student who made the change
+ */
+static void applyChange(CourseManager courseManager, int student, const Command* change){
+    const int* numbers = change->numbers;
+    char* const* strings = change->strings;
+    Session session;
+    switch(change->type){
+        case COMMAND_STUDENT_ADD:
+            addStudent(courseManager,numbers[0],strings[0],strings[1]);
+            break;
+        case COMMAND_STUDENT_REMOVE:
+            removeStudent(courseManager,numbers[0]);
+            break;
+        case COMMAND_STUDENT_LOGIN:
+            studentLogIn(courseManager,numbers[0]);
+            break;
+        case COMMAND_STUDENT_LOGOUT:
+            studentLogOut(courseManager);
+            break;
+        default://the change was made in a session of the student
+            if(sessionOpen(courseManager,student,&session) == MTM_SUCCESS){
+                applySessionChange(session,change);
+                sessionClose(session);
             }
+            break;
+    }
+}
+
+/**
+ * replayJournal- makes the changes of a journal file (or its old journal) that
+ * came after the state of the system. a missing file has no changes.
+ *
+ * @return
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the file isn't a journal, or doesn't follow the system
+ * 	MTM_SUCCESS - the changes were made
+ */
+static MtmErrorCode replayJournal(CourseManager courseManager, const char* path, bool old){
+    Journal journal;
+    JournalResult loaded = journalLoad(path,old,&journal);
+    if(loaded == JOURNAL_CANNOT_OPEN_FILE){
+        return MTM_SUCCESS;
+    }
+    if(loaded != JOURNAL_SUCCESS){
+        return loaded == JOURNAL_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE;
+    }
+    MtmErrorCode result = MTM_SUCCESS;
+    Command change;
+    int student, sequence;
+    while(result == MTM_SUCCESS && journalNext(journal,&change,&student,&sequence)){
+        if(sequence <= courseManager->sequence){
+            continue;//the snapshot has it already
         }
+        if(sequence != courseManager->sequence + 1){
+            result = MTM_CANNOT_OPEN_FILE;//changes are missing between the two
+            break;
+        }
+        applyChange(courseManager,student,&change);
+        courseManager->sequence = sequence;
     }
-    if(strcmp(request,"cancel_course") != 0 && strcmp(request,"remove_course") != 0
-       && strcmp(request,"register_course") != 0){
-        return MTM_INVALID_PARAMETERS;
+    //a change cut at the end of the file was never made, anything else is lost
+    if(result == MTM_SUCCESS && journalIsDamaged(journal)){
+        result = MTM_CANNOT_OPEN_FILE;
     }
-    mtmFacultyResponse(file,"your request was rejected");
+    journalDestroy(journal);
+    return result;
+}
+
+//keeps a copy of the path in *copy
+static bool copyPath(char** copy, const char* path){
+    *copy = malloc(strlen(path) + 1);
+    if(*copy == NULL){
+        return false;
+    }
+    strcpy(*copy,path);
+    return true;
+}
+
+/**
+ * courseManagerRecover- Creates a system from its last snapshot (an empty system
+ * if there's no snapshot yet) and the changes in its journal after the snapshot.
+ * the recovered system is saved as a new snapshot, and its changes from now on
+ * are recorded in a new journal.
+ *
+ * @return
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the snapshot or the journal are damaged, or can't be written
+ * 	MTM_SUCCESS - system recovered
+ */
+MtmErrorCode courseManagerRecover(const char* snapshot_path, const char* journal_path,
+                                  CourseManager *courseManager){
+    FILE* snapshot = fopen(snapshot_path,"rb");
+    MtmErrorCode result;
+    if(snapshot != NULL){
+        fclose(snapshot);
+        result = courseManagerLoad(snapshot_path,courseManager);
+    } else {
+        result = courseManagerCreate(courseManager);
+    }
+    if(result != MTM_SUCCESS){
+        return result;
+    }
+    CourseManager recovered = *courseManager;
+    //the old journal (of a compaction that didn't finish) comes before the journal
+    result = replayJournal(recovered,journal_path,true);
+    if(result == MTM_SUCCESS){
+        result = replayJournal(recovered,journal_path,false);
+    }
+    //both journals are in the new snapshot, so they are started over
+    if(result == MTM_SUCCESS){
+        result = saveSystem(recovered,snapshot_path);
+    }
+    if(result == MTM_SUCCESS &&
+       (!copyPath(&recovered->snapshot_path,snapshot_path) ||
+        !copyPath(&recovered->journal_path,journal_path))){
+        result = MTM_OUT_OF_MEMORY;
+    }
+    if(result == MTM_SUCCESS){
+        JournalResult created = journalCreate(journal_path,recovered->sequence + 1,
+                                              &recovered->journal);
+        if(created != JOURNAL_SUCCESS){
+            result = created == JOURNAL_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY :
+                     MTM_CANNOT_OPEN_FILE;
+        }
+    }
+    if(result == MTM_SUCCESS){
+        journalRemoveOld(journal_path);
+    }
+    if(result != MTM_SUCCESS){
+        courseManagerDestroy(recovered);
+        *courseManager = NULL;
+    }
+    return result;
+}
+
+/**
+ * compactionRunning- checks on the compaction thread, if there is one
+ *
+ * @param wait - wait for the compaction to finish
+ * @return
+ * 	true - the compaction is still running
+ * 	false - there's no compaction running
+ */
+static bool compactionRunning(CourseManager courseManager, bool wait){
+    if(!courseManager->compacting){
+        return false;
+    }
+    pthread_mutex_lock(&courseManager->compaction_lock);
+    bool done = courseManager->compaction_done;
+    pthread_mutex_unlock(&courseManager->compaction_lock);
+    if(!done && !wait){
+        return true;
+    }
+    pthread_join(courseManager->compaction,NULL);
+    courseManager->compacting = false;
+    //the compaction removes the old journal once the snapshot has it
+    if(courseManager->compaction_saved){
+        courseManager->old_journal = false;
+    }
+    return false;
+}
+
+//saves the snapshot of a compaction and removes the old journal, away from the locks
+static void* saveCompaction(void* data){
+    CourseManager courseManager = data;
+    bool saved = closeSystem(courseManager->compaction_snapshot) == MTM_SUCCESS;
+    if(saved){
+        journalRemoveOld(courseManager->journal_path);
+    }
+    pthread_mutex_lock(&courseManager->compaction_lock);
+    courseManager->compaction_saved = saved;
+    courseManager->compaction_done = true;
+    pthread_mutex_unlock(&courseManager->compaction_lock);
+    return NULL;
+}
+
+/**
+ * compactNow- saves the snapshot and starts the journal over, without a thread.
+ * this also starts over a journal that failed.
+ */
+static MtmErrorCode compactNow(CourseManager courseManager){
+    compactionRunning(courseManager,true);
+    MtmErrorCode result = saveSystem(courseManager,courseManager->snapshot_path);
+    if(result != MTM_SUCCESS){
+        return result;
+    }
+    //the journal and the old journal are both in the snapshot now
+    if(journalRestart(courseManager->journal,courseManager->sequence + 1) != JOURNAL_SUCCESS){
+        return MTM_CANNOT_OPEN_FILE;
+    }
+    journalRemoveOld(courseManager->journal_path);
+    courseManager->old_journal = false;
+    courseManager->journal_failed = false;
     return MTM_SUCCESS;
 }
+
 /**
- * getStudentFromId- returns the pointer to the student needed
+ * courseManagerCompact- Folds the journal into a new snapshot in the background.
+ * the system is written to a snapshot in memory and the journal is rotated,
+ * while the system and its journal are locked. then a thread saves the snapshot
+ * and removes the old journal, while the system goes on with a new journal.
+ * a journal that failed is compacted at once.
  *
- * @param id - student to searched for
  * @return
- * 	NULL - if the student is not logged in
- *  pointer  to student else
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the journal can't be rotated or the snapshot written
+ * 	MTM_SUCCESS - compaction started (or one is running already)
  */
-Student getStudentFromId(CourseManager courseManager, int student_id) {
-    if (student_id < 0 || student_id > 1000000000) {
-        return NULL;
+static MtmErrorCode compactJournal(CourseManager courseManager){
+    if(courseManager->journal == NULL){
+        return MTM_SUCCESS;
     }
-    LIST_FOREACH(Student, iterator, courseManager->students) {
-        if (studentGetStudentId(iterator) == student_id){
-            return iterator;
+    if(courseManager->journal_failed){
+        return compactNow(courseManager);
+    }
+    if(compactionRunning(courseManager,false)){
+        return MTM_SUCCESS;
+    }
+    if(courseManager->old_journal){
+        //the last compaction failed, the snapshot must take both journals
+        return compactNow(courseManager);
+    }
+    //the snapshot is exactly the state the old journal ends in
+    Snapshot snapshot;
+    MtmErrorCode result = writeSystem(courseManager,courseManager->snapshot_path,&snapshot);
+    if(result != MTM_SUCCESS){
+        return result;
+    }
+    if(journalRotate(courseManager->journal,courseManager->sequence + 1) != JOURNAL_SUCCESS){
+        snapshotDestroy(snapshot);
+        return MTM_CANNOT_OPEN_FILE;
+    }
+    courseManager->old_journal = true;
+    courseManager->compaction_snapshot = snapshot;
+    courseManager->compaction_done = false;
+    courseManager->compaction_saved = false;
+    if(pthread_create(&courseManager->compaction,NULL,saveCompaction,courseManager) != 0){
+        saveCompaction(courseManager);//without a thread it's saved right here
+        if(!courseManager->compaction_saved){
+            return MTM_CANNOT_OPEN_FILE;
         }
+        courseManager->old_journal = false;
+        return MTM_SUCCESS;
     }
-    return NULL; //shouldn't get here
+    courseManager->compacting = true;
+    return MTM_SUCCESS;
+}
+
+MtmErrorCode courseManagerCompact(CourseManager courseManager){
+    pthread_rwlock_wrlock(&courseManager->lock);
+    pthread_mutex_lock(&courseManager->journal_lock);
+    MtmErrorCode result = compactJournal(courseManager);
+    markCompaction(courseManager);
+    pthread_mutex_unlock(&courseManager->journal_lock);
+    pthread_rwlock_unlock(&courseManager->lock);
+    return result;
 }
 
 /**
@@ -669,19 +1742,41 @@ Student getStudentFromId(CourseManager courseManager, int student_id) {
 *
 */
 void courseManagerDestroy(CourseManager courseManager){
-    listDestroy(courseManager->friendshipRequest);
-    listDestroy(courseManager->students);
+    compactionRunning(courseManager,true);
+    journalClose(courseManager->journal);
+    while(courseManager->sessions != NULL){
+        sessionClose(courseManager->sessions);
+    }
+    free(courseManager->snapshot_path);
+    free(courseManager->journal_path);
+    requestTableDestroy(courseManager->friendshipRequest);
+    for(int i = 0; i < ENROLLMENT_STRIPES; i++){
+        enrollmentTableDestroy(courseManager->enrollments[i]);
+    }
+    studentTableDestroy(courseManager->students);
+    pthread_rwlock_destroy(&courseManager->lock);
+    for(int i = 0; i < STUDENT_LOCK_STRIPES; i++){
+        pthread_rwlock_destroy(&courseManager->student_locks[i].lock);
+    }
+    for(int i = 0; i < ENROLLMENT_STRIPES; i++){
+        pthread_rwlock_destroy(&courseManager->enrollment_locks[i].lock);
+    }
+    pthread_mutex_destroy(&courseManager->requests_lock);
+    pthread_mutex_destroy(&courseManager->sessions_lock);
+    pthread_mutex_destroy(&courseManager->journal_lock);
+    pthread_mutex_destroy(&courseManager->compaction_lock);
     free(courseManager);
 }
 /**
 * printing functions for tests
 */
 int getLoggedInStudentId(CourseManager courseManager){
-    return courseManager->connectedStudent;
+    pthread_rwlock_rdlock(&courseManager->lock);
+    int id = courseManager->loggedIn == NULL ? -1 : courseManager->loggedIn->student_id;
+    pthread_rwlock_unlock(&courseManager->lock);
+    return id;
 }
 void printFriendshipList(CourseManager courseManager){
-    LIST_FOREACH(Request,iterator,courseManager->friendshipRequest){
-        printf("\nrequest from %d to %d",iterator->id_asking,iterator->id_asked);
-    }
+    requestTablePrint(courseManager->friendshipRequest);
 }
 
@@ -28,6 +28,37 @@
  *   reportWorst            - Prints the worst grades of the logged student
  *   reportReference        - Prints all the students who have done the course and received a grade
  *   reportFacultyRequest   - Prints an answer to a faculty request
+ *   courseManagerSave      - Writes the whole state of the system to a snapshot file
+ *   courseManagerLoad      - Creates a system from a snapshot file
+ *   courseManagerRecover   - Creates a system from a snapshot file and the journal after it
+ *   courseManagerCompact   - Folds the journal of the system into its snapshot file
+ *   sessionOpen            - Opens a session of a student
+ *   sessionClose           - Closes a session
+ *   sessionGetStudentId    - Returns the student of a session
+ *   sessionFriendRequest   - Adds a request of the student of a session to the request list
+ *   sessionHandleRequest   - Handles a request waiting for answer by the student of a session
+ *   sessionUnFriend        - Unfriends a student from the friends list of the student of a session
+ *   sessionGradeSheetAdd   - Adds a grade to the sheet of the student of a session
+ *   sessionGradeSheetRemove - Removes a grade from the sheet of the student of a session
+ *   sessionGradeSheetUpdate - Updates a grade in the sheet of the student of a session
+ *   sessionReportFull      - Prints a full sheet of the grades of the student of a session
+ *   sessionReportClean     - Prints a clean sheet of the grades of the student of a session
+ *   sessionReportBest      - Prints the best grades of the student of a session
+ *   sessionReportWorst     - Prints the worst grades of the student of a session
+ *   sessionReportReference - Prints the friends of the student of a session who did a course best
+ *   sessionReportFacultyRequest - Prints an answer to a faculty request of the student of a session
+ *
+ * The logged student is served through a session of the system: studentLogIn opens it,
+ * studentLogOut closes it, and the functions of the logged student call the functions
+ * of that session. Any number of other sessions may be open beside it, each serving
+ * its own student. Removing a student ends its sessions - the functions of an ended
+ * session return MTM_NOT_LOGGED_IN until it's closed.
+ *
+ * The system may be used from several threads at once. The functions of different
+ * students run side by side - each student has its own lock - while adding, removing,
+ * logging in and out, saving and compacting wait for the system to be free. The reports
+ * only read the system, so any number of them run at once, for the same student too.
+ * A session is used by one thread at a time, and a report is written to its file as a whole.
  *
  *   Errors - all the functions will return error codes as fragged in ex3.h or -1 if success
  *   MTM_SUCCESS = -1!!!
@@ -36,6 +67,9 @@
 /** Type for defining the CourseManager */
 typedef struct CourseManager_t *CourseManager;
 
+/** Type for defining a session of a student */
+typedef struct Session_t *Session;
+
 /**
  * CourseManagerCreate: Allocates a new empty student.
  *
@@ -81,6 +115,7 @@ MtmErrorCode removeStudent(CourseManager courseManager, int id);
  * @return
  * 	MTM_STUDENT_DOES_NOT_EXIST - the student is not in the system
  * 	MTM_ALREADY_LOGGED_IN - the student is already logged in
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
  * 	MTM_SUCCESS - student removed
  */
 MtmErrorCode studentLogIn(CourseManager courseManager, int id);
@@ -256,6 +291,256 @@ MtmErrorCode reportFacultyRequest(CourseManager courseManager, FILE* file, int c
 */
 Student getStudentFromId(CourseManager courseManager, int student_id);
 
+/**
+ * courseManagerSave- Writes the whole state of the system (the students with their
+ * friends and transcripts, the pending requests and the logged in student)
+ * to a snapshot file
+ *
+ * @param path - the snapshot file, replaced only if the snapshot was written
+ * @return
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the file can't be written
+ * 	MTM_SUCCESS - snapshot written
+ */
+MtmErrorCode courseManagerSave(CourseManager courseManager, const char* path);
+
+/**
+ * courseManagerLoad- Creates a system in the state saved by courseManagerSave
+ *
+ * @param path - the snapshot file
+ * @param courseManager - pointer to the system created (NULL if it failed)
+ * @return
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the file can't be read, or isn't a valid snapshot
+ * 	MTM_SUCCESS - system created
+ */
+MtmErrorCode courseManagerLoad(const char* path, CourseManager *courseManager);
+
+/**
+ * courseManagerRecover- Creates a system from its snapshot file and the changes
+ * recorded in its journal after the snapshot (see Journal.h). The recovered
+ * system is saved to the snapshot file, and from now on every change made to it
+ * is appended to a new journal before it's made. A change that can't be appended
+ * fails with MTM_CANNOT_OPEN_FILE (and so do the changes after it), until a
+ * compaction starts the journal over.
+ *
+ * @param snapshot_path - the snapshot file, an empty system is recovered if it doesn't exist
+ * @param journal_path - the journal file, no changes are replayed if it doesn't exist
+ * @param courseManager - pointer to the system recovered (NULL if it failed)
+ * @return
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the files are damaged, or can't be written
+ * 	MTM_SUCCESS - system recovered
+ */
+MtmErrorCode courseManagerRecover(const char* snapshot_path, const char* journal_path,
+                                  CourseManager *courseManager);
+
+/**
+ * courseManagerCompact- Folds the journal of a recovered system into its snapshot
+ * file. The snapshot is saved by a thread while the system goes on with a new
+ * journal. It's called on its own once the journal holds JOURNAL_COMPACT_SIZE
+ * changes, or after a change failed to be appended to it.
+ *
+ * @return
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the journal or the snapshot can't be written
+ * 	MTM_SUCCESS - compaction started, or there's nothing to compact
+ */
+MtmErrorCode courseManagerCompact(CourseManager courseManager);
+
+/**
+ * sessionOpen- Opens a session of a student
+ *
+ * @param id - the student of the session
+ * @param session - pointer to the session opened
+ * @return
+ * 	MTM_STUDENT_DOES_NOT_EXIST - the student is not in the system
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_SUCCESS - session opened
+ */
+MtmErrorCode sessionOpen(CourseManager courseManager, int id, Session *session);
+
+/**
+ * sessionClose- Closes a session opened by sessionOpen and de-allocates it
+ *
+ * @param session
+ */
+void sessionClose(Session session);
+
+/**
+ * sessionGetStudentId- returns the student of a session
+ *
+ * @return
+ * 	-1 - the session ended, the student was removed from the system
+ * 	the id of the student otherwise
+ */
+int sessionGetStudentId(Session session);
+
+/**
+ * sessionFriendRequest- Adds a friend request of the student of the session
+ * to the set of requests
+ *
+ * @param other_id - student to be asked friends with
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_STUDENT_DOES_NOT_EXIST - student requested to be friends with is not in the system
+ * 	MTM_ALREADY_FRIEND - the students are already friends
+ * 	MTM_ALREADY_REQUESTED - the request was already made
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_CANNOT_OPEN_FILE - the request couldn't be written to the journal
+ * 	MTM_SUCCESS - student placed request
+ */
+MtmErrorCode sessionFriendRequest(Session session, int other_id);
+
+/**
+ * sessionHandleRequest- Handles a friendship request for the student of the session
+ *
+ * @param other_id - id of student who requested a friendship from the student of the session
+ * @param action - Accept/Reject request
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_STUDENT_DOES_NOT_EXIST - student requested to be friends with is not in the system
+ * 	MTM_ALREADY_FRIEND - the students are already friends
+ * 	MTM_NOT_REQUESTED - the request has not been not made
+ * 	MTM_INVALID_PARAMETERS - the action is illegal
+ * 	MTM_CANNOT_OPEN_FILE - the handling couldn't be written to the journal
+ * 	MTM_SUCCESS - Request handled
+ */
+MtmErrorCode sessionHandleRequest(Session session, int other_id, char* action);
+
+/**
+ * sessionUnFriend- Unfriends a student from the friends list of the student of the session
+ *
+ * @param other_id - id of student who is to be removed from the friends list
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_STUDENT_DOES_NOT_EXIST - student to be unfriended is not in the system
+ * 	MTM_NOT_FRIEND - the students are not friends
+ * 	MTM_CANNOT_OPEN_FILE - the change couldn't be written to the journal
+ * 	MTM_SUCCESS - students unfriend
+ */
+MtmErrorCode sessionUnFriend(Session session, int other_id);
+
+/**
+ * sessionGradeSheetAdd- adds a grade to the sheet of the student of the session
+ *
+ * @param semester - semester to be added to
+ * @param course_id - the courses id
+ * @param points - courses points
+ * @param grade - courses grade
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_INVALID_PARAMETERS - one of the parameters are not valid
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred, the sheet wasn't changed
+ * 	MTM_CANNOT_OPEN_FILE - the grade couldn't be written to the journal
+ * 	MTM_SUCCESS - grade was added
+ */
+MtmErrorCode sessionGradeSheetAdd(Session session, int semester, int course_id,
+                                  char* points, int grade);
+
+/**
+ * sessionGradeSheetRemove- removes a grade from the sheet of the student of the session
+ *
+ * @param semester - the semester of the grade
+ * @param course_id - the courses id
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_COURSE_DOES_NOT_EXIST - the course is not in the semester
+ * 	MTM_CANNOT_OPEN_FILE - the change couldn't be written to the journal
+ * 	MTM_SUCCESS - grade was removed
+ */
+MtmErrorCode sessionGradeSheetRemove(Session session, int semester, int course_id);
+
+/**
+ * sessionGradeSheetUpdate- updates the latest grade of a course in the sheet of
+ * the student of the session
+ *
+ * @param course_id - the courses id
+ * @param grade - the new grade
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_COURSE_DOES_NOT_EXIST - the course is not in the sheet
+ * 	MTM_INVALID_PARAMETERS - the grade isn't valid
+ * 	MTM_CANNOT_OPEN_FILE - the change couldn't be written to the journal
+ * 	MTM_SUCCESS - grade was updated
+ */
+MtmErrorCode sessionGradeSheetUpdate(Session session, int course_id, int grade);
+
+/**
+ * sessionReportFull- prints the transcript of the student of the session
+ *
+ * @param file - where to print
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_SUCCESS - printed
+ */
+MtmErrorCode sessionReportFull(Session session, FILE* file);
+
+/**
+ * sessionReportClean- prints the clean transcript of the student of the session
+ *
+ * @param file - where to print
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_SUCCESS - printed
+ */
+MtmErrorCode sessionReportClean(Session session, FILE* file);
+
+/**
+ * sessionReportBest- prints the best grades in the transcript of the student of the session
+ *
+ * @param file - where to print
+ * @param amount - how many grades to print
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_INVALID_PARAMETERS - amount isn't positive
+ * 	MTM_SUCCESS - printed
+ */
+MtmErrorCode sessionReportBest(Session session, FILE* file, int amount);
+
+/**
+ * sessionReportWorst- prints the worst grades in the transcript of the student of the session
+ *
+ * @param file - where to print
+ * @param amount - how many grades to print
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_INVALID_PARAMETERS - amount isn't positive
+ * 	MTM_SUCCESS - printed
+ */
+MtmErrorCode sessionReportWorst(Session session, FILE* file, int amount);
+
+/**
+ * sessionReportReference- prints the friends of the student of the session that
+ * took the course, in order of their best grades, and by id for the same grade
+ *
+ * @param file - where to print
+ * @param course_id - the course
+ * @param amount - how many friends to print
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_INVALID_PARAMETERS - parameter aren't valid
+ * 	MTM_OUT_OF_MEMORY - if a memory problem occurred
+ * 	MTM_SUCCESS - printed
+ */
+MtmErrorCode sessionReportReference(Session session, FILE* file, int course_id, int amount);
+
+/**
+ * sessionReportFacultyRequest- Prints an answer to a faculty request of the
+ * student of the session
+ *
+ * @param file - where to print
+ * @param course_id - to which course the request is relevant
+ * @param request - Remove, Cancel, Register
+ * @return
+ * 	MTM_NOT_LOGGED_IN - the session ended
+ * 	MTM_COURSE_DOES_NOT_EXIST - the course is not in the student's transcript
+ * 	MTM_INVALID_PARAMETERS - the request isn't valid
+ * 	MTM_SUCCESS - printed
+ */
+MtmErrorCode sessionReportFacultyRequest(Session session, FILE* file, int course_id,
+                                         char* request);
+
 /**
 * courseManagerDestroy- De-allocates courseManager
 *
@@ -0,0 +1,246 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include "EnrollmentTable.h"
+
+/**
+ * EnrollmentTable structure
+ *
+ * courses - the courses that have at least one student, sorted by course id.
+ *           every course holds its students sorted by student id.
+ * a course is removed from the table when its last student is removed.
+ */
+
+#define INITIAL_CAPACITY 4
+
+typedef struct CourseEnrollment_t {
+    int course_id;
+    Enrollment* students;
+    int count;
+    int capacity;
+} CourseEnrollment;
+
+/**
+ * definition of EnrollmentTable struct
+ */
+struct EnrollmentTable_t{
+    CourseEnrollment* courses;
+    int courses_count;
+    int courses_capacity;
+};
+
+//the place of the course in the courses array (or where it should be inserted)
+static int coursePlace(EnrollmentTable table, int course_id){
+    int low = 0, high = table->courses_count;
+    while(low < high){
+        int middle = low + (high - low)/2;
+        if(table->courses[middle].course_id < course_id){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+//the place of the student in the course (or where it should be inserted)
+static int studentPlace(CourseEnrollment* course, int student_id){
+    int low = 0, high = course->count;
+    while(low < high){
+        int middle = low + (high - low)/2;
+        if(course->students[middle].student_id < student_id){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static CourseEnrollment* findCourse(EnrollmentTable table, int course_id){
+    int place = coursePlace(table,course_id);
+    if(place == table->courses_count || table->courses[place].course_id != course_id){
+        return NULL;
+    }
+    return &table->courses[place];
+}
+
+//makes room for one more element, returns the array to use (NULL if there's no memory)
+static void* growArray(void* array, int count, int* capacity, size_t element_size){
+    if(count < *capacity){
+        return array;
+    }
+    int new_capacity = *capacity == 0 ? INITIAL_CAPACITY : *capacity * 2;
+    void* new_array = realloc(array,element_size*new_capacity);
+    if(new_array != NULL){
+        *capacity = new_capacity;
+    }
+    return new_array;
+}
+
+/**
+ * enrollmentTableCreate: Allocates a new empty EnrollmentTable.
+ * @param table - pointer to the table created
+ * @return
+ * ENROLLMENT_TABLE_SUCCESS - table created
+ * ENROLLMENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+EnrollmentTableResult enrollmentTableCreate(EnrollmentTable *table){
+    *table = malloc(sizeof(struct EnrollmentTable_t));
+    if((*table) == NULL){
+        return ENROLLMENT_TABLE_OUT_OF_MEMORY;
+    }
+    (*table)->courses = NULL;
+    (*table)->courses_count = 0;
+    (*table)->courses_capacity = 0;
+    return ENROLLMENT_TABLE_SUCCESS;
+}
+
+//removes the student from the course, and the course from the table if it's left empty
+static void removeEnrollment(EnrollmentTable table, int course_place, int student_id){
+    CourseEnrollment* course = &table->courses[course_place];
+    int place = studentPlace(course,student_id);
+    if(place == course->count || course->students[place].student_id != student_id){
+        return;
+    }
+    memmove(course->students + place, course->students + place + 1,
+            sizeof(Enrollment)*(course->count - place - 1));
+    course->count--;
+    if(course->count == 0){
+        free(course->students);
+        memmove(table->courses + course_place, table->courses + course_place + 1,
+                sizeof(CourseEnrollment)*(table->courses_count - course_place - 1));
+        table->courses_count--;
+    }
+}
+
+/**
+ * enrollmentTableSet: sets the best grade of a student in a course,
+ * or removes the student from the course if best_grade is negative.
+ * @return
+ * ENROLLMENT_TABLE_SUCCESS - the grade was set
+ * ENROLLMENT_TABLE_NULL_ARGUMENT - table is NULL
+ * ENROLLMENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+EnrollmentTableResult enrollmentTableSet(EnrollmentTable table, int course_id,
+                                         int student_id, int best_grade){
+    if(table == NULL){
+        return ENROLLMENT_TABLE_NULL_ARGUMENT;
+    }
+    int course_place = coursePlace(table,course_id);
+    bool found = course_place < table->courses_count &&
+                 table->courses[course_place].course_id == course_id;
+    if(best_grade < 0){
+        if(found){
+            removeEnrollment(table,course_place,student_id);
+        }
+        return ENROLLMENT_TABLE_SUCCESS;
+    }
+    if(!found){
+        CourseEnrollment* courses = growArray(table->courses,table->courses_count,
+                                              &table->courses_capacity,
+                                              sizeof(CourseEnrollment));
+        if(courses == NULL){
+            return ENROLLMENT_TABLE_OUT_OF_MEMORY;
+        }
+        table->courses = courses;
+        memmove(table->courses + course_place + 1, table->courses + course_place,
+                sizeof(CourseEnrollment)*(table->courses_count - course_place));
+        CourseEnrollment empty = {course_id, NULL, 0, 0};
+        table->courses[course_place] = empty;
+        table->courses_count++;
+    }
+    CourseEnrollment* course = &table->courses[course_place];
+    int place = studentPlace(course,student_id);
+    if(place < course->count && course->students[place].student_id == student_id){
+        course->students[place].best_grade = best_grade;
+        return ENROLLMENT_TABLE_SUCCESS;
+    }
+    Enrollment* students = growArray(course->students,course->count,
+                                     &course->capacity,sizeof(Enrollment));
+    if(students == NULL){
+        if(course->count == 0){//don't leave an empty course behind
+            removeEnrollment(table,course_place,student_id);
+        }
+        return ENROLLMENT_TABLE_OUT_OF_MEMORY;
+    }
+    course->students = students;
+    memmove(course->students + place + 1, course->students + place,
+            sizeof(Enrollment)*(course->count - place));
+    course->students[place].student_id = student_id;
+    course->students[place].best_grade = best_grade;
+    course->count++;
+    return ENROLLMENT_TABLE_SUCCESS;
+}
+
+/**
+ * enrollmentTableGetBestGrade: returns the best grade of a student in a course
+ * @return
+ * -1 - the student has no grade in the course
+ * the best grade - otherwise
+ */
+int enrollmentTableGetBestGrade(EnrollmentTable table, int course_id, int student_id){
+    if(table == NULL){
+        return -1;
+    }
+    CourseEnrollment* course = findCourse(table,course_id);
+    if(course == NULL){
+        return -1;
+    }
+    int place = studentPlace(course,student_id);
+    if(place == course->count || course->students[place].student_id != student_id){
+        return -1;
+    }
+    return course->students[place].best_grade;
+}
+
+/**
+ * enrollmentTableGetCourse: returns the students of the course sorted by id
+ * @return
+ * NULL - no student has a grade in the course
+ * the students - otherwise
+ */
+const Enrollment* enrollmentTableGetCourse(EnrollmentTable table, int course_id, int* count){
+    *count = 0;
+    if(table == NULL){
+        return NULL;
+    }
+    CourseEnrollment* course = findCourse(table,course_id);
+    if(course == NULL){
+        return NULL;
+    }
+    *count = course->count;
+    return course->students;
+}
+
+/**
+ * enrollmentTableRemoveStudent: removes a student from all the courses
+ * @param table
+ * @param student_id
+ */
+void enrollmentTableRemoveStudent(EnrollmentTable table, int student_id){
+    if(table == NULL){
+        return;
+    }
+    //going backwards, so removing an emptied course doesn't skip the next one
+    for(int i = table->courses_count - 1; i >= 0; i--){
+        removeEnrollment(table,i,student_id);
+    }
+}
+
+/**
+ * enrollmentTableDestroy: De-allocates the table.
+ * @param table
+ */
+void enrollmentTableDestroy(EnrollmentTable table){
+    if(table == NULL){
+        return;
+    }
+    for(int i = 0; i < table->courses_count; i++){
+        free(table->courses[i].students);
+    }
+    free(table->courses);
+    free(table);
+}
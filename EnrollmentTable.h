@@ -0,0 +1,100 @@
+#ifndef ENROLLMENTTABLE_H
+#define ENROLLMENTTABLE_H
+
+/**
+ * EnrollmentTable structure
+ *
+ * EnrollmentTable holds, for every course, the students that have a grade in it
+ * with the best grade each of them got, so "who took course X" is answered
+ * without going over the grade sheets of the students.
+ * The courses and the students of every course are sorted arrays (by id).
+ * The table isn't saved in a snapshot, it's built again from the transcripts.
+
+ * The following functions are available:
+ * enrollmentTableCreate:        Allocates a new empty EnrollmentTable.
+ * enrollmentTableSet:           Sets the best grade of a student in a course
+ * enrollmentTableGetBestGrade:  Returns the best grade of a student in a course
+ * enrollmentTableGetCourse:     Returns the students of a course
+ * enrollmentTableRemoveStudent: Removes a student from all the courses
+ * enrollmentTableDestroy:       De-allocates the table.
+ */
+
+/** Type for defining the enrollment table */
+typedef struct EnrollmentTable_t *EnrollmentTable;
+
+/** a student of a course and the best grade the student got in it */
+typedef struct Enrollment_t {
+    int student_id;
+    int best_grade;
+} Enrollment;
+
+/** Type used for returning error codes from enrollment table functions */
+typedef enum EnrollmentTableResult_t {
+    ENROLLMENT_TABLE_OUT_OF_MEMORY,
+    ENROLLMENT_TABLE_NULL_ARGUMENT,
+    ENROLLMENT_TABLE_SUCCESS
+} EnrollmentTableResult;
+
+/**
+ * enrollmentTableCreate: Allocates a new empty EnrollmentTable.
+ * @param table - pointer to the table created
+ * @return
+ * ENROLLMENT_TABLE_SUCCESS - table created
+ * ENROLLMENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+EnrollmentTableResult enrollmentTableCreate(EnrollmentTable *table);
+
+/**
+ * enrollmentTableSet: sets the best grade of a student in a course.
+ * a negative best grade means the student has no grade in the course,
+ * and the student is removed from it.
+ * @param table
+ * @param course_id
+ * @param student_id
+ * @param best_grade
+ * @return
+ * ENROLLMENT_TABLE_SUCCESS - the grade was set
+ * ENROLLMENT_TABLE_NULL_ARGUMENT - table is NULL
+ * ENROLLMENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+EnrollmentTableResult enrollmentTableSet(EnrollmentTable table, int course_id,
+                                         int student_id, int best_grade);
+
+/**
+ * enrollmentTableGetBestGrade: returns the best grade of a student in a course
+ * @param table
+ * @param course_id
+ * @param student_id
+ * @return
+ * -1 - the student has no grade in the course
+ * the best grade - otherwise
+ */
+int enrollmentTableGetBestGrade(EnrollmentTable table, int course_id, int student_id);
+
+/**
+ * enrollmentTableGetCourse: returns the students that have a grade in the course
+ * sorted by their id. the array belongs to the table, and is valid until
+ * the table is changed.
+ * @param table
+ * @param course_id
+ * @param count - pointer for the number of students
+ * @return
+ * NULL - no student has a grade in the course (count is 0)
+ * the students - otherwise
+ */
+const Enrollment* enrollmentTableGetCourse(EnrollmentTable table, int course_id, int* count);
+
+/**
+ * enrollmentTableRemoveStudent: removes a student from all the courses
+ * @param table
+ * @param student_id
+ */
+void enrollmentTableRemoveStudent(EnrollmentTable table, int student_id);
+
+/**
+ * enrollmentTableDestroy: De-allocates the table.
+ * @param table
+ */
+void enrollmentTableDestroy(EnrollmentTable table);
+
+#endif //ENROLLMENTTABLE_H
@@ -0,0 +1,199 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include "GradeArena.h"
+
+/**
+ * GradeArena structure
+ *
+ * chunks - the memory the blocks are carved from, newest chunk first.
+ *          blocks are carved from the first chunk until it runs out.
+ * free_blocks - a list of freed blocks for every block size up to the biggest
+ *               recycled size. bigger blocks are only released with the arena.
+ */
+
+#define ARENA_ALIGNMENT 8
+#define ARENA_SIZE_CLASSES 16//blocks up to 16*ARENA_ALIGNMENT bytes are recycled
+#define ARENA_FIRST_CHUNK 512
+#define ARENA_MAX_CHUNK 8192
+
+typedef struct ArenaChunk_t {
+    struct ArenaChunk_t* next;
+    size_t size;
+    size_t used;
+} *ArenaChunk;
+
+typedef struct FreeBlock_t {
+    struct FreeBlock_t* next;
+} *FreeBlock;
+
+/**
+ * definition of GradeArena struct
+ */
+struct GradeArena_t{
+    ArenaChunk chunks;
+    size_t next_chunk_size;
+    FreeBlock free_blocks[ARENA_SIZE_CLASSES];
+};
+
+static size_t roundSize(size_t size){
+    if(size == 0){
+        size = 1;
+    }
+    return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+//the data of a chunk starts right after its header
+static char* chunkData(ArenaChunk chunk){
+    return (char*)chunk + roundSize(sizeof(struct ArenaChunk_t));
+}
+
+static ArenaChunk chunkCreate(size_t size){
+    ArenaChunk chunk = malloc(roundSize(sizeof(struct ArenaChunk_t)) + size);
+    if(chunk == NULL){
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+/**
+ * gradeArenaCreate: Allocates a new empty GradeArena.
+ * @param arena - pointer to the arena created
+ * @return
+ * GRADE_ARENA_SUCCESS - arena created
+ * GRADE_ARENA_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeArenaResult gradeArenaCreate(GradeArena *arena){
+    *arena = malloc(sizeof(struct GradeArena_t));
+    if((*arena) == NULL){
+        return GRADE_ARENA_OUT_OF_MEMORY;
+    }
+    (*arena)->chunks = NULL;
+    (*arena)->next_chunk_size = ARENA_FIRST_CHUNK;
+    for(int i = 0; i < ARENA_SIZE_CLASSES; i++){
+        (*arena)->free_blocks[i] = NULL;
+    }
+    return GRADE_ARENA_SUCCESS;
+}
+
+/**
+ * gradeArenaAlloc: Allocates a block of size bytes from the arena.
+ * @param arena - the arena, or NULL for a regular malloc
+ * @param size
+ * @return
+ * NULL - memory problem occurred
+ * the block - otherwise
+ */
+void* gradeArenaAlloc(GradeArena arena, size_t size){
+    if(arena == NULL){
+        return malloc(size);
+    }
+    size = roundSize(size);
+    size_t size_class = size / ARENA_ALIGNMENT - 1;
+    if(size_class < ARENA_SIZE_CLASSES && arena->free_blocks[size_class] != NULL){
+        FreeBlock block = arena->free_blocks[size_class];
+        arena->free_blocks[size_class] = block->next;
+        return block;
+    }
+    ArenaChunk chunk = arena->chunks;
+    if(chunk == NULL || chunk->size - chunk->used < size){
+        if(size > arena->next_chunk_size){
+            //a big block gets a chunk of its own, the current chunk stays first
+            ArenaChunk own = chunkCreate(size);
+            if(own == NULL){
+                return NULL;
+            }
+            own->used = size;
+            if(chunk == NULL){
+                arena->chunks = own;
+            } else {
+                own->next = chunk->next;
+                chunk->next = own;
+            }
+            return chunkData(own);
+        }
+        chunk = chunkCreate(arena->next_chunk_size);
+        if(chunk == NULL){
+            return NULL;
+        }
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        if(arena->next_chunk_size < ARENA_MAX_CHUNK){
+            arena->next_chunk_size *= 2;
+        }
+    }
+    void* block = chunkData(chunk) + chunk->used;
+    chunk->used += size;
+    return block;
+}
+
+/**
+ * gradeArenaFree: Returns a block to the arena it was allocated from.
+ * @param arena - the arena of the block, or NULL if it was allocated with malloc
+ * @param block - may be NULL
+ * @param size - the size the block was allocated with
+ */
+void gradeArenaFree(GradeArena arena, void* block, size_t size){
+    if(arena == NULL){
+        free(block);
+        return;
+    }
+    if(block == NULL){
+        return;
+    }
+    size_t size_class = roundSize(size) / ARENA_ALIGNMENT - 1;
+    if(size_class < ARENA_SIZE_CLASSES){
+        FreeBlock free_block = block;
+        free_block->next = arena->free_blocks[size_class];
+        arena->free_blocks[size_class] = free_block;
+    }
+}
+
+/**
+ * gradeArenaRealloc: Moves a block to a block of a new size, with its content.
+ * an arena can't resize a block in place, so growing an array wastes its old
+ * block until the arena is destroyed (unless it's small enough to be recycled) -
+ * for an array that doubles, less than the size of the array itself.
+ * @param arena - the arena of the block, or NULL for a regular realloc
+ * @param block - may be NULL
+ * @param old_size - the size the block was allocated with
+ * @param size - the new size
+ * @return
+ * NULL - memory problem occurred, the block is left as is
+ * the new block - otherwise
+ */
+void* gradeArenaRealloc(GradeArena arena, void* block, size_t old_size, size_t size){
+    if(arena == NULL){
+        return realloc(block,size);
+    }
+    void* new_block = gradeArenaAlloc(arena,size);
+    if(new_block == NULL){
+        return NULL;
+    }
+    if(block != NULL){
+        memcpy(new_block,block,old_size < size ? old_size : size);
+        gradeArenaFree(arena,block,old_size);
+    }
+    return new_block;
+}
+
+/**
+ * gradeArenaDestroy: De-allocates the arena and every block carved from it.
+ * @param arena
+ */
+void gradeArenaDestroy(GradeArena arena){
+    if(arena == NULL){
+        return;
+    }
+    while(arena->chunks != NULL){
+        ArenaChunk next = arena->chunks->next;
+        free(arena->chunks);
+        arena->chunks = next;
+    }
+    free(arena);
+}
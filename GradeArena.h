@@ -0,0 +1,80 @@
+
+#ifndef GRADEARENA_H
+#define GRADEARENA_H
+
+#include <stddef.h>
+/**
+ * GradeArena structure
+ *
+ * GradeArena is a memory pool for the small objects of one grade sheet
+ * (course grades, their points, semesters and clean courses).
+ * Objects are carved from a few big chunks instead of being allocated one by one,
+ * freed objects are kept for reuse by objects of the same size,
+ * and all of the chunks are released at once when the arena is destroyed.
+ * Every function accepts a NULL arena, and then falls back to malloc/free.
+
+ * The following functions are available:
+ * gradeArenaCreate:  Allocates a new empty GradeArena.
+ * gradeArenaAlloc:   Allocates a block from the arena
+ * gradeArenaFree:    Returns a block to the arena for reuse
+ * gradeArenaRealloc: Moves a block to a block of another size
+ * gradeArenaDestroy: De-allocates the arena with all the blocks carved from it.
+ */
+
+/** Type for defining the arena */
+typedef struct GradeArena_t *GradeArena;
+
+/** Type used for returning error codes from arena functions */
+typedef enum GradeArenaResult_t {
+    GRADE_ARENA_OUT_OF_MEMORY,
+    GRADE_ARENA_SUCCESS
+} GradeArenaResult;
+
+/**
+ * gradeArenaCreate: Allocates a new empty GradeArena.
+ * @param arena - pointer to the arena created
+ * @return
+ * GRADE_ARENA_SUCCESS - arena created
+ * GRADE_ARENA_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeArenaResult gradeArenaCreate(GradeArena *arena);
+
+/**
+ * gradeArenaAlloc: Allocates a block of size bytes from the arena.
+ * blocks are aligned for ints and pointers.
+ * @param arena - the arena, or NULL for a regular malloc
+ * @param size
+ * @return
+ * NULL - memory problem occurred
+ * the block - otherwise
+ */
+void* gradeArenaAlloc(GradeArena arena, size_t size);
+
+/**
+ * gradeArenaFree: Returns a block to the arena it was allocated from.
+ * @param arena - the arena of the block, or NULL if it was allocated with malloc
+ * @param block - may be NULL
+ * @param size - the size the block was allocated with
+ */
+void gradeArenaFree(GradeArena arena, void* block, size_t size);
+
+/**
+ * gradeArenaRealloc: Moves a block to a block of a new size, with its content
+ * (up to the smaller of the two sizes). the old block is returned to the arena.
+ * @param arena - the arena of the block, or NULL for a regular realloc
+ * @param block - may be NULL
+ * @param old_size - the size the block was allocated with
+ * @param size - the new size
+ * @return
+ * NULL - memory problem occurred, the block is left as is
+ * the new block - otherwise
+ */
+void* gradeArenaRealloc(GradeArena arena, void* block, size_t old_size, size_t size);
+
+/**
+ * gradeArenaDestroy: De-allocates the arena and every block carved from it.
+ * @param arena
+ */
+void gradeArenaDestroy(GradeArena arena);
+
+#endif //GRADEARENA_H
@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "GradeRanking.h"
+
+/**
+ * GradeRanking structure
+ *
+ * entries - the elements in the order they were added, and after a sort in
+ *           the order of the ranking.
+ * scratch - the second array of the sorts and the counters of the tie groups,
+ *           allocated by the first sort and kept for the next ones.
+ * sorting is a radix sort of two stable counting sorts: first by tie group,
+ * then by grade, so equal grades keep the tie group order.
+ * when the entries reach twice the limit they are sorted and cut to the limit,
+ * an entry that was cut can't get back into the first limit places.
+ */
+
+#define GRADE_BUCKETS (GRADE_RANKING_MAX_GRADE - GRADE_RANKING_MIN_GRADE + 1)
+#define INITIAL_CAPACITY 8
+
+typedef struct RankingEntry_t {
+    int grade;
+    int tie;
+    void* element;
+} RankingEntry;
+
+/**
+ * definition of GradeRanking struct
+ */
+struct GradeRanking_t{
+    GradeRankingOrder order;
+    int ties;
+    int limit;
+    RankingEntry* entries;
+    int size;
+    int capacity;
+    RankingEntry* scratch;
+    int* tie_starts;
+    int scratch_capacity;
+};
+
+/**
+ * gradeRankingCreate: Allocates a new empty GradeRanking.
+ * @return
+ * GRADE_RANKING_SUCCESS - ranking created
+ * GRADE_RANKING_INVALID_PARAMETERS - ties or limit aren't positive
+ * GRADE_RANKING_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeRankingResult gradeRankingCreate(GradeRankingOrder order, int ties, int limit,
+                                      GradeRanking *ranking){
+    if(ties < 1 || limit < 1){
+        return GRADE_RANKING_INVALID_PARAMETERS;
+    }
+    *ranking = malloc(sizeof(struct GradeRanking_t));
+    if((*ranking) == NULL){
+        return GRADE_RANKING_OUT_OF_MEMORY;
+    }
+    (*ranking)->order = order;
+    (*ranking)->ties = ties;
+    (*ranking)->limit = limit;
+    (*ranking)->entries = NULL;
+    (*ranking)->size = 0;
+    (*ranking)->capacity = 0;
+    (*ranking)->scratch = NULL;
+    (*ranking)->tie_starts = NULL;
+    (*ranking)->scratch_capacity = 0;
+    return GRADE_RANKING_SUCCESS;
+}
+
+//the bucket of an entry when sorting by grade
+static int gradeBucket(GradeRanking ranking, RankingEntry* entry){
+    if(ranking->order == GRADE_RANKING_DESCENDING){
+        return GRADE_RANKING_MAX_GRADE - entry->grade;
+    }
+    return entry->grade - GRADE_RANKING_MIN_GRADE;
+}
+
+//sorts the entries into the order of the ranking
+static GradeRankingResult sortEntries(GradeRanking ranking){
+    int ties = ranking->ties > 1 ? ranking->ties : 0;
+    if(ranking->scratch_capacity < ranking->capacity){
+        RankingEntry* scratch = realloc(ranking->scratch,sizeof(RankingEntry)*ranking->capacity);
+        if(scratch == NULL){
+            return GRADE_RANKING_OUT_OF_MEMORY;
+        }
+        ranking->scratch = scratch;
+        ranking->scratch_capacity = ranking->capacity;
+    }
+    if(ties > 0 && ranking->tie_starts == NULL){
+        ranking->tie_starts = malloc(sizeof(int)*ties);
+        if(ranking->tie_starts == NULL){
+            return GRADE_RANKING_OUT_OF_MEMORY;
+        }
+    }
+    RankingEntry* from = ranking->entries;
+    RankingEntry* to = ranking->scratch;
+    if(ties > 0){
+        int* starts = ranking->tie_starts;
+        memset(starts,0,sizeof(int)*ties);
+        for(int i = 0; i < ranking->size; i++){
+            starts[from[i].tie]++;
+        }
+        for(int tie = 0, start = 0; tie < ties; tie++){
+            int count = starts[tie];
+            starts[tie] = start;
+            start += count;
+        }
+        for(int i = 0; i < ranking->size; i++){
+            to[starts[from[i].tie]++] = from[i];
+        }
+        from = ranking->scratch;
+        to = ranking->entries;
+    }
+    int starts[GRADE_BUCKETS] = {0};
+    for(int i = 0; i < ranking->size; i++){
+        starts[gradeBucket(ranking,&from[i])]++;
+    }
+    for(int bucket = 0, start = 0; bucket < GRADE_BUCKETS; bucket++){
+        int count = starts[bucket];
+        starts[bucket] = start;
+        start += count;
+    }
+    for(int i = 0; i < ranking->size; i++){
+        to[starts[gradeBucket(ranking,&from[i])]++] = from[i];
+    }
+    if(to == ranking->scratch){
+        memcpy(ranking->entries,ranking->scratch,sizeof(RankingEntry)*ranking->size);
+    }
+    return GRADE_RANKING_SUCCESS;
+}
+
+//sorts the entries and keeps only the first limit of them
+static GradeRankingResult cutToLimit(GradeRanking ranking){
+    if(ranking->size < 2){
+        return GRADE_RANKING_SUCCESS;
+    }
+    GradeRankingResult result = sortEntries(ranking);
+    if(result == GRADE_RANKING_SUCCESS && ranking->size > ranking->limit){
+        ranking->size = ranking->limit;
+    }
+    return result;
+}
+
+/**
+ * gradeRankingAdd: adds an element to the end of the ranking. the ranking holds
+ * at most twice its limit, so it doesn't grow with the number of elements added.
+ * @return
+ * GRADE_RANKING_SUCCESS - element added
+ * GRADE_RANKING_INVALID_PARAMETERS - the grade or the tie group are out of range
+ * GRADE_RANKING_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeRankingResult gradeRankingAdd(GradeRanking ranking, int grade, int tie, void* element){
+    if(ranking == NULL || grade < GRADE_RANKING_MIN_GRADE || grade > GRADE_RANKING_MAX_GRADE ||
+       tie < 0 || tie >= ranking->ties){
+        return GRADE_RANKING_INVALID_PARAMETERS;
+    }
+    int bound = ranking->limit <= INT_MAX/2 ? ranking->limit*2 : INT_MAX;
+    if(ranking->size == bound && cutToLimit(ranking) != GRADE_RANKING_SUCCESS){
+        return GRADE_RANKING_OUT_OF_MEMORY;
+    }
+    if(ranking->size == ranking->capacity){
+        int capacity = ranking->capacity == 0 ? INITIAL_CAPACITY : ranking->capacity*2;
+        if(capacity > bound){
+            capacity = bound;
+        }
+        RankingEntry* entries = realloc(ranking->entries,sizeof(RankingEntry)*capacity);
+        if(entries == NULL){
+            return GRADE_RANKING_OUT_OF_MEMORY;
+        }
+        ranking->entries = entries;
+        ranking->capacity = capacity;
+    }
+    RankingEntry entry = {grade, tie, element};
+    ranking->entries[ranking->size++] = entry;
+    return GRADE_RANKING_SUCCESS;
+}
+
+/**
+ * gradeRankingSort: sorts the elements by grade, then by tie group,
+ * then by the order they were added, and keeps the first limit of them
+ * @return
+ * GRADE_RANKING_SUCCESS - elements sorted
+ * GRADE_RANKING_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeRankingResult gradeRankingSort(GradeRanking ranking){
+    if(ranking == NULL){
+        return GRADE_RANKING_SUCCESS;
+    }
+    return cutToLimit(ranking);
+}
+
+int gradeRankingGetSize(GradeRanking ranking){
+    if(ranking == NULL){
+        return -1;
+    }
+    return ranking->size;
+}
+
+void* gradeRankingGet(GradeRanking ranking, int place){
+    if(ranking == NULL || place < 0 || place >= ranking->size){
+        return NULL;
+    }
+    return ranking->entries[place].element;
+}
+
+/**
+ * gradeRankingDestroy: De-allocates the ranking, the elements aren't de-allocated.
+ * @param ranking
+ */
+void gradeRankingDestroy(GradeRanking ranking){
+    if(ranking == NULL){
+        return;
+    }
+    free(ranking->entries);
+    free(ranking->scratch);
+    free(ranking->tie_starts);
+    free(ranking);
+}
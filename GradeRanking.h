@@ -0,0 +1,108 @@
+#ifndef GRADERANKING_H
+#define GRADERANKING_H
+
+/**
+ * GradeRanking structure
+ *
+ * GradeRanking orders elements by a grade (0 to 100) for the grade reports.
+ * Every element also has a tie group (0 to ties-1), and elements with the same
+ * grade are ordered by their tie group, and then by the order they were added.
+ * A ranking only keeps the first places up to its limit (the top-K of a report),
+ * so it holds at most twice the limit no matter how many elements are added.
+ * Sorting is done with counting sorts (by tie group, then by grade), so it takes
+ * linear time, and the scratch space is allocated once and reused.
+
+ * The following functions are available:
+ * gradeRankingCreate:  Allocates a new empty GradeRanking.
+ * gradeRankingAdd:     Adds an element to the ranking
+ * gradeRankingSort:    Sorts the elements added so far
+ * gradeRankingGetSize: Returns the number of elements in the ranking
+ * gradeRankingGet:     Returns an element by its place in the ranking
+ * gradeRankingDestroy: De-allocates the ranking (not the elements).
+ */
+
+#define GRADE_RANKING_MIN_GRADE 0
+#define GRADE_RANKING_MAX_GRADE 100
+
+/** Type for defining the ranking */
+typedef struct GradeRanking_t *GradeRanking;
+
+/** the order of the grades in the ranking */
+typedef enum GradeRankingOrder_t {
+    GRADE_RANKING_ASCENDING,
+    GRADE_RANKING_DESCENDING
+} GradeRankingOrder;
+
+/** Type used for returning error codes from ranking functions */
+typedef enum GradeRankingResult_t {
+    GRADE_RANKING_OUT_OF_MEMORY,
+    GRADE_RANKING_INVALID_PARAMETERS,
+    GRADE_RANKING_SUCCESS
+} GradeRankingResult;
+
+/**
+ * gradeRankingCreate: Allocates a new empty GradeRanking.
+ * @param order - ascending (worst first) or descending (best first) grades
+ * @param ties - the number of tie groups (at least 1)
+ * @param limit - the number of places kept (at least 1)
+ * @param ranking - pointer to the ranking created
+ * @return
+ * GRADE_RANKING_SUCCESS - ranking created
+ * GRADE_RANKING_INVALID_PARAMETERS - ties or limit aren't positive
+ * GRADE_RANKING_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeRankingResult gradeRankingCreate(GradeRankingOrder order, int ties, int limit,
+                                      GradeRanking *ranking);
+
+/**
+ * gradeRankingAdd: adds an element to the ranking. the element isn't copied.
+ * an element that can't be in the first limit places may be dropped.
+ * @param ranking
+ * @param grade
+ * @param tie - the tie group of the element
+ * @param element
+ * @return
+ * GRADE_RANKING_SUCCESS - element added
+ * GRADE_RANKING_INVALID_PARAMETERS - the grade or the tie group are out of range
+ * GRADE_RANKING_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeRankingResult gradeRankingAdd(GradeRanking ranking, int grade, int tie, void* element);
+
+/**
+ * gradeRankingSort: sorts the elements added so far - by grade in the order
+ * of the ranking, then by tie group, and then by the order they were added.
+ * only the first limit elements are left after the sort.
+ * @param ranking
+ * @return
+ * GRADE_RANKING_SUCCESS - elements sorted
+ * GRADE_RANKING_OUT_OF_MEMORY - memory problem occurred
+ */
+GradeRankingResult gradeRankingSort(GradeRanking ranking);
+
+/**
+ * gradeRankingGetSize: returns the number of elements in the ranking
+ * @param ranking
+ * @return
+ * -1 if ranking is NULL
+ * the number of elements otherwise
+ */
+int gradeRankingGetSize(GradeRanking ranking);
+
+/**
+ * gradeRankingGet: returns the element in the given place (0 is the first).
+ * the places follow the order of the ranking once it is sorted.
+ * @param ranking
+ * @param place
+ * @return
+ * NULL - the place is out of range
+ * the element - otherwise
+ */
+void* gradeRankingGet(GradeRanking ranking, int place);
+
+/**
+ * gradeRankingDestroy: De-allocates the ranking. the elements aren't de-allocated.
+ * @param ranking
+ */
+void gradeRankingDestroy(GradeRanking ranking);
+
+#endif //GRADERANKING_H
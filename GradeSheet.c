@@ -3,19 +3,25 @@
 #include <assert.h>
 #include <string.h>
 #include <stdbool.h>
-#include "list.h"
 #include "mtm_ex3.h"
 #include "GradeSheet.h"
 #include "CleanCourse.h"
 #include "SemesterGrades.h"
 #include "CourseGrades.h"
+#include "GradeArena.h"
+#include "GradeRanking.h"
 
 
 /**
  * GradeSheet structure
  *
  * GradeSheet holds the transcript of a student devided by semesters.
- * Also holds a list of courses with the last semester the course was done by the student.
+ * Also holds the courses (the clean transcript) with every time each course
+ * was done by the student, so a course can be found without going over the semesters.
+ * Both are sorted arrays, so semesters and courses are found with a binary search.
+ * The sheet itself, its arrays, semesters, course grades and clean courses are all
+ * allocated from the sheet's arena, so destroying the sheet releases the arena
+ * at once, without going over what's in it.
 
  * The following functions are available:
  * GradeSheetCreate: Allocates a new empty GradeSheet.
@@ -29,64 +35,85 @@
  * gradeSheetDestroy: De-allocates a GradeSheet.
  */
 
+/**
+ * the summary of the sheet (points doubled), kept up to date by add/remove/update.
+ * the full and the clean reports count sport courses differently,
+ * so each of them has its own effective sums.
+ */
+typedef struct SheetSummary_t {
+    int total_points;
+    int failed_points;
+    int full_effective_points;
+    int full_effective_grade_sum;
+    int clean_effective_points;
+    int clean_effective_grade_sum;
+} SheetSummary;
+
+#define FULL_SPORT_MIN 300000
+#define CLEAN_SPORT_MIN 390000
+#define SPORT_MAX 399999
+
 /**
  * definition of GradeSheet struct
  */
 struct GradeSheet_t{
-    List semesters_list;
-    List clean_transcript;
+    SemesterGrades* semesters;//sorted by semester
+    int semesters_count;
+    int semesters_capacity;
+    CleanCourse* clean_transcript;//sorted by course id
+    int clean_count;
+    int clean_capacity;
+    GradeArena arena;
+    SheetSummary summary;
 };
 
 /**
- * list cleanSemester function definitions -
- * copyCleanCourse - copy elements
- * freeCleanCourse - De-allocates elements
- * compareCleanCourse - compares elements
+ * both arrays own their elements, and are kept sorted by inserting every element
+ * in its place (binary search and shift), so they never need sorting.
+ *
+ * semesterPlace - the place of a semester in the semesters array
+ * cleanCoursePlace - the place of a course in the clean transcript
+ * growArray - makes room for one more element in an array, and returns the array
+ *             to use from now on (NULL if there's no memory, the array is left as is)
  */
-static ListElement copyCleanCourse(ListElement element) {
-    if (element == NULL) {
-        return NULL;
+static int semesterPlace(GradeSheet gradeSheet, int semester){
+    int low = 0, high = gradeSheet->semesters_count;
+    while(low < high){
+        int middle = low + (high - low)/2;
+        if(semesterGradesGetSemester(gradeSheet->semesters[middle]) < semester){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
     }
-    CleanCourse new;
-    new = cleanCourseCopy(element);
-    return new ? new : NULL;
-}
-static void freeCleanCourse(ListElement element) {
-    destroyCleanCourse(element);
+    return low;
 }
 
-int compareCleanCourse(ListElement element1,ListElement element2,ListSortKey key) {
-    assert(element1 != NULL && element2 != NULL);
-    int Id1 = getCleanCourseId(element1);
-    int Id2 = getCleanCourseId(element2);
-    int distance = Id1 - Id2;
-    key = 0;//we dont need it
-    return distance;
-}
-
-/**
- * list semesters function definitions -
- * copySemester - copy elements
- * freeSemester - De-allocates elements
- * compareSemester - compares elements
- */
-static ListElement copySemester(ListElement element) {
-    if (element == NULL) {
-        return NULL;
+static int cleanCoursePlace(GradeSheet gradeSheet, int course_id){
+    int low = 0, high = gradeSheet->clean_count;
+    while(low < high){
+        int middle = low + (high - low)/2;
+        if(getCleanCourseId(gradeSheet->clean_transcript[middle]) < course_id){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
     }
-    SemesterGrades new = semesterGradesCopy(element);
-    return new ? new : NULL;
-}
-static void freeSemester(ListElement element) {
-    semesterGradesDestroy(element);
+    return low;
 }
 
-int compareSemester(ListElement element1,ListElement element2,ListSortKey key) {
-    assert(element1 != NULL && element2 != NULL);
-    int distance = semesterGradesGetSemester(element1) -
-            semesterGradesGetSemester(element2);
-    key = 0;//we dont need it
-    return distance;
+static void* growArray(GradeArena arena, void* array, int count, int* capacity,
+                       size_t element_size){
+    if(count < *capacity){
+        return array;
+    }
+    int new_capacity = *capacity == 0 ? 4 : *capacity * 2;
+    void* new_array = gradeArenaRealloc(arena,array,element_size*(*capacity),
+                                        element_size*new_capacity);
+    if(new_array != NULL){
+        *capacity = new_capacity;
+    }
+    return new_array;
 }
 
 /**
@@ -97,16 +124,186 @@ int compareSemester(ListElement element1,ListElement element2,ListSortKey key) {
  * GRADE_SHEET_OUT_OF_MEMORY - memory problem occurred
  */
 GradeSheetResult gradeSheetCreate(GradeSheet *gradeSheet){
-    *gradeSheet = malloc(sizeof(struct GradeSheet_t));
+    GradeArena arena;
+    if(gradeArenaCreate(&arena) != GRADE_ARENA_SUCCESS){
+        *gradeSheet = NULL;
+        return GRADE_SHEET_OUT_OF_MEMORY;
+    }
+    *gradeSheet = gradeArenaAlloc(arena,sizeof(struct GradeSheet_t));
     if((*gradeSheet) == NULL){
+        gradeArenaDestroy(arena);
         return GRADE_SHEET_OUT_OF_MEMORY;
     }
-    (*gradeSheet)->clean_transcript = listCreate(copyCleanCourse,freeCleanCourse);
-    if((*gradeSheet)->clean_transcript == NULL){
+    (*gradeSheet)->arena = arena;
+    (*gradeSheet)->semesters = NULL;
+    (*gradeSheet)->semesters_count = 0;
+    (*gradeSheet)->semesters_capacity = 0;
+    (*gradeSheet)->clean_transcript = NULL;
+    (*gradeSheet)->clean_count = 0;
+    (*gradeSheet)->clean_capacity = 0;
+    SheetSummary empty = {0,0,0,0,0,0};
+    (*gradeSheet)->summary = empty;
+    return GRADE_SHEET_SUCCESS;
+}
+
+//the clean course of course_id, NULL if the course was never added
+static CleanCourse findCleanCourse(GradeSheet gradeSheet, int course_id){
+    int place = cleanCoursePlace(gradeSheet,course_id);
+    if(place == gradeSheet->clean_count ||
+       getCleanCourseId(gradeSheet->clean_transcript[place]) != course_id){
+        return NULL;
+    }
+    return gradeSheet->clean_transcript[place];
+}
+
+//finds the semester in the sheet, NULL if there's no such semester
+static SemesterGrades findSemester(GradeSheet gradeSheet, int semester){
+    int place = semesterPlace(gradeSheet,semester);
+    if(place == gradeSheet->semesters_count ||
+       semesterGradesGetSemester(gradeSheet->semesters[place]) != semester){
+        return NULL;
+    }
+    return gradeSheet->semesters[place];
+}
+
+//puts a new semester in its place (the sheet owns it from now on)
+static GradeSheetResult insertSemester(GradeSheet gradeSheet, SemesterGrades semester){
+    SemesterGrades* semesters = growArray(gradeSheet->arena,gradeSheet->semesters,
+                                          gradeSheet->semesters_count,
+                                          &gradeSheet->semesters_capacity,
+                                          sizeof(SemesterGrades));
+    if(semesters == NULL){
         return GRADE_SHEET_OUT_OF_MEMORY;
     }
-    (*gradeSheet)->semesters_list = listCreate(copySemester,freeSemester);
-    if((*gradeSheet)->semesters_list == NULL){
+    gradeSheet->semesters = semesters;
+    int place = semesterPlace(gradeSheet,semesterGradesGetSemester(semester));
+    memmove(gradeSheet->semesters + place + 1, gradeSheet->semesters + place,
+            sizeof(SemesterGrades)*(gradeSheet->semesters_count - place));
+    gradeSheet->semesters[place] = semester;
+    gradeSheet->semesters_count++;
+    return GRADE_SHEET_SUCCESS;
+}
+
+/**
+ * indexGrade: adds a course grade of the semester to the clean course of its course,
+ * creating the clean course if needed
+ */
+static GradeSheetResult indexGrade(GradeSheet gradeSheet, int semester, CourseGrade grade){
+    int course_id = courseGradeReturnCourseid(grade);
+    CleanCourse course = findCleanCourse(gradeSheet,course_id);
+    if(course != NULL){
+        if(cleanCourseAdd(course,semester,grade) != CLEAN_COURSE_SUCCESS){
+            return GRADE_SHEET_OUT_OF_MEMORY;
+        }
+        return GRADE_SHEET_SUCCESS;
+    }
+    CleanCourseResult result = cleanCourseCreate(course_id,gradeSheet->arena,&course);
+    if(result != CLEAN_COURSE_SUCCESS){
+        return result == CLEAN_COURSE_OUT_OF_MEMORY ?
+               GRADE_SHEET_OUT_OF_MEMORY : GRADE_SHEET_INVALID_PARAMETERS;
+    }
+    CleanCourse* clean_transcript = NULL;
+    if(cleanCourseAdd(course,semester,grade) == CLEAN_COURSE_SUCCESS){
+        clean_transcript = growArray(gradeSheet->arena,gradeSheet->clean_transcript,
+                                     gradeSheet->clean_count,&gradeSheet->clean_capacity,
+                                     sizeof(CleanCourse));
+    }
+    if(clean_transcript == NULL){
+        destroyCleanCourse(course);
+        return GRADE_SHEET_OUT_OF_MEMORY;
+    }
+    gradeSheet->clean_transcript = clean_transcript;
+    int place = cleanCoursePlace(gradeSheet,course_id);
+    memmove(gradeSheet->clean_transcript + place + 1, gradeSheet->clean_transcript + place,
+            sizeof(CleanCourse)*(gradeSheet->clean_count - place));
+    gradeSheet->clean_transcript[place] = course;
+    gradeSheet->clean_count++;
+    return GRADE_SHEET_SUCCESS;
+}
+
+/**
+ * courseEffective: the effective points and grade sum one course adds to a report.
+ * a sport course (sport_min to SPORT_MAX) counts the last time it was done in every
+ * semester, any other course counts the last time it was done in its last semester.
+ */
+static void courseEffective(GradeSheet gradeSheet, int course_id, int sport_min,
+                            int* points, int* grade_sum){
+    *points = 0;
+    *grade_sum = 0;
+    CleanCourse course = findCleanCourse(gradeSheet,course_id);
+    if(course == NULL){
+        return;
+    }
+    bool sport = course_id >= sport_min && course_id <= SPORT_MAX;
+    cleanCourseEffective(course,sport,points,grade_sum);
+}
+
+/**
+ * courseSummary: the parts of the summary a change to course_id in semester can
+ * affect - the total and failed points of the semester (the change of a single
+ * grade) and the effective sums of the course
+ */
+static SheetSummary courseSummary(GradeSheet gradeSheet, int semester, int course_id){
+    SheetSummary summary = {0,0,0,0,0,0};
+    SemesterGrades semester_grades = findSemester(gradeSheet,semester);
+    if(semester_grades != NULL){
+        summary.total_points = findTotalPoints(semester_grades);
+        summary.failed_points = findTotalFailedPoints(semester_grades);
+    }
+    courseEffective(gradeSheet,course_id,FULL_SPORT_MIN,
+                    &summary.full_effective_points,&summary.full_effective_grade_sum);
+    courseEffective(gradeSheet,course_id,CLEAN_SPORT_MIN,
+                    &summary.clean_effective_points,&summary.clean_effective_grade_sum);
+    return summary;
+}
+
+//moves the summary of the sheet by the change of a course summary
+static void updateSummary(GradeSheet gradeSheet, SheetSummary before, SheetSummary after){
+    SheetSummary* summary = &gradeSheet->summary;
+    summary->total_points += after.total_points - before.total_points;
+    summary->failed_points += after.failed_points - before.failed_points;
+    summary->full_effective_points +=
+            after.full_effective_points - before.full_effective_points;
+    summary->full_effective_grade_sum +=
+            after.full_effective_grade_sum - before.full_effective_grade_sum;
+    summary->clean_effective_points +=
+            after.clean_effective_points - before.clean_effective_points;
+    summary->clean_effective_grade_sum +=
+            after.clean_effective_grade_sum - before.clean_effective_grade_sum;
+}
+
+//adds the grade, gradeSheetAddGrade keeps the summary around it
+static GradeSheetResult addGrade(GradeSheet gradeSheet, int semester, int course_id,
+                                 char* points, int grade){
+    //the grade goes to its semester first, so a grade that isn't valid changes nothing
+    SemesterGrades semester_grades = findSemester(gradeSheet,semester);
+    bool new_semester = false;
+    if(semester_grades == NULL){
+        if(semesterGradesCreate(semester,gradeSheet->arena,
+                                &semester_grades) != SEMESTER_GRADES_SUCCESS){
+            return GRADE_SHEET_INVALID_PARAMETERS;
+        }
+        new_semester = true;
+    }
+    if(semesterGradesAddGrade(semester_grades,course_id,points,grade)!=SEMESTER_GRADES_SUCCESS){
+        if(new_semester){
+            semesterGradesDestroy(semester_grades);
+        }
+        return GRADE_SHEET_INVALID_PARAMETERS;
+    }
+    //then to the clean transcript
+    GradeSheetResult result = indexGrade(gradeSheet,semester,
+                                         semesterGradesGetLatestGrade(semester_grades,course_id));
+    if(result != GRADE_SHEET_SUCCESS){
+        semesterGradesRemoveGrade(semester_grades,course_id);
+        if(new_semester){
+            semesterGradesDestroy(semester_grades);
+        }
+        return result;
+    }
+    if(new_semester && insertSemester(gradeSheet,semester_grades) != GRADE_SHEET_SUCCESS){
+        cleanCourseRemove(findCleanCourse(gradeSheet,course_id),semester);
+        semesterGradesDestroy(semester_grades);
         return GRADE_SHEET_OUT_OF_MEMORY;
     }
     return GRADE_SHEET_SUCCESS;
@@ -127,53 +324,35 @@ GradeSheetResult gradeSheetAddGrade(GradeSheet gradeSheet, int semester, int cou
     if(gradeSheet == NULL || semester <= 0){
         return GRADE_SHEET_INVALID_PARAMETERS;
     }
-    bool flag = false;
-    //if clean_course exists - add semester to existing grade in clean transcript
-    LIST_FOREACH(CleanCourse ,iterator,gradeSheet->clean_transcript){
-        if(getCleanCourseId(iterator) == course_id){
-            if(cleanCourseAdd(iterator,semester)!=CLEAN_COURSE_SUCCESS){
-                return GRADE_SHEET_INVALID_PARAMETERS;
-            }
-            flag = true;break;
-        }
-    }
-    //if clean grade doesn't exist - insert a new grade to clean transcript
-    if(flag == false) {
-        CleanCourse new_course;
-        if (cleanCourseCreate(course_id, &new_course) != CLEAN_COURSE_SUCCESS) {
-            return GRADE_SHEET_INVALID_PARAMETERS;
-        }
-        if (new_course == NULL) {
-            return GRADE_SHEET_OUT_OF_MEMORY;
-        }
-        cleanCourseAdd(new_course, semester);
-        listInsertLast(gradeSheet->clean_transcript,new_course);
-        listSort(gradeSheet->clean_transcript,compareCleanCourse,0);
-        destroyCleanCourse(new_course);
-    }
-    //insert grade to semesters list
-    LIST_FOREACH(SemesterGrades ,iterator,gradeSheet->semesters_list){//if semester exists
-        if(semesterGradesGetSemester(iterator) == semester){
-            if(semesterGradesAddGrade(iterator,course_id,points,grade)!=SEMESTER_GRADES_SUCCESS){
-                return GRADE_SHEET_INVALID_PARAMETERS;
-            }
-            return GRADE_SHEET_SUCCESS;
-        }
-    }
-    //if semester doesn't exist
-    SemesterGrades new_semester;
-    if(semesterGradesCreate(semester,&new_semester) != SEMESTER_GRADES_SUCCESS){
+    SheetSummary before = courseSummary(gradeSheet,semester,course_id);
+    GradeSheetResult result = addGrade(gradeSheet,semester,course_id,points,grade);
+    updateSummary(gradeSheet,before,courseSummary(gradeSheet,semester,course_id));
+    return result;
+}
+
+//removes the grade, gradeSheetRemoveGrade keeps the summary around it
+static GradeSheetResult removeGrade(GradeSheet gradeSheet, int semester, int course_id){
+    //remove from clean_transcript
+    CleanCourse course = findCleanCourse(gradeSheet,course_id);
+    if(course != NULL && cleanCourseRemove(course,semester)!=CLEAN_COURSE_SUCCESS){
         return GRADE_SHEET_INVALID_PARAMETERS;
     }
-    if(new_semester == NULL){
-        return GRADE_SHEET_OUT_OF_MEMORY;
+    //remove from semester
+    int place = semesterPlace(gradeSheet,semester);
+    if(place == gradeSheet->semesters_count ||
+       semesterGradesGetSemester(gradeSheet->semesters[place]) != semester){
+        return GRADE_SHEET_SUCCESS;
     }
-    if(semesterGradesAddGrade(new_semester,course_id,points,grade)!=SEMESTER_GRADES_SUCCESS){
+    SemesterGrades semester_grades = gradeSheet->semesters[place];
+    if(semesterGradesRemoveGrade(semester_grades,course_id)!=SEMESTER_GRADES_SUCCESS){
         return GRADE_SHEET_INVALID_PARAMETERS;
     }
-    listInsertLast(gradeSheet->semesters_list,new_semester);
-    listSort(gradeSheet->semesters_list,compareSemester,0);
-    semesterGradesDestroy(new_semester);
+    if (semesterGradesIsEmpty(semester_grades) == 0) {
+        semesterGradesDestroy(semester_grades);
+        memmove(gradeSheet->semesters + place, gradeSheet->semesters + place + 1,
+                sizeof(SemesterGrades)*(gradeSheet->semesters_count - place - 1));
+        gradeSheet->semesters_count--;
+    }
     return GRADE_SHEET_SUCCESS;
 }
 
@@ -190,31 +369,25 @@ GradeSheetResult gradeSheetRemoveGrade(GradeSheet gradeSheet, int semester, int
     if(gradeSheet == NULL){
         return GRADE_SHEET_INVALID_PARAMETERS;
     }
-    //remove from clean_transcript
-    LIST_FOREACH(CleanCourse ,iterator,gradeSheet->clean_transcript){
-        if(getCleanCourseId(iterator) == course_id){
-            if(cleanCourseRemove(iterator,semester)!=CLEAN_COURSE_SUCCESS){
-                return GRADE_SHEET_INVALID_PARAMETERS;
-            }
-            break;
-        }
-    }
-    //remove from semester
-    LIST_FOREACH(SemesterGrades ,iterator,gradeSheet->semesters_list){
-        if(semesterGradesGetSemester(iterator) == semester){
-            if(semesterGradesRemoveGrade(iterator,course_id)!=SEMESTER_GRADES_SUCCESS){
-                return GRADE_SHEET_INVALID_PARAMETERS;
-            }
-            break;
-        }
+    SheetSummary before = courseSummary(gradeSheet,semester,course_id);
+    GradeSheetResult result = removeGrade(gradeSheet,semester,course_id);
+    updateSummary(gradeSheet,before,courseSummary(gradeSheet,semester,course_id));
+    return result;
+}
+
+//updates the grade, gradeSheetUpdateGrade keeps the summary around it
+static GradeSheetResult updateGrade(GradeSheet gradeSheet, int course_id, int grade){
+    //the last time the course was done is the last one in its clean course
+    CleanCourse course = findCleanCourse(gradeSheet,course_id);
+    if(course == NULL || cleanCourseGetLatestGrade(course) == NULL){
+        return GRADE_SHEET_COURSE_NOT_EXIST;
     }
-    LIST_FOREACH(SemesterGrades ,iterator,gradeSheet->semesters_list) {
-        if (semesterGradesGetSemester(iterator) == semester) {
-            if (semesterGradesIsEmpty(iterator) == 0) {
-                listRemoveCurrent(gradeSheet->semesters_list);
-            }
-        }
+    if(grade < 0 || grade > 100){
+        return GRADE_SHEET_INVALID_PARAMETERS;
     }
+    //the semester keeps its sums, so the update goes through it
+    semesterGradesUpdateGrade(findSemester(gradeSheet,cleanCourseGetLastSemester(course)),
+                              course_id,grade);
     return GRADE_SHEET_SUCCESS;
 }
 
@@ -232,22 +405,13 @@ GradeSheetResult gradeSheetUpdateGrade(GradeSheet gradeSheet, int course_id, int
     if(gradeSheet == NULL){
         return GRADE_SHEET_INVALID_PARAMETERS;
     }
-    SemesterGrades latest = NULL;
-    //in clean transcript there's not need to save the grade hence it takes the grade from the semester
-    //updates the grade in the semester
-    LIST_FOREACH(SemesterGrades ,iterator,gradeSheet->semesters_list){
-        if(DoesGradeExists(iterator,course_id) != -1){
-            latest = iterator;
-        }
-    }
-    if(latest ==NULL){
-        return GRADE_SHEET_COURSE_NOT_EXIST;
-    }
-    if(grade < 0 || grade > 100){
-        return GRADE_SHEET_INVALID_PARAMETERS;
-    }
-    semesterGradesUpdateGrade(latest,course_id,grade);
-    return GRADE_SHEET_SUCCESS;
+    //the update is of the last time the course was done
+    CleanCourse course = findCleanCourse(gradeSheet,course_id);
+    int semester = course == NULL ? -1 : cleanCourseGetLastSemester(course);
+    SheetSummary before = courseSummary(gradeSheet,semester,course_id);
+    GradeSheetResult result = updateGrade(gradeSheet,course_id,grade);
+    updateSummary(gradeSheet,before,courseSummary(gradeSheet,semester,course_id));
+    return result;
 }
 
 /**
@@ -255,42 +419,12 @@ GradeSheetResult gradeSheetUpdateGrade(GradeSheet gradeSheet, int course_id, int
  * @return
  */
 void gradeSheetPrintFull(GradeSheet gradeSheet,FILE* file){
-    int totalPoints = 0;
-    int failedPoints = 0;
-    int effectivePoints = 0;
-    int effecitiveGradeSum = 0;
-    LIST_FOREACH(SemesterGrades,iterator,gradeSheet->semesters_list){
-        semesterGradesPrintSemester(iterator,file);
-        totalPoints += findTotalPoints(iterator);
-        failedPoints += findTotalFailedPoints(iterator);
-    }// adds total points done and failed. effective for sheet:
-    LIST_FOREACH(CleanCourse,iterator,gradeSheet->clean_transcript){
-        int tempID = getCleanCourseId(iterator);
-        if(tempID <= 399999 && tempID >= 300000) {//sport course
-            //goes to all semesters, find last time course was done in each
-            LIST_FOREACH(SemesterGrades,iterator2,gradeSheet->semesters_list){
-                effectivePoints +=
-                        pointsLastTimeOfCourseInSemester(iterator2,tempID);
-                effecitiveGradeSum+=
-                        pointsLastTimeOfCourseInSemester(iterator2,tempID)*
-                        gradeLastTimeOfCourseInSemester(iterator2,tempID);
-            }
-        }
-        else{//now for courses that are not sport
-            int lastSemester = cleanCourseGetLastSemester(iterator);
-            LIST_FOREACH(SemesterGrades,iterator2,gradeSheet->semesters_list){
-                if (semesterGradesGetSemester(iterator2)==lastSemester){
-                    effectivePoints+=
-                            pointsLastTimeOfCourseInSemester(iterator2,tempID);
-                    effecitiveGradeSum +=
-                            pointsLastTimeOfCourseInSemester(iterator2,tempID)*
-                    gradeLastTimeOfCourseInSemester(iterator2,tempID);
-                }
-            }
-        }
+    for(int i = 0; i < gradeSheet->semesters_count; i++){
+        semesterGradesPrintSemester(gradeSheet->semesters[i],file);
     }
-    mtmPrintSummary(file,totalPoints,failedPoints,
-                    effectivePoints,effecitiveGradeSum);
+    SheetSummary* summary = &gradeSheet->summary;
+    mtmPrintSummary(file,summary->total_points,summary->failed_points,
+                    summary->full_effective_points,summary->full_effective_grade_sum);
 }
 
 /**
@@ -301,61 +435,60 @@ void gradeSheetPrintClean(GradeSheet gradeSheet,FILE* file){
     if(gradeSheet == NULL){
         return;
     }
-    int effective_points = 0, effective_grade = 0, last_semester = 0, course_number = 0;
-    LIST_FOREACH(CleanCourse,iterator_clean,gradeSheet->clean_transcript){
-        course_number = getCleanCourseId(iterator_clean);
-        if(course_number >= 390000 && course_number <= 399999){
-            LIST_FOREACH(SemesterGrades,iterator_semester,gradeSheet->semesters_list){
-                semesterGradesPrintCourseInSemester(iterator_semester,file,course_number);//should print last
-                effective_points+=pointsLastTimeOfCourseInSemester(iterator_semester,course_number);
-                effective_grade+=gradeLastTimeOfCourseInSemester(iterator_semester,course_number)*
-                        pointsLastTimeOfCourseInSemester(iterator_semester,course_number);
-            }
-        }
-        else{
-            last_semester = cleanCourseGetLastSemester(iterator_clean);
-            LIST_FOREACH(SemesterGrades,iterator_semester,gradeSheet->semesters_list){
-                if(semesterGradesGetSemester(iterator_semester) == last_semester){
-                    semesterGradesPrintCourseInSemester(iterator_semester,file,course_number);//should print last
-                    effective_points+=pointsLastTimeOfCourseInSemester(iterator_semester,course_number);
-                    effective_grade+=gradeLastTimeOfCourseInSemester(iterator_semester,course_number)*
-                                     pointsLastTimeOfCourseInSemester(iterator_semester,course_number);
-                }
-            }
-        }
+    for(int i = 0; i < gradeSheet->clean_count; i++){
+        int course_number = getCleanCourseId(gradeSheet->clean_transcript[i]);
+        //a sport course counts the last time it was done in every semester
+        cleanCoursePrint(gradeSheet->clean_transcript[i],file,
+                         course_number >= CLEAN_SPORT_MIN && course_number <= SPORT_MAX);
     }
-    mtmPrintCleanSummary(file,effective_points,effective_grade);
+    mtmPrintCleanSummary(file,gradeSheet->summary.clean_effective_points,
+                         gradeSheet->summary.clean_effective_grade_sum);
 }
 
-SemesterGrades validList(SemesterGrades validCourses,GradeSheet gradeSheet){
-    SemesterGrades new;
-    semesterGradesCreate(0,&new);// creates a fake semester to hold data
-    LIST_FOREACH(CleanCourse,iterator,gradeSheet->clean_transcript) {
-        int tempID = getCleanCourseId(iterator);
-        int tempLastSemester;
-        if (tempID > 399999 || tempID < 390000) { //not a sport course
-            tempLastSemester = cleanCourseGetLastSemester(iterator);
-            LIST_FOREACH(SemesterGrades,iterator2,gradeSheet->semesters_list){
-                if (semesterGradesGetSemester(iterator2) == tempLastSemester) {
-                    semesterGradesAddGrade(new, tempID,
-                                           CHpointsLastCourseInSemester(iterator2,tempID),
-                                           gradeLastTimeOfCourseInSemester(iterator2,tempID));
-                    semesterGradesInsertHelper(new,tempLastSemester);
-                    break;//the valid grade of this course was added
-                }
+/**
+ * printRanked: prints the first amount grades that count, by grade in the given order,
+ * then by the semester and then by the course id.
+ * the clean courses are sorted by id, so adding their grades in that order
+ * with the semester as the tie group gives the ranking this order.
+ * a sport course counts every semester it was done with a grade above 0.
+ * @return
+ * GRADE_SHEET_SUCCESS - grades printed
+ * GRADE_SHEET_OUT_OF_MEMORY - memory problem occurred
+ */
+static GradeSheetResult printRanked(GradeSheet gradeSheet, FILE* file, int amount,
+                                    GradeRankingOrder order){
+    GradeRanking ranking;
+    int ties = gradeSheet->semesters_count > 0 ? gradeSheet->semesters_count : 1;
+    if(gradeRankingCreate(order,ties,amount,&ranking) != GRADE_RANKING_SUCCESS){
+        return GRADE_SHEET_OUT_OF_MEMORY;
+    }
+    for(int i = 0; i < gradeSheet->clean_count; i++){
+        CleanCourse course = gradeSheet->clean_transcript[i];
+        int course_number = getCleanCourseId(course);
+        bool sport = course_number >= CLEAN_SPORT_MIN && course_number <= SPORT_MAX;
+        int place = 0, semester;
+        CourseGrade grade;
+        while((grade = cleanCourseNextEffective(course,sport,&place,&semester)) != NULL){
+            int course_grade = courseGradeReturnCourseGrade(grade);
+            if(sport && course_grade <= 0){
+                continue;
             }
-        } else {// now for sport course get every time course was done
-            LIST_FOREACH(SemesterGrades,iter2,gradeSheet->semesters_list){
-                if(gradeLastTimeOfCourseInSemester(iter2,tempID)>0) {
-                    semesterGradesAddGrade(new, tempID,
-                                           CHpointsLastCourseInSemester(iter2, tempID),
-                                           gradeLastTimeOfCourseInSemester(iter2, tempID));
-                    semesterGradesInsertHelper(new,tempLastSemester);
-                }
+            if(gradeRankingAdd(ranking,course_grade,semesterPlace(gradeSheet,semester),
+                               grade) != GRADE_RANKING_SUCCESS){
+                gradeRankingDestroy(ranking);
+                return GRADE_SHEET_OUT_OF_MEMORY;
             }
         }
     }
-    return new;
+    if(gradeRankingSort(ranking) != GRADE_RANKING_SUCCESS){
+        gradeRankingDestroy(ranking);
+        return GRADE_SHEET_OUT_OF_MEMORY;
+    }
+    for(int i = 0; i < amount && i < gradeRankingGetSize(ranking); i++){
+        courseGradePrintCourseGrade(gradeRankingGet(ranking,i),file);
+    }
+    gradeRankingDestroy(ranking);
+    return GRADE_SHEET_SUCCESS;
 }
 
 /**
@@ -364,22 +497,14 @@ SemesterGrades validList(SemesterGrades validCourses,GradeSheet gradeSheet){
  * @return
  * GRADE_SHEET_SUCCESS - grade printed
  * GRADE_SHEET_INVALID_PARAMETERS - parameters aren't valid
- *
+ * GRADE_SHEET_OUT_OF_MEMORY - memory problem occurred
 */
 
 GradeSheetResult gradeSheetPrintBest(GradeSheet gradeSheet,FILE* file,int amount) {
     if (amount < 1) {
         return GRADE_SHEET_INVALID_PARAMETERS;
     }
-    SemesterGrades validCourses = NULL;
-    validCourses = validList(validCourses, gradeSheet);
-    int *temp = malloc(sizeof(int));
-    *temp = -1;
-    semesterGradesSortByHelper(validCourses,temp);
-    semesterGradesPrintAmount(validCourses,file,amount);
-    semesterGradesDestroy(validCourses);
-    free(temp);
-    return GRADE_SHEET_SUCCESS;
+    return printRanked(gradeSheet,file,amount,GRADE_RANKING_DESCENDING);
 }
 
 /**
@@ -388,21 +513,14 @@ GradeSheetResult gradeSheetPrintBest(GradeSheet gradeSheet,FILE* file,int amount
  * @return
  * GRADE_SHEET_SUCCESS - grade printed
  * GRADE_SHEET_INVALID_PARAMETERS - parameters aren't valid
+ * GRADE_SHEET_OUT_OF_MEMORY - memory problem occurred
  */
 
 GradeSheetResult gradeSheetPrintWorst(GradeSheet gradeSheet,FILE* file,int amount){
     if(amount<1){
         return  GRADE_SHEET_INVALID_PARAMETERS;
     }
-    SemesterGrades validCourses = NULL;
-    validCourses = validList(validCourses, gradeSheet);
-    int *temp = malloc(sizeof(int));
-    *temp = 1;
-    semesterGradesSortByHelper(validCourses,temp);
-    semesterGradesPrintAmount(validCourses,file,amount);
-    semesterGradesDestroy(validCourses);
-    free(temp);
-    return GRADE_SHEET_SUCCESS;
+    return printRanked(gradeSheet,file,amount,GRADE_RANKING_ASCENDING);
 }
 
 /**
@@ -420,10 +538,29 @@ GradeSheet copyGradeSheet (GradeSheet gradeSheet){
     if(gradeSheetCreate(&new_sheet)!=GRADE_SHEET_SUCCESS){
         return NULL;
     }
-    listDestroy(new_sheet->clean_transcript);
-    listDestroy(new_sheet->semesters_list);
-    new_sheet->semesters_list = listCopy(gradeSheet->semesters_list);
-    new_sheet->clean_transcript = listCopy(gradeSheet->clean_transcript);
+    for(int i = 0; i < gradeSheet->semesters_count; i++){
+        SemesterGrades new_semester = semesterGradesCopy(gradeSheet->semesters[i],
+                                                         new_sheet->arena);
+        if(new_semester == NULL || insertSemester(new_sheet,new_semester) != GRADE_SHEET_SUCCESS){
+            semesterGradesDestroy(new_semester);
+            gradeSheetDestroy(new_sheet);
+            return NULL;
+        }
+    }
+    //the clean courses point at the grades of the new semesters, so they are rebuilt
+    for(int i = 0; i < new_sheet->semesters_count; i++){
+        SemesterGrades iterator = new_sheet->semesters[i];
+        int semester = semesterGradesGetSemester(iterator);
+        SemesterGradesPlace place;
+        for(CourseGrade grade = semesterGradesGetFirstGrade(iterator,&place); grade != NULL;
+            grade = semesterGradesGetNextGrade(iterator,&place)){
+            if(indexGrade(new_sheet,semester,grade) != GRADE_SHEET_SUCCESS){
+                gradeSheetDestroy(new_sheet);
+                return NULL;
+            }
+        }
+    }
+    new_sheet->summary = gradeSheet->summary;
     return new_sheet;
 }
 /**
@@ -436,15 +573,11 @@ int gradeSheetGetBestGrade(GradeSheet gradeSheet, int course_id){
     if (course_id<0 || course_id>1000000){
         return -1;
     }
-    int value = -1;
-    int tempgrade;
-    LIST_FOREACH(SemesterGrades ,iter1,gradeSheet->semesters_list){
-            tempgrade = bestGradeOfCourseInSemester(iter1,course_id);
-             if (tempgrade > value) {
-                value = tempgrade;
-            }
-        }
-    return value;
+    CleanCourse course = findCleanCourse(gradeSheet,course_id);
+    if(course == NULL){
+        return -1;
+    }
+    return cleanCourseGetBestGrade(course);
 }
 
 /**
@@ -455,12 +588,99 @@ int gradeSheetGetBestGrade(GradeSheet gradeSheet, int course_id){
  */
 int gradeSheetDoesGradeExists(GradeSheet gradeSheet, int course_id){
     assert(gradeSheet!=NULL);
-    LIST_FOREACH(SemesterGrades,iterator,gradeSheet->semesters_list){
-        if(DoesGradeExists(iterator,course_id)>=0){
-            return 1;
+    CleanCourse course = findCleanCourse(gradeSheet,course_id);
+    if(course == NULL || cleanCourseGetLatestGrade(course) == NULL){
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * gradeSheetDoesGradeExistsInSemester - checks if a grade of the course is in the semester
+ * @param- gradesheet, semester, course_id
+ * @return
+ * 1 if the grade is there, 0 otherwise
+ */
+int gradeSheetDoesGradeExistsInSemester(GradeSheet gradeSheet, int semester, int course_id){
+    assert(gradeSheet!=NULL);
+    SemesterGrades semester_grades = findSemester(gradeSheet,semester);
+    if(semester_grades == NULL || DoesGradeExists(semester_grades,course_id) == -1){
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * gradeSheetGetCourse - returns the id of the clean course in the given place
+ * @return
+ * -1 if the place is out of range, the course id otherwise
+ */
+int gradeSheetGetCourse(GradeSheet gradeSheet, int place){
+    assert(gradeSheet!=NULL);
+    if(place < 0 || place >= gradeSheet->clean_count){
+        return -1;
+    }
+    return getCleanCourseId(gradeSheet->clean_transcript[place]);
+}
+
+/**
+ * gradeSheetSave: writes the number of grades in the sheet, and then every grade
+ * (semester, course id, grade, points) semester by semester, in list order.
+ */
+void gradeSheetSave(GradeSheet gradeSheet, Snapshot snapshot){
+    int count = 0;
+    for(int i = 0; i < gradeSheet->semesters_count; i++){
+        SemesterGrades iterator = gradeSheet->semesters[i];
+        SemesterGradesPlace place;
+        for(CourseGrade grade = semesterGradesGetFirstGrade(iterator,&place); grade != NULL;
+            grade = semesterGradesGetNextGrade(iterator,&place)){
+            count++;
+        }
+    }
+    snapshotWriteNumber(snapshot,count);
+    for(int i = 0; i < gradeSheet->semesters_count; i++){
+        SemesterGrades iterator = gradeSheet->semesters[i];
+        int semester = semesterGradesGetSemester(iterator);
+        SemesterGradesPlace place;
+        for(CourseGrade grade = semesterGradesGetFirstGrade(iterator,&place); grade != NULL;
+            grade = semesterGradesGetNextGrade(iterator,&place)){
+            snapshotWriteNumber(snapshot,semester);
+            snapshotWriteNumber(snapshot,courseGradeReturnCourseid(grade));
+            snapshotWriteNumber(snapshot,courseGradeReturnCourseGrade(grade));
+            snapshotWriteString(snapshot,courseGradeReturnCoursePoints(grade));
         }
     }
-    return 0;
+}
+
+/**
+ * gradeSheetLoad: adds the grades written by gradeSheetSave to the sheet.
+ * the semesters are in order and so are the grades inside them, so adding them
+ * again builds the same semesters, clean transcript and summary.
+ * @return
+ * SNAPSHOT_SUCCESS - grades read
+ * SNAPSHOT_BAD_FORMAT - the snapshot doesn't hold a valid transcript
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult gradeSheetLoad(GradeSheet gradeSheet, Snapshot snapshot){
+    int count;
+    if(!snapshotReadNumber(snapshot,&count) || count < 0){
+        return SNAPSHOT_BAD_FORMAT;
+    }
+    for(int i = 0; i < count; i++){
+        int semester, course_id, grade;
+        const char* points;
+        if(!snapshotReadNumber(snapshot,&semester) || !snapshotReadNumber(snapshot,&course_id) ||
+           !snapshotReadNumber(snapshot,&grade) || (points = snapshotReadString(snapshot)) == NULL){
+            return SNAPSHOT_BAD_FORMAT;
+        }
+        GradeSheetResult result = gradeSheetAddGrade(gradeSheet,semester,course_id,
+                                                     (char*)points,grade);
+        if(result != GRADE_SHEET_SUCCESS){
+            return result == GRADE_SHEET_OUT_OF_MEMORY ? SNAPSHOT_OUT_OF_MEMORY :
+                   SNAPSHOT_BAD_FORMAT;
+        }
+    }
+    return SNAPSHOT_SUCCESS;
 }
 
 /**
@@ -471,8 +691,7 @@ int gradeSheetDoesGradeExists(GradeSheet gradeSheet, int course_id){
  */
 void gradeSheetDestroy(GradeSheet gradeSheet){
     if(gradeSheet!=NULL){
-        listDestroy(gradeSheet->semesters_list);
-        listDestroy(gradeSheet->clean_transcript);
+        //the sheet is in its own arena too
+        gradeArenaDestroy(gradeSheet->arena);
     }
-    free(gradeSheet);
-}
+}
@@ -2,6 +2,7 @@
 #ifndef GRADESHEET_H
 #define GRADESHEET_H
 
+#include "Snapshot.h"
 
 /**
  * GradeSheet structure
@@ -18,6 +19,8 @@
  * gradeSheetPrintClean: prints the clean transcript
  * gradeSheetPrintBest: prints the best grades (that counts) int the transcript
  * gradeSheetPrintWorst: prints the worst grades (that counts) in the trancript
+ * gradeSheetSave: writes the transcript to a snapshot
+ * gradeSheetLoad: reads a transcript written by gradeSheetSave
  * gradeSheetDestroy: De-allocates a GradeSheet.
  */
 
@@ -132,6 +135,44 @@ int gradeSheetGetBestGrade(GradeSheet gradeSheet, int course_id);
  */
 int gradeSheetDoesGradeExists(GradeSheet gradeSheet, int course_id);
 
+/**
+ * gradeSheetDoesGradeExistsInSemester - checks if a grade of the course is in the
+ * semester (so gradeSheetRemoveGrade would remove it)
+ * @param- gradesheet, semester, course_id
+ * @return
+ * 1 if the grade is there, 0 otherwise
+ */
+int gradeSheetDoesGradeExistsInSemester(GradeSheet gradeSheet, int semester, int course_id);
+
+/**
+ * gradeSheetGetCourse - returns a course of the clean transcript by its place
+ * (the courses are sorted by id)
+ * @param- gradesheet, place
+ * @return
+ * -1 if the place is out of range, the course id otherwise
+ */
+int gradeSheetGetCourse(GradeSheet gradeSheet, int place);
+
+/**
+ * gradeSheetSave: writes every grade of the transcript to a snapshot,
+ * semester by semester in the order the grades were added.
+ * @param gradeSheet
+ * @param snapshot
+ */
+void gradeSheetSave(GradeSheet gradeSheet, Snapshot snapshot);
+
+/**
+ * gradeSheetLoad: reads the grades written by gradeSheetSave into an empty sheet.
+ * the grades are added again in the same order, so the sheet is built as it was.
+ * @param gradeSheet
+ * @param snapshot
+ * @return
+ * SNAPSHOT_SUCCESS - grades read
+ * SNAPSHOT_BAD_FORMAT - the snapshot doesn't hold a valid transcript
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult gradeSheetLoad(GradeSheet gradeSheet, Snapshot snapshot);
+
 /**
  * gradeSheetDestroy: De-allocates a GradeSheet.
  *
@@ -0,0 +1,420 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "Journal.h"
+
+/**
+ * Journal structure
+ *
+ * a created journal writes every command as it comes, building it in record
+ * first so a command is passed to the file in a single write. a failed write
+ * may leave part of the command in the file, so the journal is failed and
+ * nothing else is written until the file is started over.
+ * a loaded journal holds the whole file, and its strings are used where they are.
+ */
+
+#define JOURNAL_MAGIC "MTMJ"
+#define JOURNAL_VERSION 2
+#define HEADER_SIZE 12//magic, version, sequence of the first command
+#define INITIAL_CAPACITY 64
+
+/**
+ * definition of Journal struct
+ */
+struct Journal_t{
+    FILE* file;//of a created journal
+    bool failed;//an append failed, nothing may be appended after it
+    char* path;
+    char* old_path;
+    int size;//commands in the file
+    unsigned char* record;//the command being appended
+    size_t record_capacity;
+    unsigned char* data;//of a loaded journal
+    size_t data_size;
+    size_t place;//the next command to read
+    int sequence;//of the next command to read
+    bool damaged;//the reading stopped at a damaged command
+};
+
+static void writeNumber(unsigned char* bytes, uint32_t number){
+    for(int i = 0; i < 4; i++){
+        bytes[i] = (unsigned char)(number >> (8*i));
+    }
+}
+
+static uint32_t readNumber(const unsigned char* bytes){
+    uint32_t number = 0;
+    for(int i = 0; i < 4; i++){
+        number |= (uint32_t)bytes[i] << (8*i);
+    }
+    return number;
+}
+
+static uint32_t checksum(const unsigned char* bytes, size_t size){
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < size; i++){
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+//the old journal of path, NULL if memory problem occurred
+static char* oldPath(const char* path){
+    char* old_path = malloc(strlen(path) + sizeof(JOURNAL_OLD_SUFFIX));
+    if(old_path == NULL){
+        return NULL;
+    }
+    strcpy(old_path,path);
+    strcat(old_path,JOURNAL_OLD_SUFFIX);
+    return old_path;
+}
+
+static Journal journalCreateEmpty(const char* path){
+    Journal journal = malloc(sizeof(struct Journal_t));
+    if(journal == NULL){
+        return NULL;
+    }
+    journal->file = NULL;
+    journal->failed = false;
+    journal->path = malloc(strlen(path) + 1);
+    journal->old_path = oldPath(path);
+    journal->size = 0;
+    journal->record = NULL;
+    journal->record_capacity = 0;
+    journal->data = NULL;
+    journal->data_size = 0;
+    journal->place = 0;
+    journal->sequence = 0;
+    journal->damaged = false;
+    if(journal->path == NULL || journal->old_path == NULL){
+        free(journal->path);
+        free(journal->old_path);
+        free(journal);
+        return NULL;
+    }
+    strcpy(journal->path,path);
+    return journal;
+}
+
+static void journalFree(Journal journal){
+    if(journal->file != NULL){
+        fclose(journal->file);
+    }
+    free(journal->path);
+    free(journal->old_path);
+    free(journal->record);
+    free(journal->data);
+    free(journal);
+}
+
+//starts the journal file with a header, replacing the file if it exists
+static JournalResult startFile(Journal journal, int first_sequence){
+    journal->file = fopen(journal->path,"wb");
+    if(journal->file == NULL){
+        return JOURNAL_CANNOT_OPEN_FILE;
+    }
+    //a command is a single write anyway, and nothing of a failed one may wait in
+    //a buffer to be written behind it when the file is closed
+    setvbuf(journal->file,NULL,_IONBF,0);
+    unsigned char header[HEADER_SIZE];
+    memcpy(header,JOURNAL_MAGIC,4);
+    writeNumber(header + 4,JOURNAL_VERSION);
+    writeNumber(header + 8,(uint32_t)first_sequence);
+    if(fwrite(header,1,HEADER_SIZE,journal->file) != HEADER_SIZE ||
+       fflush(journal->file) != 0){
+        fclose(journal->file);
+        journal->file = NULL;
+        return JOURNAL_CANNOT_OPEN_FILE;
+    }
+    journal->size = 0;
+    journal->failed = false;
+    return JOURNAL_SUCCESS;
+}
+
+/**
+ * journalCreate: Creates a new empty journal file to append commands to.
+ * @return
+ * JOURNAL_SUCCESS - journal created
+ * JOURNAL_CANNOT_OPEN_FILE - the file can't be written
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalCreate(const char* path, int first_sequence, Journal *journal){
+    *journal = journalCreateEmpty(path);
+    if(*journal == NULL){
+        return JOURNAL_OUT_OF_MEMORY;
+    }
+    JournalResult result = startFile(*journal,first_sequence);
+    if(result != JOURNAL_SUCCESS){
+        journalFree(*journal);
+        *journal = NULL;
+    }
+    return result;
+}
+
+//makes sure the record can hold size bytes
+static bool reserveRecord(Journal journal, size_t size){
+    if(size <= journal->record_capacity){
+        return true;
+    }
+    size_t capacity = journal->record_capacity == 0 ? INITIAL_CAPACITY : journal->record_capacity;
+    while(capacity < size){
+        capacity *= 2;
+    }
+    unsigned char* record = realloc(journal->record,capacity);
+    if(record == NULL){
+        return false;
+    }
+    journal->record = record;
+    journal->record_capacity = capacity;
+    return true;
+}
+
+/**
+ * journalAppend: appends a command to the end of the journal.
+ * the command is flushed to the file, so it survives the program ending abruptly.
+ * @return
+ * JOURNAL_SUCCESS - command appended
+ * JOURNAL_CANNOT_OPEN_FILE - writing to the file failed
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalAppend(Journal journal, int student, const Command* command){
+    if(journal->file == NULL || journal->failed){
+        return JOURNAL_CANNOT_OPEN_FILE;
+    }
+    int numbers = commandGetNumbersCount(command->type);
+    int strings = commandGetStringsCount(command->type);
+    size_t size = 1 + 4 + 4*(size_t)numbers + 4;
+    for(int i = 0; i < strings; i++){
+        size += 4 + strlen(command->strings[i]) + 1;
+    }
+    if(!reserveRecord(journal,size)){
+        return JOURNAL_OUT_OF_MEMORY;
+    }
+    unsigned char* bytes = journal->record;
+    *bytes++ = (unsigned char)command->type;
+    writeNumber(bytes,(uint32_t)student);
+    bytes += 4;
+    for(int i = 0; i < numbers; i++, bytes += 4){
+        writeNumber(bytes,(uint32_t)command->numbers[i]);
+    }
+    for(int i = 0; i < strings; i++){
+        size_t length = strlen(command->strings[i]);
+        writeNumber(bytes,(uint32_t)length);
+        memcpy(bytes + 4,command->strings[i],length + 1);
+        bytes += 4 + length + 1;
+    }
+    writeNumber(bytes,checksum(journal->record,size - 4));
+    if(fwrite(journal->record,1,size,journal->file) != size || fflush(journal->file) != 0){
+        journal->failed = true;
+        return JOURNAL_CANNOT_OPEN_FILE;
+    }
+    journal->size++;
+    return JOURNAL_SUCCESS;
+}
+
+int journalGetSize(Journal journal){
+    if(journal == NULL){
+        return -1;
+    }
+    return journal->size;
+}
+
+/**
+ * journalRotate: renames the journal file to its old journal and starts a new file.
+ * @return
+ * JOURNAL_SUCCESS - journal rotated
+ * JOURNAL_CANNOT_OPEN_FILE - the files can't be renamed or written
+ */
+JournalResult journalRotate(Journal journal, int first_sequence){
+    if(journal->failed){
+        return JOURNAL_CANNOT_OPEN_FILE;//the file has a cut command, it can't be kept
+    }
+    if(fclose(journal->file) != 0){
+        journal->file = NULL;
+        return JOURNAL_CANNOT_OPEN_FILE;
+    }
+    journal->file = NULL;
+    if(rename(journal->path,journal->old_path) != 0){
+        journal->file = fopen(journal->path,"ab");//go on with the same file
+        if(journal->file != NULL){
+            setvbuf(journal->file,NULL,_IONBF,0);
+        }
+        return JOURNAL_CANNOT_OPEN_FILE;
+    }
+    return startFile(journal,first_sequence);
+}
+
+/**
+ * journalRestart: starts the journal file over, empty.
+ * the commands of the file (and a failed append) are dropped with it.
+ * @return
+ * JOURNAL_SUCCESS - journal started over
+ * JOURNAL_CANNOT_OPEN_FILE - the file can't be written
+ */
+JournalResult journalRestart(Journal journal, int first_sequence){
+    if(journal->file != NULL){
+        fclose(journal->file);//what's left in it is dropped anyway
+        journal->file = NULL;
+    }
+    return startFile(journal,first_sequence);
+}
+
+/**
+ * journalClose: closes the journal file and de-allocates the journal.
+ * @param journal
+ */
+void journalClose(Journal journal){
+    if(journal == NULL){
+        return;
+    }
+    journalFree(journal);
+}
+
+//reads the whole file into the journal
+static JournalResult readFile(const char* path, Journal journal){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return JOURNAL_CANNOT_OPEN_FILE;
+    }
+    size_t capacity = 0;
+    size_t read = 0;
+    do{
+        journal->data_size += read;
+        if(journal->data_size == capacity){
+            capacity = capacity == 0 ? 4096 : capacity*2;
+            unsigned char* data = realloc(journal->data,capacity);
+            if(data == NULL){
+                fclose(file);
+                return JOURNAL_OUT_OF_MEMORY;
+            }
+            journal->data = data;
+        }
+    } while((read = fread(journal->data + journal->data_size,1,
+                          capacity - journal->data_size,file)) > 0);
+    bool failed = ferror(file);
+    fclose(file);
+    return failed ? JOURNAL_CANNOT_OPEN_FILE : JOURNAL_SUCCESS;
+}
+
+/**
+ * journalLoad: loads a journal file (or its old journal) to read its commands.
+ * @return
+ * JOURNAL_SUCCESS - journal loaded
+ * JOURNAL_CANNOT_OPEN_FILE - the file can't be read
+ * JOURNAL_BAD_FORMAT - the file isn't a journal of this version
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalLoad(const char* path, bool old, Journal *journal){
+    *journal = journalCreateEmpty(path);
+    if(*journal == NULL){
+        return JOURNAL_OUT_OF_MEMORY;
+    }
+    JournalResult result = readFile(old ? (*journal)->old_path : path,*journal);
+    if(result != JOURNAL_SUCCESS){
+        journalFree(*journal);
+        return result;
+    }
+    unsigned char* data = (*journal)->data;
+    if((*journal)->data_size < HEADER_SIZE || memcmp(data,JOURNAL_MAGIC,4) != 0 ||
+       readNumber(data + 4) != JOURNAL_VERSION){
+        journalFree(*journal);
+        return JOURNAL_BAD_FORMAT;
+    }
+    (*journal)->sequence = (int)readNumber(data + 8);
+    (*journal)->place = HEADER_SIZE;
+    return JOURNAL_SUCCESS;
+}
+
+/**
+ * journalNext: reads the next command of a loaded journal.
+ * a command that doesn't fit the rest of the file was cut while it was written,
+ * and ends the journal. a command that fits but is damaged (a bad type, string
+ * or checksum) also stops the reading, and is reported by journalIsDamaged,
+ * unless it's the last thing in the file.
+ * @return
+ * true - a command was read
+ * false - there are no more (whole) commands
+ */
+bool journalNext(Journal journal, Command* command, int* student, int* sequence){
+    const unsigned char* start = journal->data + journal->place;
+    size_t left = journal->data_size - journal->place;
+    if(left == 0){
+        return false;
+    }
+    if(start[0] >= COMMAND_TYPES_COUNT){
+        journal->damaged = true;
+        return false;
+    }
+    CommandType type = (CommandType)start[0];
+    int numbers = commandGetNumbersCount(type);
+    int strings = commandGetStringsCount(type);
+    size_t size = 1 + 4 + 4*(size_t)numbers;
+    if(left < size){
+        return false;
+    }
+    for(int i = 0; i < numbers; i++){
+        command->numbers[i] = (int)readNumber(start + 5 + 4*i);
+    }
+    for(int i = 0; i < strings; i++){
+        if(left - size < 4){
+            return false;
+        }
+        uint32_t length = readNumber(start + size);
+        if(left - size - 4 <= length){
+            return false;
+        }
+        if(start[size + 4 + length] != '\0'){
+            journal->damaged = true;
+            return false;
+        }
+        command->strings[i] = (char*)start + size + 4;
+        size += 4 + length + 1;
+    }
+    if(left - size < 4){
+        return false;
+    }
+    if(readNumber(start + size) != checksum(start,size)){
+        //the last command of the file may have been written only in part
+        journal->damaged = left - size > 4;
+        return false;
+    }
+    command->type = type;
+    *student = (int)readNumber(start + 1);
+    *sequence = journal->sequence++;
+    journal->place += size + 4;
+    return true;
+}
+
+bool journalIsDamaged(Journal journal){
+    return journal->damaged;
+}
+
+/**
+ * journalDestroy: De-allocates a loaded journal.
+ * @param journal
+ */
+void journalDestroy(Journal journal){
+    if(journal == NULL){
+        return;
+    }
+    journalFree(journal);
+}
+
+/**
+ * journalRemoveOld: removes the old journal of a journal file, if there is one.
+ * @return
+ * JOURNAL_SUCCESS - there's no old journal
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalRemoveOld(const char* path){
+    char* old_path = oldPath(path);
+    if(old_path == NULL){
+        return JOURNAL_OUT_OF_MEMORY;
+    }
+    remove(old_path);
+    free(old_path);
+    return JOURNAL_SUCCESS;
+}
@@ -0,0 +1,169 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdbool.h>
+#include "CommandStream.h"
+/**
+ * Journal structure
+ *
+ * Journal is an append only file of the changes made to the course manager since
+ * its last snapshot, so the system can be recovered by loading the snapshot and
+ * replaying the journal after it.
+ * Every change is a command (see CommandStream.h) made by a student, with a sequence
+ * number: the file starts with a header (magic, version and the sequence of its first
+ * command), and the commands follow one after the other. A command is its type byte,
+ * the id of the student who made it, its numbers, its strings (length, characters
+ * and '\0') and a checksum of all of them.
+ * All the numbers in the file are little endian.
+ * A command that was cut in the middle of writing it can only be the last thing in
+ * the file: once an append fails nothing is appended after it, until the file is
+ * started over. So a cut command at the end of the file ends the journal, and a
+ * damaged command anywhere else means the journal can't be trusted.
+ *
+ * When the journal is compacted it's rotated: the file is renamed to its old
+ * journal (the path followed by JOURNAL_OLD_SUFFIX) and a new file is started,
+ * so the old journal can be folded into a snapshot while changes go on.
+
+ * The following functions are available:
+ * journalCreate:    Creates a new empty journal file to append commands to
+ * journalAppend:    Appends a command to the end of the journal
+ * journalGetSize:   Returns the number of commands appended to the journal file
+ * journalRotate:    Renames the journal to its old journal and starts a new file
+ * journalRestart:   Starts the journal file over, empty
+ * journalClose:     Closes the journal file and de-allocates it
+ * journalLoad:      Loads a journal file (or its old journal) to read commands from
+ * journalNext:      Reads the next command of a loaded journal
+ * journalIsDamaged: Checks if a loaded journal stopped at a damaged command
+ * journalDestroy:   De-allocates a loaded journal
+ * journalRemoveOld: Removes the old journal of a journal file.
+ */
+
+#define JOURNAL_OLD_SUFFIX ".old"
+
+/** Type for defining the journal */
+typedef struct Journal_t *Journal;
+
+/** Type used for returning error codes from journal functions */
+typedef enum JournalResult_t {
+    JOURNAL_OUT_OF_MEMORY,
+    JOURNAL_CANNOT_OPEN_FILE,
+    JOURNAL_BAD_FORMAT,
+    JOURNAL_SUCCESS
+} JournalResult;
+
+/**
+ * journalCreate: Creates a new empty journal file (replacing the file if it exists)
+ * to append commands to.
+ * @param path
+ * @param first_sequence - the sequence number of the first command appended
+ * @param journal - pointer to the journal created
+ * @return
+ * JOURNAL_SUCCESS - journal created
+ * JOURNAL_CANNOT_OPEN_FILE - the file can't be written
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalCreate(const char* path, int first_sequence, Journal *journal);
+
+/**
+ * journalAppend: appends a command to the end of the journal, and passes it
+ * to the file before returning. after a failed append (that may have left part
+ * of the command in the file) every append fails, until the file is started over.
+ * @param journal
+ * @param student - the student who made the change, 0 for a change of the system
+ * @param command
+ * @return
+ * JOURNAL_SUCCESS - command appended
+ * JOURNAL_CANNOT_OPEN_FILE - writing to the file failed
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalAppend(Journal journal, int student, const Command* command);
+
+/**
+ * journalGetSize: returns the number of commands in the journal file
+ * @param journal
+ * @return
+ * -1 if journal is NULL
+ * the number of commands appended since the file was started otherwise
+ */
+int journalGetSize(Journal journal);
+
+/**
+ * journalRotate: renames the journal file to its old journal (replacing an old
+ * journal if there is one) and starts a new empty journal file in its place.
+ * @param journal
+ * @param first_sequence - the sequence number of the first command of the new file
+ * @return
+ * JOURNAL_SUCCESS - journal rotated
+ * JOURNAL_CANNOT_OPEN_FILE - the files can't be renamed or written
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalRotate(Journal journal, int first_sequence);
+
+/**
+ * journalRestart: starts the journal file over, empty, for a journal whose
+ * commands are all in a snapshot. this also clears a failed append.
+ * @param journal
+ * @param first_sequence - the sequence number of the first command of the file
+ * @return
+ * JOURNAL_SUCCESS - journal started over
+ * JOURNAL_CANNOT_OPEN_FILE - the file can't be written
+ */
+JournalResult journalRestart(Journal journal, int first_sequence);
+
+/**
+ * journalClose: closes the journal file and de-allocates the journal.
+ * @param journal
+ */
+void journalClose(Journal journal);
+
+/**
+ * journalLoad: loads a journal file to read its commands.
+ * @param path - the journal file
+ * @param old - load the old journal of the file instead of the file itself
+ * @param journal - pointer to the journal loaded
+ * @return
+ * JOURNAL_SUCCESS - journal loaded
+ * JOURNAL_CANNOT_OPEN_FILE - the file can't be read
+ * JOURNAL_BAD_FORMAT - the file isn't a journal of this version
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalLoad(const char* path, bool old, Journal *journal);
+
+/**
+ * journalNext: reads the next command of a loaded journal.
+ * the strings of the command belong to the journal.
+ * @param journal
+ * @param command - filled with the command read
+ * @param student - filled with the student who made the change
+ * @param sequence - filled with the sequence number of the command
+ * @return
+ * true - a command was read
+ * false - there are no more (whole) commands, see journalIsDamaged
+ */
+bool journalNext(Journal journal, Command* command, int* student, int* sequence);
+
+/**
+ * journalIsDamaged: checks why journalNext stopped reading a loaded journal
+ * @param journal
+ * @return
+ * true - it stopped at a damaged command, that isn't a command cut at the end of the file
+ * false - it read the whole file (but maybe a command cut at its end)
+ */
+bool journalIsDamaged(Journal journal);
+
+/**
+ * journalDestroy: De-allocates a loaded journal.
+ * @param journal
+ */
+void journalDestroy(Journal journal);
+
+/**
+ * journalRemoveOld: removes the old journal of a journal file, if there is one.
+ * @param path - the journal file
+ * @return
+ * JOURNAL_SUCCESS - there's no old journal
+ * JOURNAL_OUT_OF_MEMORY - memory problem occurred
+ */
+JournalResult journalRemoveOld(const char* path);
+
+#endif //JOURNAL_H
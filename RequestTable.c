@@ -0,0 +1,439 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "RequestTable.h"
+
+/**
+ * RequestTable structure
+ *
+ * requests - open addressing hash set (linear probing) of the pending requests,
+ *            each request is kept as one key built from its (asking, asked) pair
+ * buckets - open addressing hash table from a student id to the requests of the student.
+ *           a positive peer is a student that was asked by the bucket's student,
+ *           a negative peer is a student that asked the bucket's student.
+ */
+
+#define EMPTY_KEY 0
+#define DELETED_KEY 1
+#define EMPTY_BUCKET 0
+#define DELETED_BUCKET -1
+#define INITIAL_CAPACITY 16
+
+typedef struct RequestBucket_t {
+    int id;
+    int size;
+    int capacity;
+    int* peers;
+} RequestBucket;
+
+/**
+ * definition of RequestTable struct
+ */
+struct RequestTable_t{
+    uint64_t* requests;
+    int requests_capacity;//always a power of 2
+    int requests_used;//slots that are not empty, including deleted ones
+    int requests_count;
+    RequestBucket* buckets;
+    int buckets_capacity;//always a power of 2
+    int buckets_used;//slots that are not empty, including deleted ones
+    int buckets_count;
+};
+
+//student ids are positive, so a key is never EMPTY_KEY or DELETED_KEY
+static uint64_t requestKey(int id_asking, int id_asked){
+    return ((uint64_t)(uint32_t)id_asking << 32) | (uint32_t)id_asked;
+}
+
+static int hashKey(uint64_t key, int capacity){
+    key *= 0x9E3779B97F4A7C15ull;
+    return (int)((key >> 32) & (uint64_t)(capacity - 1));
+}
+
+static int capacityFor(int count){
+    int capacity = INITIAL_CAPACITY;
+    while(capacity < (count + 1) * 4){
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * functions for the requests set:
+ * findRequest - returns the slot of the key, or -1 if the key isn't in the set
+ * reserveRequest - makes sure one more key can be inserted without rebuilding the set
+ * insertRequest - inserts a key that isn't in the set
+ * deleteRequest - deletes a key from the set
+ */
+static int findRequest(RequestTable table, uint64_t key){
+    int slot = hashKey(key,table->requests_capacity);
+    while(table->requests[slot] != EMPTY_KEY){
+        if(table->requests[slot] == key){
+            return slot;
+        }
+        slot = (slot + 1) & (table->requests_capacity - 1);
+    }
+    return -1;
+}
+
+static RequestTableResult reserveRequest(RequestTable table){
+    if((table->requests_used + 1) * 2 <= table->requests_capacity){
+        return REQUEST_TABLE_SUCCESS;
+    }
+    int capacity = capacityFor(table->requests_count);
+    uint64_t* requests = malloc(sizeof(uint64_t)*capacity);
+    if(requests == NULL){
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    for(int i = 0; i < capacity; i++){
+        requests[i] = EMPTY_KEY;
+    }
+    for(int i = 0; i < table->requests_capacity; i++){
+        uint64_t key = table->requests[i];
+        if(key != EMPTY_KEY && key != DELETED_KEY){
+            int slot = hashKey(key,capacity);
+            while(requests[slot] != EMPTY_KEY){
+                slot = (slot + 1) & (capacity - 1);
+            }
+            requests[slot] = key;
+        }
+    }
+    free(table->requests);
+    table->requests = requests;
+    table->requests_capacity = capacity;
+    table->requests_used = table->requests_count;
+    return REQUEST_TABLE_SUCCESS;
+}
+
+static void insertRequest(RequestTable table, uint64_t key){
+    int slot = hashKey(key,table->requests_capacity);
+    while(table->requests[slot] != EMPTY_KEY && table->requests[slot] != DELETED_KEY){
+        slot = (slot + 1) & (table->requests_capacity - 1);
+    }
+    if(table->requests[slot] == EMPTY_KEY){
+        table->requests_used++;
+    }
+    table->requests[slot] = key;
+    table->requests_count++;
+}
+
+static bool deleteRequest(RequestTable table, uint64_t key){
+    int slot = findRequest(table,key);
+    if(slot == -1){
+        return false;
+    }
+    table->requests[slot] = DELETED_KEY;
+    table->requests_count--;
+    return true;
+}
+
+/**
+ * functions for the students buckets:
+ * findBucket - returns the bucket of the student, or NULL if there's none
+ * getBucket - returns the bucket of the student, creates it if needed
+ * reservePeer - makes sure one more peer can be added to the bucket
+ * erasePeer - removes a peer from the bucket (the order of the peers isn't kept)
+ */
+static RequestBucket* findBucket(RequestTable table, int id){
+    int slot = hashKey((uint64_t)(uint32_t)id,table->buckets_capacity);
+    while(table->buckets[slot].id != EMPTY_BUCKET){
+        if(table->buckets[slot].id == id){
+            return &table->buckets[slot];
+        }
+        slot = (slot + 1) & (table->buckets_capacity - 1);
+    }
+    return NULL;
+}
+
+static RequestTableResult rebuildBuckets(RequestTable table){
+    int capacity = capacityFor(table->buckets_count);
+    RequestBucket* buckets = malloc(sizeof(RequestBucket)*capacity);
+    if(buckets == NULL){
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    for(int i = 0; i < capacity; i++){
+        buckets[i].id = EMPTY_BUCKET;
+    }
+    for(int i = 0; i < table->buckets_capacity; i++){
+        RequestBucket bucket = table->buckets[i];
+        if(bucket.id != EMPTY_BUCKET && bucket.id != DELETED_BUCKET){
+            int slot = hashKey((uint64_t)(uint32_t)bucket.id,capacity);
+            while(buckets[slot].id != EMPTY_BUCKET){
+                slot = (slot + 1) & (capacity - 1);
+            }
+            buckets[slot] = bucket;
+        }
+    }
+    free(table->buckets);
+    table->buckets = buckets;
+    table->buckets_capacity = capacity;
+    table->buckets_used = table->buckets_count;
+    return REQUEST_TABLE_SUCCESS;
+}
+
+static RequestBucket* getBucket(RequestTable table, int id){
+    RequestBucket* bucket = findBucket(table,id);
+    if(bucket != NULL){
+        return bucket;
+    }
+    if((table->buckets_used + 1) * 2 > table->buckets_capacity){
+        if(rebuildBuckets(table) != REQUEST_TABLE_SUCCESS){
+            return NULL;
+        }
+    }
+    int slot = hashKey((uint64_t)(uint32_t)id,table->buckets_capacity);
+    while(table->buckets[slot].id != EMPTY_BUCKET &&
+          table->buckets[slot].id != DELETED_BUCKET){
+        slot = (slot + 1) & (table->buckets_capacity - 1);
+    }
+    if(table->buckets[slot].id == EMPTY_BUCKET){
+        table->buckets_used++;
+    }
+    table->buckets_count++;
+    bucket = &table->buckets[slot];
+    bucket->id = id;
+    bucket->size = 0;
+    bucket->capacity = 0;
+    bucket->peers = NULL;
+    return bucket;
+}
+
+static RequestTableResult reservePeer(RequestBucket* bucket){
+    if(bucket->size < bucket->capacity){
+        return REQUEST_TABLE_SUCCESS;
+    }
+    int capacity = bucket->capacity == 0 ? 4 : bucket->capacity * 2;
+    int* peers = realloc(bucket->peers,sizeof(int)*capacity);
+    if(peers == NULL){
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    bucket->peers = peers;
+    bucket->capacity = capacity;
+    return REQUEST_TABLE_SUCCESS;
+}
+
+static void erasePeer(RequestBucket* bucket, int peer){
+    for(int i = 0; i < bucket->size; i++){
+        if(bucket->peers[i] == peer){
+            bucket->peers[i] = bucket->peers[bucket->size - 1];
+            bucket->size--;
+            return;
+        }
+    }
+}
+
+/**
+ * requestTableCreate: Allocates a new empty RequestTable.
+ * @param table - pointer to the table created
+ * @return
+ * REQUEST_TABLE_SUCCESS - table created
+ * REQUEST_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+RequestTableResult requestTableCreate(RequestTable *table){
+    *table = malloc(sizeof(struct RequestTable_t));
+    if((*table) == NULL){
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    (*table)->requests = NULL;
+    (*table)->requests_capacity = 0;
+    (*table)->requests_used = 0;
+    (*table)->requests_count = 0;
+    (*table)->buckets = NULL;
+    (*table)->buckets_capacity = 0;
+    (*table)->buckets_used = 0;
+    (*table)->buckets_count = 0;
+    if(reserveRequest(*table) != REQUEST_TABLE_SUCCESS ||
+       rebuildBuckets(*table) != REQUEST_TABLE_SUCCESS){
+        requestTableDestroy(*table);
+        *table = NULL;
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    return REQUEST_TABLE_SUCCESS;
+}
+
+/**
+ * requestTableAdd: Adds a request from id_asking to id_asked
+ * @param table
+ * @param id_asking
+ * @param id_asked
+ * @return
+ * REQUEST_TABLE_SUCCESS - request added
+ * REQUEST_TABLE_NULL_ARGUMENT - table is NULL
+ * REQUEST_TABLE_ALREADY_EXISTS - the request is already pending
+ * REQUEST_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+RequestTableResult requestTableAdd(RequestTable table, int id_asking, int id_asked){
+    if(table == NULL){
+        return REQUEST_TABLE_NULL_ARGUMENT;
+    }
+    uint64_t key = requestKey(id_asking,id_asked);
+    if(findRequest(table,key) != -1){
+        return REQUEST_TABLE_ALREADY_EXISTS;
+    }
+    //allocate everything first, so a memory problem leaves the table unchanged
+    if(reserveRequest(table) != REQUEST_TABLE_SUCCESS){
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    RequestBucket* asking = getBucket(table,id_asking);
+    if(asking == NULL || reservePeer(asking) != REQUEST_TABLE_SUCCESS){
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    RequestBucket* asked = getBucket(table,id_asked);
+    if(asked == NULL || reservePeer(asked) != REQUEST_TABLE_SUCCESS){
+        return REQUEST_TABLE_OUT_OF_MEMORY;
+    }
+    asking = findBucket(table,id_asking);//the buckets may have moved
+    asking->peers[asking->size++] = id_asked;
+    asked->peers[asked->size++] = -id_asking;
+    insertRequest(table,key);
+    return REQUEST_TABLE_SUCCESS;
+}
+
+/**
+ * requestTableContains: checks if a request from id_asking to id_asked is pending
+ * @param table
+ * @param id_asking
+ * @param id_asked
+ * @return
+ * true if the request is pending, false otherwise
+ */
+bool requestTableContains(RequestTable table, int id_asking, int id_asked){
+    if(table == NULL){
+        return false;
+    }
+    return findRequest(table,requestKey(id_asking,id_asked)) != -1;
+}
+
+/**
+ * requestTableRemove: Removes the request from id_asking to id_asked
+ * @param table
+ * @param id_asking
+ * @param id_asked
+ * @return
+ * REQUEST_TABLE_SUCCESS - request removed
+ * REQUEST_TABLE_NULL_ARGUMENT - table is NULL
+ * REQUEST_TABLE_NOT_EXISTS - there's no such request
+ */
+RequestTableResult requestTableRemove(RequestTable table, int id_asking, int id_asked){
+    if(table == NULL){
+        return REQUEST_TABLE_NULL_ARGUMENT;
+    }
+    if(!deleteRequest(table,requestKey(id_asking,id_asked))){
+        return REQUEST_TABLE_NOT_EXISTS;
+    }
+    erasePeer(findBucket(table,id_asking),id_asked);
+    erasePeer(findBucket(table,id_asked),-id_asking);
+    return REQUEST_TABLE_SUCCESS;
+}
+
+/**
+ * requestTableRemoveStudent: Removes every request made or received by a student
+ * @param table
+ * @param id - id of the student
+ * @return
+ * REQUEST_TABLE_SUCCESS - requests removed (or there weren't any)
+ * REQUEST_TABLE_NULL_ARGUMENT - table is NULL
+ */
+RequestTableResult requestTableRemoveStudent(RequestTable table, int id){
+    if(table == NULL){
+        return REQUEST_TABLE_NULL_ARGUMENT;
+    }
+    RequestBucket* bucket = findBucket(table,id);
+    if(bucket == NULL){
+        return REQUEST_TABLE_SUCCESS;
+    }
+    for(int i = 0; i < bucket->size; i++){
+        int peer = bucket->peers[i];
+        if(peer > 0){//the student asked peer
+            deleteRequest(table,requestKey(id,peer));
+            erasePeer(findBucket(table,peer),-id);
+        } else {//peer asked the student
+            deleteRequest(table,requestKey(-peer,id));
+            erasePeer(findBucket(table,-peer),id);
+        }
+    }
+    free(bucket->peers);
+    bucket->id = DELETED_BUCKET;
+    table->buckets_count--;
+    return REQUEST_TABLE_SUCCESS;
+}
+
+/**
+ * requestTablePrint: prints all the pending requests (check function for tests)
+ * @param table
+ */
+void requestTablePrint(RequestTable table){
+    for(int i = 0; i < table->requests_capacity; i++){
+        uint64_t key = table->requests[i];
+        if(key != EMPTY_KEY && key != DELETED_KEY){
+            printf("\nrequest from %d to %d",(int)(key >> 32),(int)(key & 0xFFFFFFFFu));
+        }
+    }
+}
+
+/**
+ * requestTableSave: writes the number of pending requests,
+ * and then the (asking, asked) pair of every request
+ */
+void requestTableSave(RequestTable table, Snapshot snapshot){
+    snapshotWriteNumber(snapshot,table->requests_count);
+    for(int i = 0; i < table->requests_capacity; i++){
+        uint64_t key = table->requests[i];
+        if(key != EMPTY_KEY && key != DELETED_KEY){
+            snapshotWriteNumber(snapshot,(int)(key >> 32));
+            snapshotWriteNumber(snapshot,(int)(key & 0xFFFFFFFFu));
+        }
+    }
+}
+
+/**
+ * requestTableLoad: adds the requests written by requestTableSave to the table,
+ * if check approves each of them
+ * @return
+ * SNAPSHOT_SUCCESS - requests read
+ * SNAPSHOT_BAD_FORMAT - the snapshot doesn't hold valid requests
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult requestTableLoad(RequestTable table, Snapshot snapshot,
+                                RequestTableCheck check, void* data){
+    int count;
+    if(!snapshotReadNumber(snapshot,&count) || count < 0){
+        return SNAPSHOT_BAD_FORMAT;
+    }
+    for(int i = 0; i < count; i++){
+        int id_asking, id_asked;
+        //the keys rely on the ids being positive
+        if(!snapshotReadNumber(snapshot,&id_asking) || !snapshotReadNumber(snapshot,&id_asked) ||
+           id_asking <= 0 || id_asked <= 0 || id_asking == id_asked ||
+           !check(id_asking,id_asked,data)){
+            return SNAPSHOT_BAD_FORMAT;
+        }
+        RequestTableResult result = requestTableAdd(table,id_asking,id_asked);
+        if(result != REQUEST_TABLE_SUCCESS){
+            return result == REQUEST_TABLE_OUT_OF_MEMORY ? SNAPSHOT_OUT_OF_MEMORY :
+                   SNAPSHOT_BAD_FORMAT;
+        }
+    }
+    return SNAPSHOT_SUCCESS;
+}
+
+/**
+ * requestTableDestroy: De-allocates a RequestTable.
+ * @param table
+ */
+void requestTableDestroy(RequestTable table){
+    if(table == NULL){
+        return;
+    }
+    for(int i = 0; i < table->buckets_capacity; i++){
+        if(table->buckets[i].id != EMPTY_BUCKET && table->buckets[i].id != DELETED_BUCKET){
+            free(table->buckets[i].peers);
+        }
+    }
+    free(table->buckets);
+    free(table->requests);
+    free(table);
+}
@@ -0,0 +1,129 @@
+
+#ifndef REQUESTTABLE_H
+#define REQUESTTABLE_H
+
+#include <stdbool.h>
+#include "Snapshot.h"
+/**
+ * RequestTable structure
+ *
+ * RequestTable holds the pending friendship requests of the system.
+ * Each request is indexed by its (asking, asked) pair, and each student has a bucket
+ * with the requests he made or received, so handling or purging the requests of a
+ * student costs only as much as that student's own requests.
+
+ * The following functions are available:
+ * requestTableCreate:        Allocates a new empty RequestTable.
+ * requestTableAdd:           Adds a request from one student to another
+ * requestTableContains:      Checks if a request from one student to another is pending
+ * requestTableRemove:        Removes a request from one student to another
+ * requestTableRemoveStudent: Removes every request made or received by a student
+ * requestTablePrint:         Prints all the pending requests (for tests)
+ * requestTableSave:          Writes all the pending requests to a snapshot
+ * requestTableLoad:          Adds the requests written by requestTableSave
+ * requestTableDestroy:       De-allocates a RequestTable.
+ */
+
+/** Type for defining the request table */
+typedef struct RequestTable_t *RequestTable;
+
+/** Type used for returning error codes from request table functions */
+typedef enum RequestTableResult_t {
+    REQUEST_TABLE_OUT_OF_MEMORY,
+    REQUEST_TABLE_NULL_ARGUMENT,
+    REQUEST_TABLE_ALREADY_EXISTS,
+    REQUEST_TABLE_NOT_EXISTS,
+    REQUEST_TABLE_SUCCESS
+} RequestTableResult;
+
+/**
+ * requestTableCreate: Allocates a new empty RequestTable.
+ * @param table - pointer to the table created
+ * @return
+ * REQUEST_TABLE_SUCCESS - table created
+ * REQUEST_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+RequestTableResult requestTableCreate(RequestTable *table);
+
+/**
+ * requestTableAdd: Adds a request from id_asking to id_asked
+ * @param table
+ * @param id_asking
+ * @param id_asked
+ * @return
+ * REQUEST_TABLE_SUCCESS - request added
+ * REQUEST_TABLE_NULL_ARGUMENT - table is NULL
+ * REQUEST_TABLE_ALREADY_EXISTS - the request is already pending
+ * REQUEST_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+RequestTableResult requestTableAdd(RequestTable table, int id_asking, int id_asked);
+
+/**
+ * requestTableContains: checks if a request from id_asking to id_asked is pending
+ * @param table
+ * @param id_asking
+ * @param id_asked
+ * @return
+ * true if the request is pending, false otherwise
+ */
+bool requestTableContains(RequestTable table, int id_asking, int id_asked);
+
+/**
+ * requestTableRemove: Removes the request from id_asking to id_asked
+ * @param table
+ * @param id_asking
+ * @param id_asked
+ * @return
+ * REQUEST_TABLE_SUCCESS - request removed
+ * REQUEST_TABLE_NULL_ARGUMENT - table is NULL
+ * REQUEST_TABLE_NOT_EXISTS - there's no such request
+ */
+RequestTableResult requestTableRemove(RequestTable table, int id_asking, int id_asked);
+
+/**
+ * requestTableRemoveStudent: Removes every request made or received by a student
+ * @param table
+ * @param id - id of the student
+ * @return
+ * REQUEST_TABLE_SUCCESS - requests removed (or there weren't any)
+ * REQUEST_TABLE_NULL_ARGUMENT - table is NULL
+ */
+RequestTableResult requestTableRemoveStudent(RequestTable table, int id);
+
+/**
+ * requestTablePrint: prints all the pending requests (check function for tests)
+ * @param table
+ */
+void requestTablePrint(RequestTable table);
+
+/**
+ * requestTableSave: writes all the pending requests to a snapshot
+ * @param table
+ * @param snapshot
+ */
+void requestTableSave(RequestTable table, Snapshot snapshot);
+
+/** checks a request read from a snapshot against the rest of the system */
+typedef bool (*RequestTableCheck)(int id_asking, int id_asked, void* data);
+
+/**
+ * requestTableLoad: adds the requests written by requestTableSave to the table
+ * @param table
+ * @param snapshot
+ * @param check - called with every request read and data, false if it isn't valid
+ * @param data
+ * @return
+ * SNAPSHOT_SUCCESS - requests read
+ * SNAPSHOT_BAD_FORMAT - the snapshot doesn't hold valid requests
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult requestTableLoad(RequestTable table, Snapshot snapshot,
+                                RequestTableCheck check, void* data);
+
+/**
+ * requestTableDestroy: De-allocates a RequestTable.
+ * @param table
+ */
+void requestTableDestroy(RequestTable table);
+
+#endif //REQUESTTABLE_H
@@ -3,7 +3,6 @@
 #include <assert.h>
 #include <string.h>
 #include <stdbool.h>
-#include "list.h"
 #include "mtm_ex3.h"
 #include "SemesterGrades.h"
 #include "CourseGrades.h"
@@ -23,131 +22,235 @@
  * semesterGradesDestroy: De-allocates a GradeSheet.
  */
 
+/**
+ * the course grades of the semester are chained in the order they were added.
+ * the index points at the nodes of the chain, so a course grade found by its
+ * course id is taken out of the chain as is, without going over it.
+ */
+typedef struct GradeNode_t {
+    CourseGrade grade;
+    struct GradeNode_t* previous;
+    struct GradeNode_t* next;
+} *GradeNode;
+
 /**
  * definition of SemesterGrades struct
  */
 struct SemesterGrades_t{
     int semester;
-    List courseGrades;
+    GradeNode first;
+    GradeNode last;
+    GradeArena arena;//the arena the semester and its course grades came from
+    //the nodes sorted by course id, and by the order they were added
+    //inside a course id, so the last one of a course is the latest
+    GradeNode* index;
+    int index_size;
+    int index_capacity;
+    //running sums of the semester (points doubled), kept by add/remove/update
+    int total_points;
+    int failed_points;
+    int effective_points;//only the last time each course was done counts
+    int effective_grade_sum;
 };
 
+//the place after the last course grade of course_id in the index
+static int indexEnd(SemesterGrades semester, int course_id){
+    int low = 0, high = semester->index_size;
+    while(low < high){
+        int middle = low + (high - low)/2;
+        if(courseGradeReturnCourseid(semester->index[middle]->grade) <= course_id){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
 
-static ListElement copyCourseGrade(ListElement element) {
-    if (element == NULL) {
+//the node of the last time a course was done in the semester, NULL if it wasn't done
+static GradeNode findLatestNode(SemesterGrades semester, int course_id){
+    int end = indexEnd(semester,course_id);
+    if(end == 0 || courseGradeReturnCourseid(semester->index[end-1]->grade) != course_id){
         return NULL;
     }
-    CourseGrade new = courseGradeCopy(element);
-    return new ? new : NULL;
+    return semester->index[end-1];
+}
+
+//the last time a course was done in the semester, NULL if it wasn't done
+static CourseGrade findLatest(SemesterGrades semester, int course_id){
+    GradeNode latest = findLatestNode(semester,course_id);
+    return latest == NULL ? NULL : latest->grade;
+}
+
+//makes sure one more course grade fits in the index
+static SemesterGradesResult indexReserve(SemesterGrades semester){
+    if(semester->index_size < semester->index_capacity){
+        return SEMESTER_GRADES_SUCCESS;
+    }
+    int capacity = semester->index_capacity == 0 ? 4 : semester->index_capacity*2;
+    GradeNode* index = gradeArenaRealloc(semester->arena,semester->index,
+                                         sizeof(GradeNode)*semester->index_capacity,
+                                         sizeof(GradeNode)*capacity);
+    if(index == NULL){
+        return SEMESTER_GRADES_OUT_OF_MEMORY;
+    }
+    semester->index = index;
+    semester->index_capacity = capacity;
+    return SEMESTER_GRADES_SUCCESS;
 }
-static void freeCourseGrade(ListElement element) {
-    courseGradeDestroy(element);
+
+//puts a node after the other times its course was done (room was reserved)
+static void indexInsert(SemesterGrades semester, GradeNode node){
+    int place = indexEnd(semester,courseGradeReturnCourseid(node->grade));
+    memmove(semester->index + place + 1, semester->index + place,
+            sizeof(GradeNode)*(semester->index_size - place));
+    semester->index[place] = node;
+    semester->index_size++;
 }
 
+//takes the latest time of a course out of the index
+static void indexRemoveLatest(SemesterGrades semester, int course_id){
+    int place = indexEnd(semester,course_id) - 1;
+    memmove(semester->index + place, semester->index + place + 1,
+            sizeof(GradeNode)*(semester->index_size - place - 1));
+    semester->index_size--;
+}
 
 /**
- * compareCourseGrade
- * a cmopare function for worst and best grades function - creating a fictive semester with
- * all the clean courses and sorting it as required
+ * addNode: chains a course grade at the end of the semester and indexes it.
+ * the semester owns the course grade from now on.
+ * @return
+ * SEMESTER_GRADES_SUCCESS - course grade added
+ * SEMESTER_GRADES_OUT_OF_MEMORY - memory problem occurred, the course grade wasn't taken
  */
+static SemesterGradesResult addNode(SemesterGrades semester, CourseGrade grade){
+    if(indexReserve(semester) != SEMESTER_GRADES_SUCCESS){
+        return SEMESTER_GRADES_OUT_OF_MEMORY;
+    }
+    GradeNode node = gradeArenaAlloc(semester->arena,sizeof(struct GradeNode_t));
+    if(node == NULL){
+        return SEMESTER_GRADES_OUT_OF_MEMORY;
+    }
+    node->grade = grade;
+    node->previous = semester->last;
+    node->next = NULL;
+    if(semester->last != NULL){
+        semester->last->next = node;
+    } else {
+        semester->first = node;
+    }
+    semester->last = node;
+    indexInsert(semester,node);
+    return SEMESTER_GRADES_SUCCESS;
+}
 
-static int compareCourseGrade(ListElement element1, ListElement element2, ListSortKey key){
-    assert(element1 != NULL || element2 != NULL);
-    //check points distance for courses
-    int distance = courseGradeReturnCourseGrade(element1) -
-                   courseGradeReturnCourseGrade(element2);
-    distance = (distance*(*(int *)key));
-    //if points are equal, check semester
-    if(distance == 0) {
-        distance = courseGradeGetHelper(element1) - courseGradeGetHelper(element2);
+//takes a node out of the chain (not out of the index) and de-allocates it with its grade
+static void removeNode(SemesterGrades semester, GradeNode node){
+    if(node->previous != NULL){
+        node->previous->next = node->next;
+    } else {
+        semester->first = node->next;
+    }
+    if(node->next != NULL){
+        node->next->previous = node->previous;
+    } else {
+        semester->last = node->previous;
     }
-    //if semesters are equal, check id
-    if(distance == 0){
-        distance = courseGradeReturnCourseid(element1) - courseGradeReturnCourseid(element2);
+    courseGradeDestroy(node->grade);
+    gradeArenaFree(semester->arena,node,sizeof(struct GradeNode_t));
+}
+
+//adds (sign 1) or takes out (sign -1) a grade from the total and failed points
+static void countGrade(SemesterGrades semester, CourseGrade grade, int sign){
+    int points = courseGradeReturnCourseHalfPoints(grade);
+    semester->total_points += sign*points;
+    if(courseGradeReturnCourseGrade(grade) < 55){
+        semester->failed_points += sign*points;
     }
-    return distance;
 }
 
+//adds (sign 1) or takes out (sign -1) the effective grade of a course
+static void countEffective(SemesterGrades semester, CourseGrade latest, int sign){
+    if(latest == NULL){
+        return;
+    }
+    int points = courseGradeReturnCourseHalfPoints(latest);
+    semester->effective_points += sign*points;
+    semester->effective_grade_sum += sign*points*courseGradeReturnCourseGrade(latest);
+}
+
+
 /**
  * semesterGradesCreate: Allocates a new empty SemesterGrades.
- *
+ * the semester and its course grades are allocated from arena (NULL for the heap)
  * @return
  * SEMESTER_GRADES_SUCCESS - new grade sheet created
  * SEMESTER_GRADES_OUT_OF_MEMORY - memory problem occurred
  */
-SemesterGradesResult semesterGradesCreate(int semester, SemesterGrades *semesterGrades){
+SemesterGradesResult semesterGradesCreate(int semester, GradeArena arena,
+                                          SemesterGrades *semesterGrades){
     if(semester < 0){
         return SEMESTER_GRADES_INVALID_PARAMETERS;
     }
-    *semesterGrades = malloc(sizeof(struct SemesterGrades_t));
+    *semesterGrades = gradeArenaAlloc(arena,sizeof(struct SemesterGrades_t));
     if((*semesterGrades) == NULL){
         return SEMESTER_GRADES_OUT_OF_MEMORY;
     }
-    (*semesterGrades)->courseGrades = listCreate(copyCourseGrade,freeCourseGrade);
-    if((*semesterGrades)->courseGrades == NULL){
-        return SEMESTER_GRADES_OUT_OF_MEMORY;
-    }
     (*semesterGrades)->semester = semester;
+    (*semesterGrades)->first = NULL;
+    (*semesterGrades)->last = NULL;
+    (*semesterGrades)->arena = arena;
+    (*semesterGrades)->index = NULL;
+    (*semesterGrades)->index_size = 0;
+    (*semesterGrades)->index_capacity = 0;
+    (*semesterGrades)->total_points = 0;
+    (*semesterGrades)->failed_points = 0;
+    (*semesterGrades)->effective_points = 0;
+    (*semesterGrades)->effective_grade_sum = 0;
     return SEMESTER_GRADES_SUCCESS;
 }
 
 /**
- * semesterGradesCopy: copies a semester.
+ * semesterGradesCopy: copies a semester into arena (NULL for the heap).
  * @return
  * SemesterGrades - if succeed
  * NULL - otherwise
  */
-SemesterGrades semesterGradesCopy(SemesterGrades semesterGrade){
+SemesterGrades semesterGradesCopy(SemesterGrades semesterGrade, GradeArena arena){
     if(semesterGrade == NULL){
         return NULL;
     }
     SemesterGrades new_semester;
-    semesterGradesCreate(semesterGrade->semester,&new_semester);
-    listDestroy(new_semester->courseGrades);
-    new_semester->courseGrades = listCopy(semesterGrade->courseGrades);
+    if(semesterGradesCreate(semesterGrade->semester,arena,
+                            &new_semester) != SEMESTER_GRADES_SUCCESS){
+        return NULL;
+    }
+    for(GradeNode node = semesterGrade->first; node != NULL; node = node->next){
+        CourseGrade new = courseGradeCopy(node->grade,arena);
+        if(new == NULL || addNode(new_semester,new) != SEMESTER_GRADES_SUCCESS){
+            if(new != NULL){
+                courseGradeDestroy(new);
+            }
+            semesterGradesDestroy(new_semester);
+            return NULL;
+        }
+    }
+    new_semester->total_points = semesterGrade->total_points;
+    new_semester->failed_points = semesterGrade->failed_points;
+    new_semester->effective_points = semesterGrade->effective_points;
+    new_semester->effective_grade_sum = semesterGrade->effective_grade_sum;
     return new_semester;
 }
 
 //this function returns pints but as a string and not int
 char* CHpointsLastCourseInSemester(SemesterGrades semester,int course_id){
-    CourseGrade latest = NULL;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if (courseGradeReturnCourseid(iterator)==course_id){
-            latest = iterator;
-        }
-    }
+    CourseGrade latest = findLatest(semester,course_id);
     if (latest==NULL) {//course didn't appear in semester at all
         return NULL;
     }
     return courseGradeReturnCoursePoints(latest);
 }
 
-/*
- * semesterGradesInsertHelper: prints a specific course in a semester
- * @param semeter, helper
- * @return
- * SEMESTER_GRADES_SUCCESS - helper inserted
- * SEMESTER_GRADES_INVALID_PARAMETERS - parameters aren't valid
- */
-
-SemesterGradesResult semesterGradesInsertHelper(SemesterGrades semester, int helper){
-    if(semester==NULL){
-        return  SEMESTER_GRADES_INVALID_PARAMETERS;
-    }
-    CourseGrade latest= NULL;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades) {
-        latest = iterator;
-    }
-    courseGradeInsertHelper(latest,helper);
-    return SEMESTER_GRADES_SUCCESS;
-}
-//check function for insert helper
-void semesterGradesPrintHelper(SemesterGrades semester){
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        printf("%d,",courseGradeGetHelper(iterator));
-    }
-}
-
-
 /**
  * semesterGradesGetSemester: returns the semester of the semester.
  *
@@ -174,17 +277,70 @@ int semesterGradesGetSemester(SemesterGrades semesterGrade){
  */
 SemesterGradesResult semesterGradesAddGrade(SemesterGrades semester, int course_id, char* points, int grade){
     CourseGrade new;
-    if(courseGradeCreate(course_id,points,grade,&new) != COURSE_GRADE_SUCCESS || semester == NULL){
+    if(semester == NULL ||
+       courseGradeCreate(course_id,points,grade,semester->arena,&new) != COURSE_GRADE_SUCCESS){
         return SEMESTER_GRADES_INVALID_PARAMETERS;
     }
     if(new == NULL){
         return SEMESTER_GRADES_OUT_OF_MEMORY;
     }
-    listInsertLast(semester->courseGrades,new);
-    courseGradeDestroy(new);
+    CourseGrade previous = findLatest(semester,course_id);
+    if(addNode(semester,new) != SEMESTER_GRADES_SUCCESS){
+        courseGradeDestroy(new);
+        return SEMESTER_GRADES_OUT_OF_MEMORY;
+    }
+    //the new grade replaces the previous one as the effective grade of the course
+    countGrade(semester,new,1);
+    countEffective(semester,previous,-1);
+    countEffective(semester,new,1);
     return SEMESTER_GRADES_SUCCESS;
 }
 
+/**
+ * semesterGradesGetLatestGrade: returns the last time a course was done in the semester
+ * @param semester
+ * @param course_id
+ * @return
+ * NULL - the semester doesn't hold the course
+ * the course grade - otherwise
+ */
+CourseGrade semesterGradesGetLatestGrade(SemesterGrades semester, int course_id){
+    if(semester == NULL){
+        return NULL;
+    }
+    return findLatest(semester,course_id);
+}
+
+/**
+ * semesterGradesGetFirstGrade: returns the first course grade of the semester.
+ * the place is kept by the caller, so the semester isn't changed by going over it.
+ * @param semester
+ * @param place - set to the place of the course grade returned
+ * @return
+ * NULL - the semester is empty
+ * the first course grade - otherwise
+ */
+CourseGrade semesterGradesGetFirstGrade(SemesterGrades semester, SemesterGradesPlace* place){
+    *place = semester == NULL ? NULL : semester->first;
+    return *place == NULL ? NULL : (*place)->grade;
+}
+
+/**
+ * semesterGradesGetNextGrade: returns the course grade after the place, and moves the place to it
+ * @param semester
+ * @param place - the place of the last course grade returned
+ * @return
+ * NULL - there are no more course grades
+ * the next course grade - otherwise
+ */
+CourseGrade semesterGradesGetNextGrade(SemesterGrades semester, SemesterGradesPlace* place){
+    if(semester == NULL || *place == NULL){
+        return NULL;
+    }
+    *place = (*place)->next;
+    return *place == NULL ? NULL : (*place)->grade;
+}
+
 /**
  * semesterGradesIsEmpty: check if semester is empty.
  *
@@ -194,7 +350,7 @@ int semesterGradesIsEmpty(SemesterGrades semesterGrade){
     if(semesterGrade==NULL){
         return 0;
     }
-    if (listGetSize(semesterGrade->courseGrades)==0){
+    if (semesterGrade->first == NULL){
         return 0;
     }
     return 1;
@@ -209,23 +365,16 @@ int semesterGradesIsEmpty(SemesterGrades semesterGrade){
  * SEMESTER_GRADES_COURSE_NOT_EXIST - the semester doesn't hold the course
  */
 SemesterGradesResult semesterGradesRemoveGrade(SemesterGrades semester, int course_id){
-    bool exists = false;
-    CourseGrade latest = listGetFirst(semester->courseGrades);
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if(courseGradeReturnCourseid(iterator) == course_id){
-            latest = iterator;
-            exists = true;
-        }
-    }
-    if(exists == false){
+    GradeNode latest = findLatestNode(semester,course_id);
+    if(latest == NULL){
         return SEMESTER_GRADES_COURSE_NOT_EXIST;
     }
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if(iterator == latest){
-            listRemoveCurrent(semester->courseGrades);
-            break;
-        }
-    }
+    countGrade(semester,latest->grade,-1);
+    countEffective(semester,latest->grade,-1);
+    indexRemoveLatest(semester,course_id);
+    removeNode(semester,latest);
+    //the time before (if there is one) is now the effective grade of the course
+    countEffective(semester,findLatest(semester,course_id),1);
     return SEMESTER_GRADES_SUCCESS;
 }
 
@@ -240,19 +389,18 @@ SemesterGradesResult semesterGradesRemoveGrade(SemesterGrades semester, int cour
  */
 
 SemesterGradesResult semesterGradesUpdateGrade(SemesterGrades semester,int course_id, int grade) {
-    CourseGrade latest = NULL;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades) {
-        if (courseGradeReturnCourseid(iterator) == course_id) {
-            latest = iterator;
-        }
-    }
+    CourseGrade latest = findLatest(semester,course_id);
     if(latest == NULL){
         return SEMESTER_GRADES_COURSE_NOT_EXIST;
     }
     if (grade < 0 || grade > 100) {
         return SEMESTER_GRADES_INVALID_PARAMETERS;
     }
+    countGrade(semester,latest,-1);
+    countEffective(semester,latest,-1);
     courseGradeUpdateGrade(latest, grade);
+    countGrade(semester,latest,1);
+    countEffective(semester,latest,1);
     return SEMESTER_GRADES_SUCCESS;
 }
 
@@ -266,12 +414,7 @@ SemesterGradesResult semesterGradesUpdateGrade(SemesterGrades semester,int cours
  */
 
 int DoesGradeExists(SemesterGrades semester,int course_id){
-    CourseGrade latest = NULL;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if (courseGradeReturnCourseid(iterator)==course_id){
-            latest = iterator;
-        }
-    }
+    CourseGrade latest = findLatest(semester,course_id);
     if (latest==NULL) {//course didn't appear in semester at all
         return -1;
     }
@@ -290,167 +433,44 @@ int DoesGradeExists(SemesterGrades semester,int course_id){
  */
 
 int gradeLastTimeOfCourseInSemester(SemesterGrades semester,int course_id){
-    CourseGrade latest = NULL;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if (courseGradeReturnCourseid(iterator)==course_id){
-            latest = iterator;
-        }
-    }
+    CourseGrade latest = findLatest(semester,course_id);
     if (latest==NULL) {//course didn't appear in semester at all
         return 0;
     }
     return courseGradeReturnCourseGrade(latest);
 }
 
-int convertStringToInt(char* string){
-    while(*string == '0'){
-        string++;
-    }
-    char *temp = string;//will iterate to get number of digits that's not 0
-    int counter = 1;
-    temp++;
-    while(*temp != '\0' && *temp != '.'){
-        counter*=10;
-        temp++;
-    }
-    double num = 0;
-    while(*string != '\0' && *string != '.'){
-        num+= (double)(*string - '0')*counter;
-        string++;
-        counter/=10;
-    }
-    if(*string!='\0'){
-        string++;
-        num+= (double)((*string)-'0')/10;
-    }
-    return (int)(num*2);
-}
-
 int pointsLastTimeOfCourseInSemester (SemesterGrades semester,int course_id){
-    CourseGrade latest = NULL;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if (courseGradeReturnCourseid(iterator)==course_id){
-            latest = iterator;
-        }
-    }
+    CourseGrade latest = findLatest(semester,course_id);
     if (latest==NULL) {//course didn't appear in semester at all
         return 0;
     }
-    return convertStringToInt(courseGradeReturnCoursePoints(latest));
+    return courseGradeReturnCourseHalfPoints(latest);
 }
 
 /**
- * functions for printing a semester:
- * convertStringToInt - converts a string into int.
+ * functions for printing a semester (all points are doubled):
  * findTotalPoints - finds the total points done in a semester.
  * findTotalFailedPoints - finds the points sum of all failed classes in the semester.
- * arrayToSumGrade - sums the elements of the grades array
  * findEffectivePoints - finds the sum of all effective points in the semester.
  * findEffectiveGradeSum - finds the sum of of the effective course grades, when
  *  each grade is multiplied by the number of course points.
+ * the sums are kept up to date by every change to the semester.
  */
 
- int findTotalPoints (SemesterGrades semester){
-    int sum=0;
-    LIST_FOREACH(CourseGrade, iterator, semester->courseGrades){
-        sum+=convertStringToInt(courseGradeReturnCoursePoints(iterator));
-    }
-    return sum;
+int findTotalPoints (SemesterGrades semester){
+    return semester->total_points;
 }
 int findTotalFailedPoints (SemesterGrades semester){
-    int sum=0;
-    int tempgrade=0;
-    LIST_FOREACH(CourseGrade, iterator, semester->courseGrades){
-        tempgrade= courseGradeReturnCourseGrade(iterator);
-        if(tempgrade < 55){
-            sum+=convertStringToInt(courseGradeReturnCoursePoints(iterator));
-        }
-    }
-    return sum;
-}
-
-int arrayToSumGrade (SemesterGrades semester, int* course_flags,int size, int sum_flag){
-    int i=0,sum=0;
-    CourseGrade latest;
-    while(i<size && *(course_flags+i)!=0) {// for each course that appeared in semester
-        latest = listGetFirst(semester->courseGrades);
-        LIST_FOREACH(CourseGrade, iterator, semester->courseGrades) {
-            int tempcourse = courseGradeReturnCourseid(iterator);
-            if (*(course_flags + i) == tempcourse) {
-                latest = iterator;
-            }
-        }
-        int temp_grade=1;
-        if (sum_flag==1){// sum flags sets use of function- for sum or points.
-            temp_grade = courseGradeReturnCourseGrade(latest);
-        }
-        sum+= temp_grade*
-               convertStringToInt(courseGradeReturnCoursePoints(latest));
-        i++;
-    }
-    return sum;
+    return semester->failed_points;
 }
 
 int findEffectivePoints (SemesterGrades semester){
-    int sum=0;
-    int size= listGetSize(semester->courseGrades);
-    int *course_flags= malloc(sizeof(int)*size);//flags for if course already appeared
-    if (course_flags==NULL){
-        return -1;
-    }
-    for (int i=0; i<size; i++) {
-        *(course_flags+i)=0;
-    }
-    int tempcourse, index = 0;
-    LIST_FOREACH(CourseGrade, iterator, semester->courseGrades){
-        bool appeard = false;
-        tempcourse=courseGradeReturnCourseid(iterator);
-        int i;
-        for (i=0; i<size; i++){
-            if (*(course_flags+i)==tempcourse){
-                appeard = true;
-                break;
-            }
-        }
-        if (appeard==false) {
-            *(course_flags + index) = tempcourse;
-            index++;
-        }
-    }//until here we find what courses already appeared;
-    sum = arrayToSumGrade(semester,course_flags,size,0);
-    free(course_flags);
-    return sum;
+    return semester->effective_points;
 }
 
 int findEffectiveGradeSum (SemesterGrades semester){
-    int sum=0;
-    int size= listGetSize(semester->courseGrades);
-    int *course_flags= malloc(sizeof(int)*size);//flags for if course already appeared
-    if (course_flags==NULL){
-        return -1;
-    }
-    for (int i=0; i<size; i++) {
-        *(course_flags+i)=0;
-    }
-    int tempcourse, index = 0;
-    LIST_FOREACH(CourseGrade, iterator, semester->courseGrades){
-        bool appeard = false;
-        tempcourse=courseGradeReturnCourseid(iterator);
-        int i;
-        for (i=0; i<size; i++){
-            if (*(course_flags+i)==tempcourse){
-                appeard = true;
-                break;
-            }
-        }
-        if (appeard==false) {
-            *(course_flags + index) = tempcourse;
-            index++;
-        }
-    }//until here we find what courses already appeared;
-    sum =  arrayToSumGrade(semester,course_flags,size,1);
-    free(course_flags);
-    return sum;
+    return semester->effective_grade_sum;
 }
 
 /**
@@ -464,10 +484,10 @@ void semesterGradesPrintSemester(SemesterGrades semester,FILE* file) {
     failed_points = findTotalFailedPoints(semester);
     effective_points = findEffectivePoints(semester);
     effective_point_sum = findEffectiveGradeSum(semester);
-    LIST_FOREACH(CourseGrade, iterator, semester->courseGrades) {
-        mtmPrintGradeInfo(file,courseGradeReturnCourseid(iterator),
-                          convertStringToInt(courseGradeReturnCoursePoints(iterator)),
-                          courseGradeReturnCourseGrade(iterator));
+    for(GradeNode node = semester->first; node != NULL; node = node->next) {
+        mtmPrintGradeInfo(file,courseGradeReturnCourseid(node->grade),
+                          courseGradeReturnCourseHalfPoints(node->grade),
+                          courseGradeReturnCourseGrade(node->grade));
     }
     mtmPrintSemesterInfo(file,semester->semester,total_points,failed_points,
                          effective_points,effective_point_sum);
@@ -479,51 +499,15 @@ void semesterGradesPrintSemester(SemesterGrades semester,FILE* file) {
  * @return
  */
 void semesterGradesPrintCourseInSemester(SemesterGrades semester,FILE* file, int course_id){
-    CourseGrade latest = NULL;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if (courseGradeReturnCourseid(iterator)==course_id){
-            latest = iterator;
-        }
-    }
+    CourseGrade latest = findLatest(semester,course_id);
     if(latest == NULL){
         return;
     }
     mtmPrintGradeInfo(file, courseGradeReturnCourseid(latest),
-                      convertStringToInt(courseGradeReturnCoursePoints(latest)),
+                      courseGradeReturnCourseHalfPoints(latest),
                       courseGradeReturnCourseGrade(latest));
 }
 
-/**
- * semesterGradesSortByHelper: sorting courses as required for best/worst lists of courses.
- * @return
- * SEMESTER_GRADES_SUCCESS - list sorted
- */
-SemesterGradesResult semesterGradesSortByHelper(SemesterGrades semesterGrade, ListSortKey key){
-    if(semesterGrade == NULL){
-        return SEMESTER_GRADES_INVALID_PARAMETERS;
-    }
-    listSort(semesterGrade->courseGrades,compareCourseGrade,key);
-    return SEMESTER_GRADES_SUCCESS;
-}
-
-
-/**
- * semesterGradesPrintAmount: prints amount of courses from semster
- * @param semester
- * @param amount - amount of courses to print
- * @return
- */
-void semesterGradesPrintAmount(SemesterGrades semester,FILE* file,int amount){
-    int i = 1;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades) {
-        if (i<=amount){
-            courseGradePrintCourseGrade(iterator,file);
-            i++;
-        }else {
-            break;
-        }
-    }
-}
 /**
  * bestGradeOfCourseInSemester- return the best grade the student
  * got in this course in the semester
@@ -536,12 +520,12 @@ void semesterGradesPrintAmount(SemesterGrades semester,FILE* file,int amount){
 int bestGradeOfCourseInSemester(SemesterGrades semester,int course_id){
     int grade=-1;
     int tempgrade;
-    LIST_FOREACH(CourseGrade,iterator,semester->courseGrades){
-        if (courseGradeReturnCourseid(iterator)==course_id) {
-            tempgrade = courseGradeReturnCourseGrade(iterator);
-            if (tempgrade > grade) {
-                grade = tempgrade;
-            }
+    //the times the course was done are together at the end of its place in the index
+    for(int i = indexEnd(semester,course_id) - 1;
+        i >= 0 && courseGradeReturnCourseid(semester->index[i]->grade) == course_id; i--){
+        tempgrade = courseGradeReturnCourseGrade(semester->index[i]->grade);
+        if (tempgrade > grade) {
+            grade = tempgrade;
         }
     }
     return grade;
@@ -554,7 +538,11 @@ int bestGradeOfCourseInSemester(SemesterGrades semester,int course_id){
  */
 void semesterGradesDestroy(SemesterGrades semesterGrade){
     if(semesterGrade!=NULL){
-        listDestroy(semesterGrade->courseGrades);
+        while(semesterGrade->first != NULL){
+            removeNode(semesterGrade,semesterGrade->first);
+        }
+        gradeArenaFree(semesterGrade->arena,semesterGrade->index,
+                       sizeof(GradeNode)*semesterGrade->index_capacity);
+        gradeArenaFree(semesterGrade->arena,semesterGrade,sizeof(struct SemesterGrades_t));
     }
-    free(semesterGrade);
 }
@@ -2,7 +2,8 @@
 #ifndef SEMESTERGRADES_H
 #define SEMESTERGRADES_H
 
-#include "list.h"
+#include "GradeArena.h"
+#include "CourseGrades.h"
 /**
  * SemesterGrades structure
  *
@@ -21,6 +22,9 @@
 /** Type for defining the student */
 typedef struct SemesterGrades_t *SemesterGrades;
 
+/** Type for a place in the course grades of a semester, kept by whoever goes over them */
+typedef struct GradeNode_t *SemesterGradesPlace;
+
 /** Type used for returning error codes from student functions */
 typedef enum SemesterGradesResult_t {
     SEMESTER_GRADES_OUT_OF_MEMORY,
@@ -31,33 +35,25 @@ typedef enum SemesterGradesResult_t {
 
 /**
  * semesterGradesCreate: Allocates a new empty SemesterGrades.
- *
+ * the semester and its course grades are allocated from arena (NULL for the heap)
  * @return
  * SEMESTER_GRADES_SUCCESS - new grade sheet created
  * SEMESTER_GRADES_OUT_OF_MEMORY - memory problem occurred
  */
-SemesterGradesResult semesterGradesCreate(int semester, SemesterGrades *semesterGrade);
+SemesterGradesResult semesterGradesCreate(int semester, GradeArena arena,
+                                          SemesterGrades *semesterGrade);
 
 /**
- * semesterGradesCopy: copies a semester.
+ * semesterGradesCopy: copies a semester into arena (NULL for the heap).
  * @return
  * SemesterGrades - if succeed
  * NULL - otherwise
  */
-SemesterGrades semesterGradesCopy(SemesterGrades semesterGrade);
+SemesterGrades semesterGradesCopy(SemesterGrades semesterGrade, GradeArena arena);
 
 //this function returns pints but as a string and not int
 char* CHpointsLastCourseInSemester(SemesterGrades semester,int course_id);
 
-/**
- * semesterGradesInsertHelper: prints a specific course in a semester
- * @param semeter, helper
- * @return
- * SEMESTER_GRADES_SUCCESS - helper inserted
- * SEMESTER_GRADES_INVALID_PARAMETERS - parameters aren't valid
- */
-SemesterGradesResult semesterGradesInsertHelper(SemesterGrades semester, int helper);
-
 
 /**
  * semesterGradesGetSemester: returns the semester of the semester.
@@ -106,6 +102,38 @@ SemesterGradesResult semesterGradesUpdateGrade(SemesterGrades semester, int cour
  */
 void semesterGradesPrintSemester(SemesterGrades semester,FILE* file);
 
+/**
+ * semesterGradesGetLatestGrade: returns the last time a course was done in the semester
+ * @param semester
+ * @param course_id
+ * @return
+ * NULL - the semester doesn't hold the course
+ * the course grade - otherwise
+ */
+CourseGrade semesterGradesGetLatestGrade(SemesterGrades semester, int course_id);
+
+/**
+ * semesterGradesGetFirstGrade: returns the first course grade of the semester,
+ * in the order they were added. the place is kept by the caller, so going over
+ * the semester doesn't change it, and readers may go over it at once.
+ * @param semester
+ * @param place - set to the place of the course grade returned
+ * @return
+ * NULL - the semester is empty
+ * the first course grade - otherwise
+ */
+CourseGrade semesterGradesGetFirstGrade(SemesterGrades semester, SemesterGradesPlace* place);
+
+/**
+ * semesterGradesGetNextGrade: returns the course grade after the place, and moves the place to it
+ * @param semester
+ * @param place - the place of the last course grade returned
+ * @return
+ * NULL - there are no more course grades
+ * the next course grade - otherwise
+ */
+CourseGrade semesterGradesGetNextGrade(SemesterGrades semester, SemesterGradesPlace* place);
+
 /**
  * semesterGradesIsEmpty: check if semester is empty.
  *
@@ -121,17 +149,14 @@ int semesterGradesIsEmpty(SemesterGrades semesterGrade);
 void semesterGradesPrintCourseInSemester(SemesterGrades semester,FILE* file, int course_id);
 
 /**
- * functions for printing a stmester:
- * convertStringToInt - converts a string into int.
+ * functions for printing a stmester (all points are doubled):
  * findTotalPoints - finds the total points done in a semester.
  * findTotalFailedPoints - finds the points sum of all failed classes in the semester.
  * findEffectivePoints - finds the sum of all effective points in the semester.
  * findEffectiveGradeSum - finds the sum of of the effective course grades, when
  * each grade is multiplied by the number of course points.
- * arrayToSumGrade - sums the elements of the grades array
+ * the sums are kept up to date by every change to the semester, so these are O(1).
  */
-int convertStringToInt(char* string);
-
 int findTotalPoints (SemesterGrades semester);
 
 int findTotalFailedPoints (SemesterGrades semester);
@@ -140,7 +165,6 @@ int findEffectivePoints (SemesterGrades semester);
 
 int findEffectiveGradeSum (SemesterGrades semester);
 
-int arrayToSumGrade (SemesterGrades semester, int* course_flags,int size, int sum_flag);
 /**
  * the next 2 functions extract the points or grade
  * of the lest time that a course appeard in a semester
@@ -167,23 +191,6 @@ int pointsLastTimeOfCourseInSemester (SemesterGrades semester,int course_id);
 
 int DoesGradeExists(SemesterGrades semester,int course_id);
 
-void semesterGradesPrintHelper(SemesterGrades semester);
-
-/**
- * semesterGradesSortByHelper: sorting courses as required for best/worst lists of courses.
- * @return
- * SEMESTER_GRADES_SUCCESS - list sorted
- */
-SemesterGradesResult semesterGradesSortByHelper(SemesterGrades semesterGrade, ListSortKey key);
-
-/**
- * semesterGradesPrintAmount: prints amount of courses from semster
- * @param semester
- * @param amount - amount of courses to print
- * @return
- */
-void semesterGradesPrintAmount(SemesterGrades semester,FILE* file,int amount);
-
 /**
  * bestGradeOfCourseInSemester- return the best grade the student
  * got in this course in the semester
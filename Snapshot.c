@@ -0,0 +1,269 @@
+#define _POSIX_C_SOURCE 200112L//for fileno and fsync
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "Snapshot.h"
+
+/**
+ * Snapshot structure
+ *
+ * data - the bytes of the snapshot: written so far for a created snapshot,
+ *        or the whole file for a loaded one.
+ * place - the next byte to read of a loaded snapshot
+ */
+
+#define SNAPSHOT_MAGIC "MTMS"
+#define HEADER_SIZE 8//magic, version
+#define INITIAL_CAPACITY 4096
+
+/**
+ * definition of Snapshot struct
+ */
+struct Snapshot_t{
+    char* path;//of a created snapshot
+    bool failed;//a write to a created snapshot failed
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+    size_t place;
+};
+
+static void writeNumber(unsigned char* bytes, uint32_t number){
+    for(int i = 0; i < 4; i++){
+        bytes[i] = (unsigned char)(number >> (8*i));
+    }
+}
+
+static uint32_t readNumber(const unsigned char* bytes){
+    uint32_t number = 0;
+    for(int i = 0; i < 4; i++){
+        number |= (uint32_t)bytes[i] << (8*i);
+    }
+    return number;
+}
+
+static Snapshot snapshotCreateEmpty(void){
+    Snapshot snapshot = malloc(sizeof(struct Snapshot_t));
+    if(snapshot == NULL){
+        return NULL;
+    }
+    snapshot->path = NULL;
+    snapshot->failed = false;
+    snapshot->data = NULL;
+    snapshot->size = 0;
+    snapshot->capacity = 0;
+    snapshot->place = 0;
+    return snapshot;
+}
+
+static void snapshotFree(Snapshot snapshot){
+    free(snapshot->path);
+    free(snapshot->data);
+    free(snapshot);
+}
+
+//makes room for size more bytes at the end of a created snapshot
+static bool reserve(Snapshot snapshot, size_t size){
+    if(snapshot->failed){
+        return false;
+    }
+    if(snapshot->capacity - snapshot->size >= size){
+        return true;
+    }
+    size_t capacity = snapshot->capacity == 0 ? INITIAL_CAPACITY : snapshot->capacity;
+    while(capacity - snapshot->size < size){
+        capacity *= 2;
+    }
+    unsigned char* data = realloc(snapshot->data,capacity);
+    if(data == NULL){
+        snapshot->failed = true;
+        return false;
+    }
+    snapshot->data = data;
+    snapshot->capacity = capacity;
+    return true;
+}
+
+/**
+ * snapshotCreate: Creates a new empty snapshot to write to.
+ * @return
+ * SNAPSHOT_SUCCESS - snapshot created
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult snapshotCreate(const char* path, Snapshot *snapshot){
+    *snapshot = snapshotCreateEmpty();
+    if(*snapshot == NULL){
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    (*snapshot)->path = malloc(strlen(path) + 1);
+    if((*snapshot)->path == NULL || !reserve(*snapshot,HEADER_SIZE)){
+        snapshotFree(*snapshot);
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    strcpy((*snapshot)->path,path);
+    memcpy((*snapshot)->data,SNAPSHOT_MAGIC,4);
+    writeNumber((*snapshot)->data + 4,SNAPSHOT_VERSION);
+    (*snapshot)->size = HEADER_SIZE;
+    return SNAPSHOT_SUCCESS;
+}
+
+void snapshotWriteNumber(Snapshot snapshot, int number){
+    if(!reserve(snapshot,4)){
+        return;
+    }
+    writeNumber(snapshot->data + snapshot->size,(uint32_t)number);
+    snapshot->size += 4;
+}
+
+void snapshotWriteString(Snapshot snapshot, const char* string){
+    size_t length = strlen(string);
+    if(!reserve(snapshot,4 + length + 1)){
+        return;
+    }
+    writeNumber(snapshot->data + snapshot->size,(uint32_t)length);
+    memcpy(snapshot->data + snapshot->size + 4,string,length + 1);
+    snapshot->size += 4 + length + 1;
+}
+
+/**
+ * snapshotClose: writes a created snapshot to a temporary file next to its file,
+ * and moves it over the file once it's all written and flushed to the disk.
+ * @return
+ * SNAPSHOT_SUCCESS - snapshot written
+ * SNAPSHOT_CANNOT_OPEN_FILE - writing to the file failed
+ * SNAPSHOT_OUT_OF_MEMORY - a write to the snapshot failed for lack of memory
+ */
+SnapshotResult snapshotClose(Snapshot snapshot){
+    if(snapshot->failed){
+        snapshotFree(snapshot);
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    char* temporary = malloc(strlen(snapshot->path) + sizeof(".tmp"));
+    if(temporary == NULL){
+        snapshotFree(snapshot);
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    strcpy(temporary,snapshot->path);
+    strcat(temporary,".tmp");
+    FILE* file = fopen(temporary,"wb");
+    bool written = file != NULL &&
+                   fwrite(snapshot->data,1,snapshot->size,file) == snapshot->size &&
+                   fflush(file) == 0 && fsync(fileno(file)) == 0;
+    if(file != NULL){
+        written = (fclose(file) == 0) && written;
+    }
+    written = written && rename(temporary,snapshot->path) == 0;
+    if(!written){
+        remove(temporary);
+    }
+    free(temporary);
+    snapshotFree(snapshot);
+    return written ? SNAPSHOT_SUCCESS : SNAPSHOT_CANNOT_OPEN_FILE;
+}
+
+//reads the whole file into the snapshot
+static SnapshotResult readFile(const char* path, Snapshot snapshot){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return SNAPSHOT_CANNOT_OPEN_FILE;
+    }
+    size_t read = 0;
+    do{
+        snapshot->size += read;
+        if(snapshot->size == snapshot->capacity){
+            size_t capacity = snapshot->capacity == 0 ? INITIAL_CAPACITY :
+                              snapshot->capacity*2;
+            unsigned char* data = realloc(snapshot->data,capacity);
+            if(data == NULL){
+                fclose(file);
+                return SNAPSHOT_OUT_OF_MEMORY;
+            }
+            snapshot->data = data;
+            snapshot->capacity = capacity;
+        }
+    } while((read = fread(snapshot->data + snapshot->size,1,
+                          snapshot->capacity - snapshot->size,file)) > 0);
+    bool failed = ferror(file);
+    fclose(file);
+    return failed ? SNAPSHOT_CANNOT_OPEN_FILE : SNAPSHOT_SUCCESS;
+}
+
+/**
+ * snapshotLoad: loads a snapshot file to read from.
+ * @return
+ * SNAPSHOT_SUCCESS - snapshot loaded
+ * SNAPSHOT_CANNOT_OPEN_FILE - the file can't be read
+ * SNAPSHOT_BAD_FORMAT - the file isn't a snapshot of this version
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult snapshotLoad(const char* path, Snapshot *snapshot){
+    *snapshot = snapshotCreateEmpty();
+    if(*snapshot == NULL){
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    SnapshotResult result = readFile(path,*snapshot);
+    if(result != SNAPSHOT_SUCCESS){
+        snapshotFree(*snapshot);
+        return result;
+    }
+    if((*snapshot)->size < HEADER_SIZE || memcmp((*snapshot)->data,SNAPSHOT_MAGIC,4) != 0 ||
+       readNumber((*snapshot)->data + 4) != SNAPSHOT_VERSION){
+        snapshotFree(*snapshot);
+        return SNAPSHOT_BAD_FORMAT;
+    }
+    (*snapshot)->place = HEADER_SIZE;
+    return SNAPSHOT_SUCCESS;
+}
+
+bool snapshotReadNumber(Snapshot snapshot, int* number){
+    if(snapshot->size - snapshot->place < 4){
+        return false;
+    }
+    *number = (int)readNumber(snapshot->data + snapshot->place);
+    snapshot->place += 4;
+    return true;
+}
+
+/**
+ * snapshotReadString: reads the next string of a loaded snapshot.
+ * the strings are terminated in the file, so they are used where they are.
+ * @return
+ * NULL - the snapshot ended, or the next string is damaged
+ * the string - otherwise
+ */
+const char* snapshotReadString(Snapshot snapshot){
+    if(snapshot->size - snapshot->place < 4){
+        return NULL;
+    }
+    uint32_t length = readNumber(snapshot->data + snapshot->place);
+    size_t start = snapshot->place + 4;
+    if(snapshot->size - start <= length || snapshot->data[start + length] != '\0' ||
+       memchr(snapshot->data + start,'\0',length) != NULL){
+        return NULL;
+    }
+    snapshot->place = start + length + 1;
+    return (const char*)(snapshot->data + start);
+}
+
+size_t snapshotGetRemaining(Snapshot snapshot){
+    return snapshot->size - snapshot->place;
+}
+
+bool snapshotIsAtEnd(Snapshot snapshot){
+    return snapshot->place == snapshot->size;
+}
+
+/**
+ * snapshotDestroy: De-allocates a loaded snapshot, or a created one that isn't written.
+ * @param snapshot
+ */
+void snapshotDestroy(Snapshot snapshot){
+    if(snapshot == NULL){
+        return;
+    }
+    snapshotFree(snapshot);
+}
@@ -0,0 +1,137 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+/**
+ * Snapshot structure
+ *
+ * Snapshot is a binary file holding the state of the course manager, so a run
+ * can start from it instead of replaying all the commands that led to it.
+ * The file starts with a magic and a version, followed by the numbers and the
+ * strings the modules wrote, in the order they wrote them. Numbers are 4 bytes
+ * little endian, and strings are their length followed by their characters and
+ * a terminating '\0'.
+ * A snapshot is written to memory and put in its file only when it's closed,
+ * and only once it's on the disk, so a failed save or a crash doesn't leave
+ * half a snapshot behind.
+
+ * The following functions are available:
+ * snapshotCreate:      Creates a new snapshot to write to
+ * snapshotWriteNumber: Writes a number to the end of the snapshot
+ * snapshotWriteString: Writes a string to the end of the snapshot
+ * snapshotClose:       Writes the snapshot to its file and de-allocates it
+ * snapshotLoad:        Loads a snapshot file to read from
+ * snapshotReadNumber:  Reads the next number of a loaded snapshot
+ * snapshotReadString:  Reads the next string of a loaded snapshot
+ * snapshotGetRemaining: Returns how many bytes of a loaded snapshot are left
+ * snapshotIsAtEnd:     Checks if a loaded snapshot was read to its end
+ * snapshotDestroy:    De-allocates a loaded snapshot, or a created one that isn't written
+ */
+
+#define SNAPSHOT_VERSION 3
+
+/** Type for defining the snapshot */
+typedef struct Snapshot_t *Snapshot;
+
+/** Type used for returning error codes from snapshot functions */
+typedef enum SnapshotResult_t {
+    SNAPSHOT_OUT_OF_MEMORY,
+    SNAPSHOT_CANNOT_OPEN_FILE,
+    SNAPSHOT_BAD_FORMAT,
+    SNAPSHOT_SUCCESS
+} SnapshotResult;
+
+/**
+ * snapshotCreate: Creates a new empty snapshot to write to.
+ * @param path - the file the snapshot is written to when it's closed
+ * @param snapshot - pointer to the snapshot created
+ * @return
+ * SNAPSHOT_SUCCESS - snapshot created
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult snapshotCreate(const char* path, Snapshot *snapshot);
+
+/**
+ * snapshotWriteNumber: writes a number to the end of a created snapshot.
+ * a failed write is remembered and reported by snapshotClose.
+ * @param snapshot
+ * @param number
+ */
+void snapshotWriteNumber(Snapshot snapshot, int number);
+
+/**
+ * snapshotWriteString: writes a string to the end of a created snapshot.
+ * a failed write is remembered and reported by snapshotClose.
+ * @param snapshot
+ * @param string
+ */
+void snapshotWriteString(Snapshot snapshot, const char* string);
+
+/**
+ * snapshotClose: writes a created snapshot to its file (replacing the file
+ * only if the whole snapshot was written) and de-allocates it.
+ * @param snapshot
+ * @return
+ * SNAPSHOT_SUCCESS - snapshot written
+ * SNAPSHOT_CANNOT_OPEN_FILE - writing to the file failed
+ * SNAPSHOT_OUT_OF_MEMORY - a write to the snapshot failed for lack of memory
+ */
+SnapshotResult snapshotClose(Snapshot snapshot);
+
+/**
+ * snapshotLoad: loads a snapshot file to read from.
+ * @param path
+ * @param snapshot - pointer to the snapshot loaded
+ * @return
+ * SNAPSHOT_SUCCESS - snapshot loaded
+ * SNAPSHOT_CANNOT_OPEN_FILE - the file can't be read
+ * SNAPSHOT_BAD_FORMAT - the file isn't a snapshot of this version
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult snapshotLoad(const char* path, Snapshot *snapshot);
+
+/**
+ * snapshotReadNumber: reads the next number of a loaded snapshot.
+ * @param snapshot
+ * @param number - filled with the number read
+ * @return
+ * true - the number was read
+ * false - the snapshot ended
+ */
+bool snapshotReadNumber(Snapshot snapshot, int* number);
+
+/**
+ * snapshotReadString: reads the next string of a loaded snapshot.
+ * the string belongs to the snapshot.
+ * @param snapshot
+ * @return
+ * NULL - the snapshot ended, or the next string is damaged
+ * the string - otherwise
+ */
+const char* snapshotReadString(Snapshot snapshot);
+
+/**
+ * snapshotGetRemaining: returns how many bytes of a loaded snapshot weren't read yet,
+ * so a count read from the snapshot can be checked before it's allocated.
+ * @param snapshot
+ * @return the number of bytes left
+ */
+size_t snapshotGetRemaining(Snapshot snapshot);
+
+/**
+ * snapshotIsAtEnd: checks if everything in a loaded snapshot was read
+ * @param snapshot
+ * @return
+ * true if there's nothing left to read, false otherwise
+ */
+bool snapshotIsAtEnd(Snapshot snapshot);
+
+/**
+ * snapshotDestroy: De-allocates a loaded snapshot, or a created snapshot
+ * that won't be written to its file.
+ * @param snapshot
+ */
+void snapshotDestroy(Snapshot snapshot);
+
+#endif //SNAPSHOT_H
@@ -39,21 +39,29 @@ struct Student_t {
     char* first_name;
     char* last_name;
     GradeSheet gradeSheet;
-    List friendsList;
-    int helper;//for reference print in course manager
+    int* friends;//ids of the friends, sorted in ascending order
+    int friends_count;
+    int friends_capacity;
 };
 
-static ListElement friendsListCopy(ListElement element) {
-    if(element == NULL){
-        return NULL;
+/**
+ * findFriend: binary search for id in the sorted friends array
+ * @return
+ * the index of id in the array if it's there,
+ * otherwise the index where id should be inserted
+ */
+static int findFriend(Student student, int id, bool* found){
+    int low = 0, high = student->friends_count;
+    while(low < high){
+        int middle = low + (high - low) / 2;
+        if(student->friends[middle] < id){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
     }
-    int *new = malloc(sizeof(int));
-    *new = *(int *)element;
-    return new? new : NULL;
-}
-
-static void freeFriendsList(ListElement element) {
-    free(element);
+    *found = (low < student->friends_count && student->friends[low] == id);
+    return low;
 }
 /**
  * studentCreate: Allocates a new empty student.
@@ -80,17 +88,15 @@ StudentResult studentCreate(int id,char* first_name,char* last_name,Student *stu
     if((*student)->last_name == NULL){
         return STUDENT_OUT_OF_MEMORY;
     }
-    (*student)->friendsList = listCreate(friendsListCopy,freeFriendsList);
-    if((*student)->friendsList == NULL){
-        return STUDENT_OUT_OF_MEMORY;
-    }
+    (*student)->friends = NULL;
+    (*student)->friends_count = 0;
+    (*student)->friends_capacity = 0;
     if(gradeSheetCreate(&(*student)->gradeSheet)!=GRADE_SHEET_SUCCESS){
         return STUDENT_OUT_OF_MEMORY;
     }
     strcpy((*student)->last_name,last_name);
     strcpy((*student)->first_name,first_name);
     (*student)->student_id = id;
-    (*student)->helper = -1;
     return STUDENT_SUCCESS;
 }
 
@@ -100,8 +106,8 @@ StudentResult studentCreate(int id,char* first_name,char* last_name,Student *stu
  * @return
 */
 void studentPrintCheck(Student student){
-    LIST_FOREACH(int*,iterator,student->friendsList){
-        printf("%d\n",*iterator);
+    for(int i = 0; i < student->friends_count; i++){
+        printf("%d\n",student->friends[i]);
     }
 }
 
@@ -122,18 +128,24 @@ StudentResult studentAddFriend(Student student, int id){
     if(id<0 || id >1000000000){
         return STUDENT_INVALID_PARAMETERS;
     }
-    LIST_FOREACH(int*,iterator,student->friendsList) {
-        if(*iterator==id){
-            return  STUDENT_ALREADY_FRIENDS;
-        }
+    bool found;
+    int index = findFriend(student,id,&found);
+    if(found){
+        return  STUDENT_ALREADY_FRIENDS;
     }
-    int *temp = malloc(sizeof(int));
-    if(temp == NULL){
-        return STUDENT_INVALID_PARAMETERS;
+    if(student->friends_count == student->friends_capacity){
+        int capacity = student->friends_capacity == 0 ? 4 : student->friends_capacity*2;
+        int *temp = realloc(student->friends,sizeof(int)*capacity);
+        if(temp == NULL){
+            return STUDENT_OUT_OF_MEMORY;
+        }
+        student->friends = temp;
+        student->friends_capacity = capacity;
     }
-    *temp = id;
-    listInsertLast(student->friendsList,temp);
-    free(temp);
+    memmove(student->friends + index + 1,student->friends + index,
+            sizeof(int)*(student->friends_count - index));
+    student->friends[index] = id;
+    student->friends_count++;
     return STUDENT_SUCCESS;
 }
 
@@ -150,13 +162,15 @@ StudentResult studentRemoveFriend(Student student, int id) {
     if (student == NULL) {
         return STUDENT_INVALID_PARAMETERS;
     }
-    LIST_FOREACH(int*, iterator, student->friendsList) {
-        if (*iterator == id) {
-            listRemoveCurrent(student->friendsList);
-            return STUDENT_SUCCESS;
-        }
+    bool found;
+    int index = findFriend(student, id, &found);
+    if (!found) {
+        return STUDENT_NOT_FRIEND;
     }
-    return STUDENT_NOT_FRIEND;
+    memmove(student->friends + index, student->friends + index + 1,
+            sizeof(int)*(student->friends_count - index - 1));
+    student->friends_count--;
+    return STUDENT_SUCCESS;
 }
 /**
  * studentAddGrade: insert a grade to the students transcript (to the specific semester
@@ -295,12 +309,9 @@ int studentCheckIfFriends(Student student, int friend_id){
     if (student==NULL){
         return -1;
     }
-    LIST_FOREACH(int*,iterator,student->friendsList){
-        if (*iterator==friend_id){
-            return 1;
-        }
-    }
-    return 0;
+    bool found;
+    findFriend(student,friend_id,&found);
+    return found ? 1 : 0;
 }
 
  /**
@@ -319,32 +330,21 @@ Student studentCopy (Student student){
                      student->last_name,&new_student)!=STUDENT_SUCCESS){
         return NULL;
     }
-    listDestroy(new_student->friendsList);
+    if(student->friends_count > 0){
+        new_student->friends = malloc(sizeof(int)*student->friends_count);
+        if(new_student->friends == NULL){
+            studentDestroy(new_student);
+            return NULL;
+        }
+        memcpy(new_student->friends,student->friends,sizeof(int)*student->friends_count);
+        new_student->friends_count = student->friends_count;
+        new_student->friends_capacity = student->friends_count;
+    }
     gradeSheetDestroy(new_student->gradeSheet);
-    new_student->friendsList = listCopy(student->friendsList);
     new_student->gradeSheet = copyGradeSheet(student->gradeSheet);
-     new_student->helper =student->helper;
     return new_student;
 }
 
-/**
- * studentGetHelper- takes the helper from the student
- *
- * @return
- */
-int studentGetHelper(Student student){
-    return student->helper;
-}
-
-/**
- * studenInsertHelper- insersts  helper from the student
- *
- * @return
- */
-void studentInsertHelper(Student student, int helper1){
-    student->helper= helper1;
-}
-
 /**
  * studentGetBestGrade- takes the best grade of student in a course
  * @param- student, course_id
@@ -355,12 +355,13 @@ int studentGetBestGrade(Student student, int course_id){
 }
 
 /**
- * studentReturnFriends- returns the friends list of student
- * @param- student
- * @return list
+ * studentReturnFriends- returns the ids of the friends of student
+ * @param- student, friends_count - pointer for the number of friends
+ * @return array of ids, sorted in ascending order
  */
-List studentReturnFriends(Student student){
-    return student->friendsList;
+int* studentReturnFriends(Student student, int* friends_count){
+    *friends_count = student->friends_count;
+    return student->friends;
 }
 
 /**
@@ -385,6 +386,105 @@ int studentDoesGradeExists(Student student, int course_id){
     return 1;
 }
 
+/**
+ * studentDoesGradeExistsInSemester - checks if a grade of the course is in the
+ * semester of the student's sheet
+ * @param- student, semester, course_id
+ * @return
+ * 1 if the grade is there, 0 otherwise
+ */
+int studentDoesGradeExistsInSemester(Student student, int semester, int course_id){
+    assert(student!=NULL);
+    return gradeSheetDoesGradeExistsInSemester(student->gradeSheet,semester,course_id);
+}
+
+/**
+ * studentGetCourse: returns the id of the course in the given place of the
+ * courses the student took, sorted by id
+ * @return
+ * -1 - the place is out of range
+ * the course id - otherwise
+ */
+int studentGetCourse(Student student, int place){
+    assert(student != NULL);
+    return gradeSheetGetCourse(student->gradeSheet,place);
+}
+
+/**
+ * studentSave: writes the id, the names, the friends and the transcript of the student
+ */
+void studentSave(Student student, Snapshot snapshot){
+    snapshotWriteNumber(snapshot,student->student_id);
+    snapshotWriteString(snapshot,student->first_name);
+    snapshotWriteString(snapshot,student->last_name);
+    snapshotWriteNumber(snapshot,student->friends_count);
+    for(int i = 0; i < student->friends_count; i++){
+        snapshotWriteNumber(snapshot,student->friends[i]);
+    }
+    gradeSheetSave(student->gradeSheet,snapshot);
+}
+
+//reads the friends of a new student, they were saved sorted
+static SnapshotResult loadFriends(Snapshot snapshot, Student student){
+    int count;
+    //every friend takes 4 bytes, so a count the snapshot can't hold isn't allocated
+    if(!snapshotReadNumber(snapshot,&count) || count < 0 ||
+       (size_t)count > snapshotGetRemaining(snapshot)/4){
+        return SNAPSHOT_BAD_FORMAT;
+    }
+    if(count == 0){
+        return SNAPSHOT_SUCCESS;
+    }
+    student->friends = malloc(sizeof(int)*count);
+    if(student->friends == NULL){
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    student->friends_capacity = count;
+    for(int i = 0; i < count; i++){
+        int id;
+        if(!snapshotReadNumber(snapshot,&id) || id <= 0 || id == student->student_id ||
+           (i > 0 && id <= student->friends[i-1])){
+            return SNAPSHOT_BAD_FORMAT;
+        }
+        student->friends[i] = id;
+        student->friends_count++;
+    }
+    return SNAPSHOT_SUCCESS;
+}
+
+/**
+ * studentLoad: allocates a student written by studentSave.
+ * @return
+ * SNAPSHOT_SUCCESS - student read
+ * SNAPSHOT_BAD_FORMAT - the snapshot doesn't hold a valid student
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult studentLoad(Snapshot snapshot, Student *student){
+    int id;
+    const char* first_name;
+    const char* last_name;
+    *student = NULL;
+    if(!snapshotReadNumber(snapshot,&id) || id <= 0 || id >= 1000000000 ||
+       (first_name = snapshotReadString(snapshot)) == NULL ||
+       (last_name = snapshotReadString(snapshot)) == NULL){
+        return SNAPSHOT_BAD_FORMAT;
+    }
+    Student new;
+    if(studentCreate(id,(char*)first_name,(char*)last_name,&new) != STUDENT_SUCCESS){
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    SnapshotResult result = loadFriends(snapshot,new);
+    if(result == SNAPSHOT_SUCCESS){
+        result = gradeSheetLoad(new->gradeSheet,snapshot);
+    }
+    if(result != SNAPSHOT_SUCCESS){
+        studentDestroy(new);
+        return result;
+    }
+    *student = new;
+    return SNAPSHOT_SUCCESS;
+}
+
 /**
  * studentDestroy: De-allocates a student.
  *
@@ -394,7 +494,7 @@ void studentDestroy(Student student){
     free(student->last_name);
     free(student->first_name);
     gradeSheetDestroy(student->gradeSheet);
-    listDestroy(student->friendsList);
+    free(student->friends);
     free(student);
 }
 
@@ -2,6 +2,7 @@
 #ifndef STUDENT_H
 #define STUDENT_H
 #include "list.h"
+#include "Snapshot.h"
 /**
  * Student structure
  *
@@ -22,6 +23,8 @@
  * studentRemoveFriend:            Removes a friend from the students friend list
  * studentAddFriend:               Adds a friend to the students friend list
  * studentCreate:                  Allocates a new empty student.
+ * studentSave:                    Writes the student to a snapshot
+ * studentLoad:                    Allocates a student written by studentSave.
  */
 
 /** Type for defining the student */
@@ -175,20 +178,6 @@ int studentCheckIfFriends(Student student, int friend_id);
 
 Student studentCopy (Student student);
 
-/**
- * studentGetHelper- takes the helper from the student
- *
- * @return
- */
-int studentGetHelper(Student student);
-
-/**
- * studenInsertHelper- insersts  helper from the student
- *
- * @return
- */
-void studentInsertHelper(Student student, int helper1);
-
 /**
  * studentGetBestGrade- takes the best grade of student in a course
  * @param- student, course_id
@@ -197,11 +186,12 @@ void studentInsertHelper(Student student, int helper1);
 int studentGetBestGrade(Student student, int course_id);
 
 /**
- * studentReturnFriends- returns the friends list of student
- * @param- student
- * @return list
+ * studentReturnFriends- returns the ids of the friends of student
+ * the array belongs to the student and is valid until his friends change
+ * @param- student, friends_count - pointer for the number of friends
+ * @return array of ids, sorted in ascending order
  */
-List studentReturnFriends(Student student);
+int* studentReturnFriends(Student student, int* friends_count);
 
 /**
  * studentPrintStudentName: prints the student name only
@@ -217,6 +207,43 @@ void studentPrintStudentName(Student student,FILE* file);
  */
 int studentDoesGradeExists(Student student, int course_id);
 
+/**
+ * studentDoesGradeExistsInSemester - checks if a grade of the course is in the
+ * semester of the student's sheet (so studentRemoveGrade would remove it)
+ * @param- student, semester, course_id
+ * @return
+ * 1 if the grade is there, 0 otherwise
+ */
+int studentDoesGradeExistsInSemester(Student student, int semester, int course_id);
+
+/**
+ * studentGetCourse - returns a course the student took, by its place in the
+ * courses of the student (sorted by id). a course whose grades were all
+ * removed may still be there, with no best grade.
+ * @param- student, place
+ * @return
+ * -1 if the place is out of range, the course id otherwise
+ */
+int studentGetCourse(Student student, int place);
+
+/**
+ * studentSave: writes the student (id, names, friends and transcript) to a snapshot
+ * @param student
+ * @param snapshot
+ */
+void studentSave(Student student, Snapshot snapshot);
+
+/**
+ * studentLoad: allocates a student written by studentSave.
+ * @param snapshot
+ * @param student - pointer to the student read
+ * @return
+ * SNAPSHOT_SUCCESS - student read
+ * SNAPSHOT_BAD_FORMAT - the snapshot doesn't hold a valid student
+ * SNAPSHOT_OUT_OF_MEMORY - memory problem occurred
+ */
+SnapshotResult studentLoad(Snapshot snapshot, Student *student);
+
 /**
  * studentDestroy: De-allocates a student.
  *
@@ -0,0 +1,291 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdbool.h>
+#include "list.h"
+#include "Student.h"
+#include "StudentTable.h"
+
+/**
+ * StudentTable structure
+ *
+ * StudentTable holds all the students of the system, indexed by their id.
+ * students - the students in insertion order, removed students leave a NULL hole
+ * slots - open addressing hash table (linear probing) of indexes into students
+ */
+
+#define EMPTY_SLOT -1
+#define DELETED_SLOT -2
+#define INITIAL_SLOTS 16
+
+/**
+ * definition of StudentTable struct
+ */
+struct StudentTable_t{
+    Student* students;
+    int students_count;//used places in students, including holes
+    int students_capacity;
+    int size;//number of students in the table
+    int* slots;
+    int slots_capacity;//always a power of 2
+    int slots_used;//slots that are not empty, including deleted ones
+    int iterator;
+};
+
+static unsigned int hashId(int student_id, int slots_capacity){
+    unsigned int hash = (unsigned int)student_id * 2654435761u;
+    hash ^= hash >> 16;
+    return hash & (unsigned int)(slots_capacity - 1);
+}
+
+/**
+ * findSlot: returns the slot holding the student with the given id
+ * or -1 if the student is not in the table
+ */
+static int findSlot(StudentTable table, int student_id){
+    int slot = (int)hashId(student_id, table->slots_capacity);
+    while(table->slots[slot] != EMPTY_SLOT){
+        int index = table->slots[slot];
+        if(index != DELETED_SLOT &&
+           studentGetStudentId(table->students[index]) == student_id){
+            return slot;
+        }
+        slot = (slot + 1) & (table->slots_capacity - 1);
+    }
+    return -1;
+}
+
+static void placeIndex(int* slots, int slots_capacity, int student_id, int index){
+    int slot = (int)hashId(student_id, slots_capacity);
+    while(slots[slot] != EMPTY_SLOT){
+        slot = (slot + 1) & (slots_capacity - 1);
+    }
+    slots[slot] = index;
+}
+
+/**
+ * rebuildTable: closes the holes in the students array (keeping the order),
+ * and rehashes all the students into a slots array big enough for them
+ */
+static StudentTableResult rebuildTable(StudentTable table){
+    int slots_capacity = INITIAL_SLOTS;
+    while(slots_capacity < (table->size + 1) * 2){
+        slots_capacity *= 2;
+    }
+    int* slots = malloc(sizeof(int)*slots_capacity);
+    if(slots == NULL){
+        return STUDENT_TABLE_OUT_OF_MEMORY;
+    }
+    for(int i = 0; i < slots_capacity; i++){
+        slots[i] = EMPTY_SLOT;
+    }
+    int count = 0;
+    for(int i = 0; i < table->students_count; i++){
+        if(table->students[i] != NULL){
+            table->students[count] = table->students[i];
+            placeIndex(slots,slots_capacity,
+                       studentGetStudentId(table->students[count]),count);
+            count++;
+        }
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->slots_capacity = slots_capacity;
+    table->slots_used = count;
+    table->students_count = count;
+    return STUDENT_TABLE_SUCCESS;
+}
+
+/**
+ * studentTableCreate: Allocates a new empty StudentTable.
+ * @param table - pointer to the table created
+ * @return
+ * STUDENT_TABLE_SUCCESS - table created
+ * STUDENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+StudentTableResult studentTableCreate(StudentTable *table){
+    *table = malloc(sizeof(struct StudentTable_t));
+    if((*table) == NULL){
+        return STUDENT_TABLE_OUT_OF_MEMORY;
+    }
+    (*table)->students = NULL;
+    (*table)->students_count = 0;
+    (*table)->students_capacity = 0;
+    (*table)->size = 0;
+    (*table)->slots = NULL;
+    (*table)->slots_capacity = 0;
+    (*table)->slots_used = 0;
+    (*table)->iterator = 0;
+    if(rebuildTable(*table) != STUDENT_TABLE_SUCCESS){
+        free(*table);
+        *table = NULL;
+        return STUDENT_TABLE_OUT_OF_MEMORY;
+    }
+    return STUDENT_TABLE_SUCCESS;
+}
+
+/**
+ * studentTableInsert: Inserts a student to the end of the table.
+ * on success the table owns the student and will de-allocate it.
+ * @param table
+ * @param student
+ * @return
+ * STUDENT_TABLE_SUCCESS - student inserted
+ * STUDENT_TABLE_NULL_ARGUMENT - table or student are NULL
+ * STUDENT_TABLE_ALREADY_EXISTS - a student with the same id is in the table
+ * STUDENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+StudentTableResult studentTableInsert(StudentTable table, Student student){
+    if(table == NULL || student == NULL){
+        return STUDENT_TABLE_NULL_ARGUMENT;
+    }
+    int student_id = studentGetStudentId(student);
+    if(findSlot(table,student_id) != -1){
+        return STUDENT_TABLE_ALREADY_EXISTS;
+    }
+    //keep the hash table at most half full (deleted slots included)
+    if((table->slots_used + 1) * 2 > table->slots_capacity ||
+       table->students_count == table->students_capacity){
+        if(rebuildTable(table) != STUDENT_TABLE_SUCCESS){
+            return STUDENT_TABLE_OUT_OF_MEMORY;
+        }
+    }
+    if(table->students_count == table->students_capacity){
+        int capacity = table->students_capacity == 0 ?
+                       INITIAL_SLOTS : table->students_capacity * 2;
+        Student* students = realloc(table->students,sizeof(Student)*capacity);
+        if(students == NULL){
+            return STUDENT_TABLE_OUT_OF_MEMORY;
+        }
+        table->students = students;
+        table->students_capacity = capacity;
+    }
+    table->students[table->students_count] = student;
+    placeIndex(table->slots,table->slots_capacity,student_id,table->students_count);
+    table->students_count++;
+    table->slots_used++;
+    table->size++;
+    return STUDENT_TABLE_SUCCESS;
+}
+
+/**
+ * studentTableFind: returns the student with the given id
+ * @param table
+ * @param student_id
+ * @return
+ * NULL - if there's no such student
+ * the student - otherwise
+ */
+Student studentTableFind(StudentTable table, int student_id){
+    if(table == NULL){
+        return NULL;
+    }
+    int slot = findSlot(table,student_id);
+    if(slot == -1){
+        return NULL;
+    }
+    return table->students[table->slots[slot]];
+}
+
+/**
+ * studentTableRemove: removes the student with the given id and de-allocates it
+ * @param table
+ * @param student_id
+ * @return
+ * STUDENT_TABLE_SUCCESS - student removed
+ * STUDENT_TABLE_NULL_ARGUMENT - table is NULL
+ * STUDENT_TABLE_NOT_EXISTS - there's no such student
+ */
+StudentTableResult studentTableRemove(StudentTable table, int student_id){
+    if(table == NULL){
+        return STUDENT_TABLE_NULL_ARGUMENT;
+    }
+    int slot = findSlot(table,student_id);
+    if(slot == -1){
+        return STUDENT_TABLE_NOT_EXISTS;
+    }
+    int index = table->slots[slot];
+    studentDestroy(table->students[index]);
+    table->students[index] = NULL;
+    table->slots[slot] = DELETED_SLOT;
+    table->size--;
+    //too many holes - close them so iteration stays proportional to the size
+    if(table->students_count > 2 * table->size + INITIAL_SLOTS){
+        rebuildTable(table);//on failure the table just stays with its holes
+    }
+    return STUDENT_TABLE_SUCCESS;
+}
+
+/**
+ * studentTableGetSize: returns the number of students in the table
+ * @param table
+ * @return
+ * -1 if table is NULL
+ * number of students otherwise
+ */
+int studentTableGetSize(StudentTable table){
+    if(table == NULL){
+        return -1;
+    }
+    return table->size;
+}
+
+static Student advanceIterator(StudentTable table){
+    while(table->iterator < table->students_count &&
+          table->students[table->iterator] == NULL){
+        table->iterator++;
+    }
+    if(table->iterator >= table->students_count){
+        return NULL;
+    }
+    return table->students[table->iterator];
+}
+
+/**
+ * studentTableGetFirst: sets the iterator to the first student in insertion order
+ * @param table
+ * @return
+ * NULL - if the table is empty
+ * the first student - otherwise
+ */
+Student studentTableGetFirst(StudentTable table){
+    if(table == NULL){
+        return NULL;
+    }
+    table->iterator = 0;
+    return advanceIterator(table);
+}
+
+/**
+ * studentTableGetNext: advances the iterator to the next student in insertion order
+ * @param table
+ * @return
+ * NULL - if the iterator reached the end
+ * the next student - otherwise
+ */
+Student studentTableGetNext(StudentTable table){
+    if(table == NULL || table->iterator >= table->students_count){
+        return NULL;
+    }
+    table->iterator++;
+    return advanceIterator(table);
+}
+
+/**
+ * studentTableDestroy: De-allocates the table and all of its students.
+ * @param table
+ */
+void studentTableDestroy(StudentTable table){
+    if(table == NULL){
+        return;
+    }
+    for(int i = 0; i < table->students_count; i++){
+        if(table->students[i] != NULL){
+            studentDestroy(table->students[i]);
+        }
+    }
+    free(table->students);
+    free(table->slots);
+    free(table);
+}
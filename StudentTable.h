@@ -0,0 +1,122 @@
+
+#ifndef STUDENTTABLE_H
+#define STUDENTTABLE_H
+
+#include "Student.h"
+/**
+ * StudentTable structure
+ *
+ * StudentTable holds all the students of the system, indexed by their id.
+ * Lookup, insertion and removal are done with an open addressing hash table,
+ * while the students themselves are kept in the order they were inserted.
+ * The table owns the students inserted to it.
+
+ * The following functions are available:
+ * studentTableCreate:   Allocates a new empty StudentTable.
+ * studentTableInsert:   Inserts a student to the table (the table takes ownership)
+ * studentTableFind:     Returns the student with the given id
+ * studentTableRemove:   Removes and de-allocates the student with the given id
+ * studentTableGetSize:  Returns the number of students in the table
+ * studentTableGetFirst: Sets the iterator to the first student and returns it
+ * studentTableGetNext:  Advances the iterator to the next student and returns it
+ * studentTableDestroy:  De-allocates the table and all of its students.
+ */
+
+/** Type for defining the student table */
+typedef struct StudentTable_t *StudentTable;
+
+/** Type used for returning error codes from student table functions */
+typedef enum StudentTableResult_t {
+    STUDENT_TABLE_OUT_OF_MEMORY,
+    STUDENT_TABLE_NULL_ARGUMENT,
+    STUDENT_TABLE_ALREADY_EXISTS,
+    STUDENT_TABLE_NOT_EXISTS,
+    STUDENT_TABLE_SUCCESS
+} StudentTableResult;
+
+/**
+ * studentTableCreate: Allocates a new empty StudentTable.
+ * @param table - pointer to the table created
+ * @return
+ * STUDENT_TABLE_SUCCESS - table created
+ * STUDENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+StudentTableResult studentTableCreate(StudentTable *table);
+
+/**
+ * studentTableInsert: Inserts a student to the end of the table.
+ * on success the table owns the student and will de-allocate it.
+ * @param table
+ * @param student
+ * @return
+ * STUDENT_TABLE_SUCCESS - student inserted
+ * STUDENT_TABLE_NULL_ARGUMENT - table or student are NULL
+ * STUDENT_TABLE_ALREADY_EXISTS - a student with the same id is in the table
+ * STUDENT_TABLE_OUT_OF_MEMORY - memory problem occurred
+ */
+StudentTableResult studentTableInsert(StudentTable table, Student student);
+
+/**
+ * studentTableFind: returns the student with the given id
+ * @param table
+ * @param student_id
+ * @return
+ * NULL - if there's no such student
+ * the student - otherwise
+ */
+Student studentTableFind(StudentTable table, int student_id);
+
+/**
+ * studentTableRemove: removes the student with the given id and de-allocates it
+ * @param table
+ * @param student_id
+ * @return
+ * STUDENT_TABLE_SUCCESS - student removed
+ * STUDENT_TABLE_NULL_ARGUMENT - table is NULL
+ * STUDENT_TABLE_NOT_EXISTS - there's no such student
+ */
+StudentTableResult studentTableRemove(StudentTable table, int student_id);
+
+/**
+ * studentTableGetSize: returns the number of students in the table
+ * @param table
+ * @return
+ * -1 if table is NULL
+ * number of students otherwise
+ */
+int studentTableGetSize(StudentTable table);
+
+/**
+ * studentTableGetFirst: sets the iterator to the first student in insertion order
+ * @param table
+ * @return
+ * NULL - if the table is empty
+ * the first student - otherwise
+ */
+Student studentTableGetFirst(StudentTable table);
+
+/**
+ * studentTableGetNext: advances the iterator to the next student in insertion order
+ * the table must not be changed while iterating.
+ * @param table
+ * @return
+ * NULL - if the iterator reached the end
+ * the next student - otherwise
+ */
+Student studentTableGetNext(StudentTable table);
+
+/**
+ * studentTableDestroy: De-allocates the table and all of its students.
+ * @param table
+ */
+void studentTableDestroy(StudentTable table);
+
+/**
+ * iterates over all the students in the table in insertion order
+ */
+#define STUDENT_TABLE_FOREACH(iterator,table) \
+    for(Student iterator = studentTableGetFirst(table) ; \
+        iterator ; \
+        iterator = studentTableGetNext(table))
+
+#endif //STUDENTTABLE_H
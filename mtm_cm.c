@@ -1,8 +1,16 @@
+#define _POSIX_C_SOURCE 200112L//for fileno, mmap and pthread
+#define _DEFAULT_SOURCE//for madvise and _SC_NPROCESSORS_ONLN
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
 #include <stdbool.h>
+#include <ctype.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "list.h"
 #include "mtm_ex3.h"
 #include "GradeSheet.h"
@@ -12,8 +20,16 @@
 #include "Student.h"
 #include "Student.h"
 #include "CourseManager.h"
+#include "CommandStream.h"
+#include "CommandRing.h"
 
 #define MTM_SUCCESS -1
+#define PIPELINE_LINES 1024//parsed lines the reader thread may be ahead of execution
+#define READER_RELEASE_SIZE (4 << 20)//read bytes of the mapping given back at a time
+#ifndef PIPELINE_MIN_PROCESSORS
+#define PIPELINE_MIN_PROCESSORS 2//processors needed to read in a thread of its own
+#endif
+#define PIPELINE_ENV "MTM_PIPELINE"//environment variable forcing the pipeline on (1) or off (0)
 /**
  * error: terminate program run and frees all space allocated
  * happens if command line arguments, opening files or allocation failure occures
@@ -24,50 +40,74 @@ void error(MtmErrorCode errorCode, CourseManager courseManager){
     courseManagerDestroy(courseManager);
 }
 
+//is the argument one of the flags of the command line
+static bool isFlag(const char* argument){
+    return strcmp(argument,"-i") == 0 || strcmp(argument,"-o") == 0 ||
+           strcmp(argument,"-c") == 0 || strcmp(argument,"-b") == 0 ||
+           strcmp(argument,"-l") == 0 || strcmp(argument,"-s") == 0 ||
+           strcmp(argument,"-j") == 0;
+}
+
 /**
  * checkCommandLine: checks command line arguments and puts the relevant files in place
- * receives command line, number of argument, input file and output file
+ * receives command line, number of argument, and the places of the files in it:
+ * -i input script, -o output file,
+ * -c compile the input script into a command stream file instead of executing it,
+ * -b execute a command stream file instead of an input script
+ * -l start from a snapshot file instead of an empty system
+ * -s save a snapshot file of the system after the commands
+ * -j record the changes in a journal file next to the -l snapshot, recovering from both
  * @return
- * 1 if line correct, 0 otherwise
+ * MTM_SUCCESS if line correct, MTM_INVALID_COMMAND_LINE_PARAMETERS otherwise
  */
-int checkCommandLine(int argc,char **argv,int *input_flag, int *output_flag){
+int checkCommandLine(int argc,char **argv,int *input_flag, int *output_flag,
+                     int *compile_flag, int *stream_flag, int *load_flag, int *save_flag,
+                     int *journal_flag){
     int counter = 1;//will go over command line arguments
-    if(argc > 5){
+    *input_flag = 0;
+    *output_flag = 0;
+    *compile_flag = 0;
+    *stream_flag = 0;
+    *load_flag = 0;
+    *save_flag = 0;
+    *journal_flag = 0;
+    if(argc > 11){
         return MTM_INVALID_COMMAND_LINE_PARAMETERS;//there're more variables then there should be
     }
     if(argc == 1){
-        *input_flag = 0;
-        *output_flag = 0;
         return MTM_SUCCESS;
     }
-    if(strcmp(argv[counter],"-i") != 0 && strcmp(argv[counter],"-o") != 0){
+    if(!isFlag(argv[counter])){
         return MTM_INVALID_COMMAND_LINE_PARAMETERS;
     }
     //will check if there wasn't any input/output file declared
     while(counter < argc){
         //iterating through command line
-        if (strcmp(argv[counter],"-i") == 0){//input
+        if(isFlag(argv[counter])){
+            char flag = argv[counter][1];
             counter++;
-            if(!*(argv+counter)){
-                return MTM_INVALID_COMMAND_LINE_PARAMETERS;
-            }
-            if(strcmp(argv[counter],"-o") == 0){
+            if(!*(argv+counter) || isFlag(argv[counter])){
                 return MTM_INVALID_COMMAND_LINE_PARAMETERS;//needs to be a file
             }
-            *input_flag = counter;//place in array
-        }
-        if (strcmp(argv[counter],"-o") == 0){//output
-            counter++;
-            if(!*(argv+counter)){
-                return MTM_INVALID_COMMAND_LINE_PARAMETERS;
-            }
-            if(strcmp(argv[counter],"-i") == 0){
-                return MTM_INVALID_COMMAND_LINE_PARAMETERS;//needs to be a file
+            switch(flag){
+                case 'i': *input_flag = counter; break;
+                case 'o': *output_flag = counter; break;
+                case 'c': *compile_flag = counter; break;
+                case 'l': *load_flag = counter; break;
+                case 's': *save_flag = counter; break;
+                case 'j': *journal_flag = counter; break;
+                default: *stream_flag = counter; break;
             }
-            *output_flag = counter;//output file
         }
         counter++;
     }
+    //a stream has no input script, compiling has no output and no system,
+    //and a journal belongs to a snapshot
+    if((*stream_flag != 0 && (*input_flag != 0 || *compile_flag != 0)) ||
+       (*compile_flag != 0 && (*output_flag != 0 || *load_flag != 0 || *save_flag != 0)) ||
+       (*journal_flag != 0 && (*load_flag == 0 || *compile_flag != 0))){
+        return MTM_INVALID_COMMAND_LINE_PARAMETERS;
+    }
     return MTM_SUCCESS;
 }
 
@@ -80,497 +120,583 @@ void freeNexit(CourseManager courseManager){
     courseManagerDestroy(courseManager);
 }
 
-//get rid of spaces and tabs
-char* delete_spaces(char *string){
-    if(string == NULL){
-        return NULL;
-    }
-    while(*string && (*string == ' ' || *string == '\t')){
-        string++;
-    }
-    return string;
-}
+/**
+ * CommandLine: the words of a command line, found in a single pass over the line.
+ * every word is a span (start and length) of the line, so the line is only read,
+ * and the strings a command keeps are copied out of it once the line is parsed.
+ */
+#define MAX_WORDS 8//the longest command (grade_sheet add) has 6 words
+#define MAX_LINE_COMMANDS COMMAND_RING_LINE_COMMANDS
 
+typedef struct Word_t {
+    const char* start;
+    int length;
+} Word;
 
-//get rid of spaces and tabs
-char* advance_word(char *string){
-    if(string == NULL){
-        return NULL;
-    }
-    while(*string && *string != ' ' && *string != '\t'){//we're in a word
-        string++;
-    }
-    while(*string && (*string == ' ' || *string == '\t')){
-        string++;
-    }
-    return string;
-}
+typedef struct CommandLine_t {
+    Word words[MAX_WORDS];
+    int count;
+    char* strings;//room for the strings the commands keep, as long as the line
+} CommandLine;
 
-//counts length until next space or tab
-int count_till_space(char *string){
-    if(string == NULL){
-        return 0;
-    }
-    int counter = 0;
-    while(*string && *string != ' ' && *string != '\t' && *string != '\n'){//we're in a word
-        string++;
-        counter++;
-    }
-    return counter;
+//spaces and tabs separate words, a new line ends the last word
+static bool isSeparator(char c){
+    return c == ' ' || c == '\t';
 }
 
 /**
- * callStudentAdd: calls the function student add by the line received
- * @return
+ * tokenizeLine: splits the first length chars of line into words, without changing it.
+ * the line ends at a new line or a '\0', like a line read by fgets.
+ * words after the first MAX_WORDS are ignored (no command reads them)
  */
-void callStudentAdd(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    char *param2 = malloc(MAX_LEN + 1);
-    char *param3 = malloc(MAX_LEN + 1);
-    param2[0] = '\0';param3[0] = '\0';
-    int counter = 0, id = 0;//will count words length
-    token = advance_word(token);//advance to next word
-    id = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    counter = count_till_space(token);
-    strncat(param2,token,counter);//get second param from line
-    param2[counter] = '\0';
-    token = advance_word(token);//advance to next word
-    counter = count_till_space(token);
-    strncat(param3,token,counter);//get third param from line
-    param3[counter] = '\0';
-    MtmErrorCode error = addStudent(courseManager,id,param2,param3);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
-    }
-    free(param2);
-    free(param3);
-}
-
-/**
-* callStudentRemove: calls the function student remove by the line received
-* @return
-*/
-void callStudentRemove(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int id = 0;//will count words length
-    token = advance_word(token);//advance to next word
-    id = strtol(token,&token,10);
-    MtmErrorCode error = removeStudent(courseManager,id);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
-    }
-}
-
-/**
-* callStudentLogIn: calls the function student login by the line received
-* @return
-*/
-void callStudentLogIn(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int id = 0;//will count words length
-    token = advance_word(token);//advance to next word
-    id = strtol(token,&token,10);
-    MtmErrorCode error = studentLogIn(courseManager,id);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+static void tokenizeLine(const char* line, int length, CommandLine* command){
+    command->count = 0;
+    const char* current = line;
+    const char* end = line + length;
+    while(current < end && *current && command->count < MAX_WORDS){
+        while(current < end && isSeparator(*current)){
+            current++;
+        }
+        if(current == end || *current == '\0' || *current == '\n'){
+            break;
+        }
+        const char* start = current;
+        while(current < end && *current && !isSeparator(*current) && *current != '\n'){
+            current++;
+        }
+        Word word = {start, (int)(current - start)};
+        command->words[command->count++] = word;
+        if(current < end && *current == '\n'){
+            break;//nothing comes after the new line
+        }
     }
 }
 
-/**
-* callStudentLogOut: calls the function student logout by the line received
-* @return
-*/
-void callStudentLogOut(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    MtmErrorCode error = studentLogOut(courseManager);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
-    }
+//the word in the given place, an empty word if the line is shorter
+static Word commandWord(CommandLine* command, int place){
+    static const Word empty = {"", 0};
+    return place < command->count ? command->words[place] : empty;
 }
 
-/**
-* callStudentFriendRequest: calls the function student friend request by the line received
-* @return
-*/
-void callStudentFriendRequest(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int id = 0;//will count words length
-    token = advance_word(token);//advance to next word
-    id = strtol(token,&token,10);
-    MtmErrorCode error = studentFriendRequest(courseManager,id);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
-    }
+//the letter in the given place of the word, '\0' if the word is shorter
+static char wordLetter(Word word, int place){
+    return place < word.length ? word.start[place] : '\0';
 }
 
 /**
- * callStudentHandleFriendRequest: calls the function handle request by the line received
- * @return
+ * commandNumber: reads the word in the given place as a number, the way strtol
+ * reads it (0 if it doesn't start with one), without reading past the word
  */
-void callStudentHandleFriendRequest(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    char *param2 = malloc(MAX_LEN + 1);
-    param2[0] = '\0';
-    int counter = 0, other_id = 0;//will count words length
-    token = advance_word(token);//advance to next word
-    other_id = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    counter = count_till_space(token);
-    strncat(param2,token,counter);//get second param from line
-    param2[counter] = '\0';
-    MtmErrorCode error = studentHandleRequest(courseManager,other_id,param2);
-    free(param2);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+static int commandNumber(CommandLine* command, int place){
+    Word word = commandWord(command,place);
+    int i = 0;
+    while(i < word.length && isspace((unsigned char)word.start[i])){
+        i++;
+    }
+    bool negative = i < word.length && word.start[i] == '-';
+    if(i < word.length && (word.start[i] == '-' || word.start[i] == '+')){
+        i++;
+    }
+    long number = 0;
+    for(; i < word.length && isdigit((unsigned char)word.start[i]); i++){
+        int digit = word.start[i] - '0';
+        if(number > (LONG_MAX - digit)/10){
+            number = LONG_MAX;//strtol stops at the largest number too
+            if(negative){
+                return (int)LONG_MIN;
+            }
+            break;
+        }
+        number = number*10 + digit;
     }
+    return (int)(negative ? -number : number);
 }
 
-/**
-* callStudentUnFriend: calls the function student unfriend by the line received
-* @return
-*/
-void callStudentUnFriend(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int id = 0;//will count words length
-    token = advance_word(token);//advance to next word
-    id = strtol(token,&token,10);
-    MtmErrorCode error = studentUnFriend(courseManager,id);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
-    }
+//copies the word in the given place to the strings of the line, ending it with '\0'
+static char* commandString(CommandLine* command, int place){
+    Word word = commandWord(command,place);
+    char* string = command->strings;
+    memcpy(string,word.start,(size_t)word.length);
+    string[word.length] = '\0';
+    command->strings += word.length + 1;
+    return string;
 }
 
 /**
- * executestudent: executes student commands
- * receives courseManager, line and output file
+ * parseStudent: parses a student command, the command name is in the given place
  * @return
+ * true if the command was parsed, false if it isn't a student command
  */
-void executeStudent(CourseManager courseManager,char* token,FILE* output_file){
-    switch(*token){
+static bool parseStudent(CommandLine* words,int name,Command* command){
+    Word word = commandWord(words,name);
+    command->numbers[0] = commandNumber(words,name+1);
+    switch(wordLetter(word,0)){
         case 'a'://student add
-        {
-            callStudentAdd(courseManager,token,output_file);
-            return;
-        }
+            command->type = COMMAND_STUDENT_ADD;
+            command->strings[0] = commandString(words,name+2);
+            command->strings[1] = commandString(words,name+3);
+            return true;
         case 'r'://student remove
-        {
-            callStudentRemove(courseManager,token,output_file);
-            return;
-        }
+            command->type = COMMAND_STUDENT_REMOVE;
+            return true;
         case 'l'://student login/logout
-        {
-            if(*(token+3) == 'i'){
-                callStudentLogIn(courseManager,token,output_file);
-            }
-            else {
-                callStudentLogOut(courseManager,token,output_file);
-            }
-            return;
-        }
+            //the 4th letter tells login from logout, a shorter word is a logout
+            command->type = wordLetter(word,3) == 'i' ?
+                            COMMAND_STUDENT_LOGIN : COMMAND_STUDENT_LOGOUT;
+            return true;
         case 'f'://student friend request
-        {
-            callStudentFriendRequest(courseManager,token,output_file);
-            return;
-        }
+            command->type = COMMAND_STUDENT_FRIEND_REQUEST;
+            return true;
         case 'h'://student handle friend request
-        {
-            callStudentHandleFriendRequest(courseManager,token,output_file);
-            return;
-        }
+            command->type = COMMAND_STUDENT_HANDLE_REQUEST;
+            command->strings[0] = commandString(words,name+2);
+            return true;
         case 'u'://student unfriend
-        {
-            callStudentUnFriend(courseManager,token,output_file);
-            return;
-        }
+            command->type = COMMAND_STUDENT_UNFRIEND;
+            return true;
     }
+    return false;
 }
 
 /**
- * callGradeSheetAdd: calls the function grade sheet add by the line received
+ * parseGradeSheet: parses a grade sheet command, the command name is in the given place
  * @return
+ * true if the command was parsed, false if it isn't a grade sheet command
  */
-void callGradeSheetAdd(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    char *param2 = malloc(MAX_LEN + 1);
-    param2[0] = '\0';
-    int counter = 0, semester = -1, course_id = -1, grade = -1;//gets parameters for function
-    token = advance_word(token);//advance to next word
-    semester = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    course_id = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    counter = count_till_space(token);
-    strncat(param2,token,counter);//get points param from line
-    param2[counter] = '\0';
-    token = advance_word(token);//advance to next word
-    grade = strtol(token,&token,10);
-    MtmErrorCode error = grade_sheet_add(courseManager,semester,course_id,param2,grade);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+static bool parseGradeSheet(CommandLine* words,int name,Command* command){
+    command->numbers[0] = commandNumber(words,name+1);
+    command->numbers[1] = commandNumber(words,name+2);
+    switch(wordLetter(commandWord(words,name),0)){
+        case 'a'://grade sheet add
+            command->type = COMMAND_GRADE_SHEET_ADD;
+            command->strings[0] = commandString(words,name+3);
+            command->numbers[2] = commandNumber(words,name+4);
+            return true;
+        case 'r'://grade sheet remove
+            command->type = COMMAND_GRADE_SHEET_REMOVE;
+            return true;
+        case 'u'://grade sheet update
+            command->type = COMMAND_GRADE_SHEET_UPDATE;
+            return true;
     }
-    free(param2);
+    return false;
 }
 
-
 /**
- * callGradeSheetRemove: calls the function grade sheet remove by the line received
+ * parseReport: parses a report command, the command name is in the given place
  * @return
+ * true if the command was parsed, false if it isn't a report command
  */
-void callGradeSheetRemove(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int semester = -1, course_id = -1;//gets parameters for function
-    token = advance_word(token);//advance to next word
-    semester = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    course_id = strtol(token,&token,10);
-    MtmErrorCode error = grade_sheet_remove(courseManager,semester,course_id);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+static bool parseReport(CommandLine* words,int name,Command* command){
+    Word word = commandWord(words,name);
+    command->numbers[0] = commandNumber(words,name+1);
+    switch(wordLetter(word,0)){
+        case 'f'://report full/faculty request
+            if(wordLetter(word,1) == 'u'){
+                command->type = COMMAND_REPORT_FULL;
+            } else {
+                command->type = COMMAND_REPORT_FACULTY_REQUEST;
+                command->strings[0] = commandString(words,name+2);
+            }
+            return true;
+        case 'c'://report clean
+            command->type = COMMAND_REPORT_CLEAN;
+            return true;
+        case 'b'://report best
+            command->type = COMMAND_REPORT_BEST;
+            return true;
+        case 'w'://report worst
+            command->type = COMMAND_REPORT_WORST;
+            return true;
+        case 'r'://report reference
+            command->type = COMMAND_REPORT_REFERENCE;
+            command->numbers[1] = commandNumber(words,name+2);
+            return true;
     }
+    return false;
+}
+
+/**
+ * parseLine: parses a line into the commands it runs.
+ * after a student command the next word is checked for a grade sheet command,
+ * and after that for a report command, so a line may run up to 3 commands.
+ * the strings of the commands are copied to strings, that has room for
+ * a line of MAX_LEN chars, so the line itself is only read.
+ * @return
+ * the number of commands parsed
+ */
+static int parseLine(const char* line,int length,Command commands[MAX_LINE_COMMANDS],
+                     char* strings){
+    CommandLine words;
+    tokenizeLine(line,length,&words);
+    words.strings = strings;
+    int count = 0;
+    int name = 0;//the word checked for the kind of the command
+    if(wordLetter(commandWord(&words,name),0) == '#'){
+        return 0;//this line is a remark
+    }
+    if(wordLetter(commandWord(&words,name),0) == 's'){//student functions
+        name++;
+        count += parseStudent(&words,name,&commands[count]);
+    }
+    if(wordLetter(commandWord(&words,name),0) == 'g'){//grade_sheet functions
+        name++;
+        count += parseGradeSheet(&words,name,&commands[count]);
+    }
+    if(wordLetter(commandWord(&words,name),0) == 'r'){//report functions
+        name++;
+        count += parseReport(&words,name,&commands[count]);
+    }
+    return count;
 }
 
 /**
- * callGradeSheetUpdate: calls the function grade sheet update by the line received
+ * executeCommand: executes a parsed command and prints its error, if there was one
+ * receives courseManager, the command and output file
  * @return
  */
-void callGradeSheetUpdate(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int new_grade = -1, course_id = -1;//gets parameters for function
-    token = advance_word(token);//advance to next word
-    course_id = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    new_grade = strtol(token,&token,10);
-    MtmErrorCode error = grade_sheet_update(courseManager,course_id,new_grade);
+void executeCommand(CourseManager courseManager,const Command* command,FILE* output_file){
+    const int* numbers = command->numbers;
+    char* const* strings = command->strings;
+    MtmErrorCode error = MTM_SUCCESS;
+    switch(command->type){
+        case COMMAND_STUDENT_ADD:
+            error = addStudent(courseManager,numbers[0],strings[0],strings[1]);
+            break;
+        case COMMAND_STUDENT_REMOVE:
+            error = removeStudent(courseManager,numbers[0]);
+            break;
+        case COMMAND_STUDENT_LOGIN:
+            error = studentLogIn(courseManager,numbers[0]);
+            break;
+        case COMMAND_STUDENT_LOGOUT:
+            error = studentLogOut(courseManager);
+            break;
+        case COMMAND_STUDENT_FRIEND_REQUEST:
+            error = studentFriendRequest(courseManager,numbers[0]);
+            break;
+        case COMMAND_STUDENT_HANDLE_REQUEST:
+            error = studentHandleRequest(courseManager,numbers[0],strings[0]);
+            break;
+        case COMMAND_STUDENT_UNFRIEND:
+            error = studentUnFriend(courseManager,numbers[0]);
+            break;
+        case COMMAND_GRADE_SHEET_ADD:
+            error = grade_sheet_add(courseManager,numbers[0],numbers[1],strings[0],numbers[2]);
+            break;
+        case COMMAND_GRADE_SHEET_REMOVE:
+            error = grade_sheet_remove(courseManager,numbers[0],numbers[1]);
+            break;
+        case COMMAND_GRADE_SHEET_UPDATE:
+            error = grade_sheet_update(courseManager,numbers[0],numbers[1]);
+            break;
+        case COMMAND_REPORT_FULL:
+            error = reportFull(courseManager,output_file);
+            break;
+        case COMMAND_REPORT_CLEAN:
+            error = reportClean(courseManager,output_file);
+            break;
+        case COMMAND_REPORT_BEST:
+            error = reportBest(courseManager,output_file,numbers[0]);
+            break;
+        case COMMAND_REPORT_WORST:
+            error = reportWorst(courseManager,output_file,numbers[0]);
+            break;
+        case COMMAND_REPORT_REFERENCE:
+            error = reportReference(courseManager,output_file,numbers[0],numbers[1]);
+            break;
+        case COMMAND_REPORT_FACULTY_REQUEST:
+            error = reportFacultyRequest(courseManager,output_file,numbers[0],strings[0]);
+            break;
+        default:
+            break;
+    }
     if(error != MTM_SUCCESS){
         mtmPrintErrorMessage(stderr,error);
     }
 }
 
-
 /**
- * executeGradeSheet: executes grade sheet commands
- * receives courseManager, line and output file
+ * executeLine: receives a line and executes relevant functions,
+ * or writes them to compiled if it isn't NULL
+ * receives courseManager, the line and its length, output file and the compiled stream
  * @return
+ * MTM_SUCCESS, or the error of writing to the compiled stream
  */
-void executeGradeSheet(CourseManager courseManager,char* token,FILE* output_file){
-    switch(*token){
-        case 'a'://grade sheet add
-        {
-            callGradeSheetAdd(courseManager,token,output_file);
-            return;
-        }
-        case 'r'://grade sheet remove
-        {
-            callGradeSheetRemove(courseManager,token,output_file);
-            return;
+MtmErrorCode executeLine(CourseManager courseManager,const char* line,int length,
+                         FILE* output_file,CommandStream compiled){
+    Command commands[MAX_LINE_COMMANDS];
+    char strings[MAX_LEN+1];//the strings of the commands
+    int count = parseLine(line,length,commands,strings);
+    for(int i = 0; i < count; i++){
+        if(compiled == NULL){
+            executeCommand(courseManager,&commands[i],output_file);
+            continue;
         }
-        case 'u'://grade sheet update
-        {
-            callGradeSheetUpdate(courseManager,token,output_file);
-            return;
+        CommandStreamResult result = commandStreamWrite(compiled,&commands[i]);
+        if(result != COMMAND_STREAM_SUCCESS){
+            return result == COMMAND_STREAM_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY :
+                   MTM_CANNOT_OPEN_FILE;
         }
     }
+    return MTM_SUCCESS;
 }
 
 /**
-* callReportFull: calls the function report full by the line received
-* @return
-*/
-void callReportFull(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    MtmErrorCode error = reportFull(courseManager,output_file);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
-    }
+ * LineReader: the lines of an input, split like fgets does (at most MAX_LEN chars
+ * a line), each returned with its length. a regular input file is mapped to memory
+ * read only and its lines are used in place, the lines of stdin are read into
+ * a buffer given by the caller. the parsed commands keep copies of their strings,
+ * so the pages of the lines already read are given back as the reading goes on,
+ * and a huge input doesn't stay in memory.
+ */
+typedef struct LineReader_t {
+    FILE* file;
+    char* data;//the mapping, NULL if the file isn't mapped
+    size_t size;
+    const char* current;//the next line in the mapping
+    char* released;//the pages before it were given back
+} LineReader;
+
+static void lineReaderOpen(LineReader* reader,FILE* input_file){
+    reader->file = input_file;
+    reader->data = NULL;
+    reader->size = 0;
+    reader->current = NULL;
+    reader->released = NULL;
+    struct stat info;
+    //only input files are read in place, stdin goes through the buffer
+    int descriptor = input_file == stdin ? -1 : fileno(input_file);
+    if(descriptor < 0 || fstat(descriptor,&info) != 0 || !S_ISREG(info.st_mode) ||
+       info.st_size == 0){
+        return;
+    }
+    //the mapping is only read, so its pages stay the file's pages and are never copied,
+    //and reading ahead (instead of faulting the whole file in first) keeps them coming
+    char* data = mmap(NULL,(size_t)info.st_size,PROT_READ,MAP_PRIVATE,descriptor,0);
+    if(data == MAP_FAILED){
+        return;
+    }
+    posix_madvise(data,(size_t)info.st_size,POSIX_MADV_SEQUENTIAL);
+    reader->data = data;
+    reader->size = (size_t)info.st_size;
+    reader->current = data;
+    reader->released = data;
 }
 
-/**
-* callReportClean: calls the function report clean by the line received
-* @return
-*/
-void callReportClean(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    MtmErrorCode error = reportClean(courseManager,output_file);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
-    }
+//gives back the pages of the mapping before line, once there are enough of them
+static void lineReaderRelease(LineReader* reader,const char* line){
+    if(line - reader->released < READER_RELEASE_SIZE){
+        return;
+    }
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = (size_t)(line - reader->released) / page * page;
+    madvise(reader->released,size,MADV_DONTNEED);
+    reader->released += size;
 }
 
 /**
- * callReportBest: calls the function report best by the line received
+ * lineReaderNext: returns the next line of the input. the line before it
+ * mustn't be used any more.
+ * @param buffer - room for a line of MAX_LEN chars, for a line read from stdin
+ * @param length - the length of the line returned
  * @return
+ * NULL - the input ended
+ * the line - otherwise, in the mapping or in buffer
  */
-void callReportBest(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int amount = -1;//gets parameters for function
-    token = advance_word(token);//advance to next word
-    amount = strtol(token,&token,10);
-    MtmErrorCode error = reportBest(courseManager,output_file,amount);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+static const char* lineReaderNext(LineReader* reader,char* buffer,int* length){
+    if(reader->data == NULL){
+        if(fgets(buffer,MAX_LEN+1,reader->file) == NULL){
+            return NULL;
+        }
+        *length = (int)strlen(buffer);
+        return buffer;
+    }
+    const char* end = reader->data + reader->size;
+    if(reader->current >= end){
+        return NULL;
     }
+    const char* line = reader->current;
+    lineReaderRelease(reader,line);
+    size_t size = (size_t)(end - line) < MAX_LEN ? (size_t)(end - line) : MAX_LEN;
+    const char* new_line = memchr(line,'\n',size);
+    reader->current += new_line != NULL ? (size_t)(new_line - line) + 1 : size;
+    *length = (int)(reader->current - line);
+    return line;
 }
 
-/**
- * callReportWorst: calls the function report worst by the line received
- * @return
- */
-void callReportWorst(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int amount = -1;//gets parameters for function
-    token = advance_word(token);//advance to next word
-    amount = strtol(token,&token,10);
-    MtmErrorCode error = reportWorst(courseManager,output_file,amount);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+//unmaps the input, if it was mapped
+static void lineReaderClose(LineReader* reader){
+    if(reader->data != NULL){
+        munmap(reader->data,reader->size);
     }
 }
 
+//what the reader thread of a pipelined run works on
+typedef struct PipelineReader_t {
+    LineReader* lines;
+    CommandRing ring;
+} PipelineReader;
+
 /**
- * callReportReference: calls the function report reference by the line received
- * @return
+ * readCommands: the reader thread of a pipelined run - reads and parses the lines
+ * of the input into the ring, until the input ends
+ * receives the PipelineReader of the run
+ * @return NULL
  */
-void callReportReference(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    int course_id = -1, amount = -1;//gets parameters for function
-    token = advance_word(token);//advance to next word
-    course_id = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    amount = strtol(token,&token,10);
-    MtmErrorCode error = reportReference(courseManager,output_file,course_id,amount);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+
+static void* readCommands(void* argument){
+    PipelineReader* reader = argument;
+    while(true){
+        CommandLineEntry* entry = commandRingReserve(reader->ring);
+        int length;
+        const char* line = lineReaderNext(reader->lines,entry->line,&length);
+        if(line == NULL){
+            break;
+        }
+        entry->count = parseLine(line,length,entry->commands,entry->strings);
+        commandRingPublish(reader->ring);
     }
+    commandRingFinish(reader->ring);
+    return NULL;
 }
 
 /**
- * callReportFacultyRequest: calls the function report faculty request by the line received
+ * readAndExecutePipelined: reads and parses the lines in a reader thread, while
+ * this thread executes the parsed commands in the order of the lines. all the
+ * printing is done by this thread, so the output is the same as executing the
+ * lines one after the other.
  * @return
+ * false if the reader thread can't be started (nothing was read), true otherwise
  */
-void callReportFacultyRequest(CourseManager courseManager,char* token,FILE* output_file) {
-    //space for parameters to functions in line (max 4)
-    char *param2 = malloc(MAX_LEN + 1);
-    param2[0] = '\0';
-    int counter = 0,course_id = -1;//gets parameters for function
-    token = advance_word(token);//advance to next word
-    course_id = strtol(token,&token,10);
-    token = advance_word(token);//advance to next word
-    counter = count_till_space(token);
-    strncat(param2,token,counter);//get points param from line
-    param2[counter] = '\0';
-    MtmErrorCode error = reportFacultyRequest(courseManager,output_file,course_id,param2);
-    if(error != MTM_SUCCESS){
-        mtmPrintErrorMessage(stderr,error);
+static bool readAndExecutePipelined(CourseManager courseManager,LineReader* lines,
+                                    FILE* output_file){
+    PipelineReader reader;
+    reader.lines = lines;
+    if(commandRingCreate(PIPELINE_LINES,&reader.ring) != COMMAND_RING_SUCCESS){
+        return false;
+    }
+    pthread_t thread;
+    if(pthread_create(&thread,NULL,readCommands,&reader) != 0){
+        commandRingDestroy(reader.ring);
+        return false;
+    }
+    CommandLineEntry* entry;
+    while((entry = commandRingPeek(reader.ring)) != NULL){
+        for(int i = 0; i < entry->count; i++){
+            executeCommand(courseManager,&entry->commands[i],output_file);
+        }
+        commandRingRelease(reader.ring);
     }
-    free(param2);
+    pthread_join(thread,NULL);
+    commandRingDestroy(reader.ring);
+    return true;
+}
+
+//parsing is worth a thread of its own only if it gets a processor of its own,
+//unless PIPELINE_ENV forces it: "1" reads in a thread of its own, "0" never does
+static bool isPipelined(void){
+    const char* forced = getenv(PIPELINE_ENV);
+    if(forced != NULL && (strcmp(forced,"0") == 0 || strcmp(forced,"1") == 0)){
+        return forced[0] == '1';
+    }
+    return sysconf(_SC_NPROCESSORS_ONLN) >= PIPELINE_MIN_PROCESSORS;
 }
 
 /**
- * executeReport: executes report commands
- * receives courseManager, line and output file
+ * readAndExecuteFile: reads lines from file and executes relevant functions,
+ * or only writes them to compiled if it isn't NULL
+ * receives courseManager, input/output file and the compiled stream
  * @return
  */
-void executeReport(CourseManager courseManager,char* token,FILE* output_file){
-    switch(*token){
-        case 'f'://report full/faculty request
-        {
-            if(*(token+1) == 'u'){
-                callReportFull(courseManager,token,output_file);
-            }
-            else{
-                callReportFacultyRequest(courseManager,token,output_file);
-            }
-            return;
-        }
-        case 'c'://report clean
-        {
-            callReportClean(courseManager,token,output_file);
-            return;
-        }
-        case 'b'://report best
-        {
-            callReportBest(courseManager,token,output_file);
-            return;
-        }
-        case 'w'://report worst
-        {
-            callReportWorst(courseManager,token,output_file);
-            return;
-        }
-        case 'r'://report reference
-        {
-            callReportReference(courseManager,token,output_file);
-            return;
-        }
-    }
+MtmErrorCode readAndExecuteFile(CourseManager courseManager,FILE* input_file,FILE* output_file,
+                                CommandStream compiled){
+    MtmErrorCode result = MTM_SUCCESS;
+    LineReader lines;
+    lineReaderOpen(&lines,input_file);
+    if(compiled == NULL && isPipelined() &&
+       readAndExecutePipelined(courseManager,&lines,output_file)){
+        lineReaderClose(&lines);
+        return result;
+    }
+    char buffer[MAX_LEN+1];//will get a line of command that isn't in place
+    const char* line;
+    int length;
+    while(result == MTM_SUCCESS && (line = lineReaderNext(&lines,buffer,&length)) != NULL){
+        result = executeLine(courseManager,line,length,output_file,compiled);
+    }
+    lineReaderClose(&lines);
+    return result;
 }
 
 /**
- * executeLine: receives a line and executes relevant functions
- * receives courseManager, line and output file
+ * compileFile: compiles the commands of the input into a command stream file
  * @return
+ * MTM_CANNOT_OPEN_FILE - the stream file can't be written
+ * MTM_OUT_OF_MEMORY - memory problem occurred
+ * MTM_SUCCESS - the stream was written
  */
-void executeLine(CourseManager courseManager,char* line,FILE* output_file){
-    //const char space[2] = " ";//delimiter for line
-    char *token;//will iterate through words
-    token = delete_spaces(line);
-    //token now points to the first char (that's not space or tab) in line
-    if(*token == '#'){
-        return;//this line is a remark
-    }
-    if(*token == 's'){//student functions
-        token = advance_word(token);//advance to next word
-        executeStudent(courseManager,token,output_file);
-    }
-    if(*token == 'g'){//grade_sheet functions
-        token = advance_word(token);//advance to next word
-        executeGradeSheet(courseManager,token,output_file);
-    }
-    if(*token == 'r'){//report functions
-        token = advance_word(token);//advance to next word
-        executeReport(courseManager,token,output_file);
-    }
+MtmErrorCode compileFile(FILE* input_file,const char* stream_path){
+    CommandStream compiled;
+    CommandStreamResult created = commandStreamCreate(stream_path,&compiled);
+    if(created != COMMAND_STREAM_SUCCESS){
+        return created == COMMAND_STREAM_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY :
+               MTM_CANNOT_OPEN_FILE;
+    }
+    MtmErrorCode result = readAndExecuteFile(NULL,input_file,NULL,compiled);
+    if(commandStreamClose(compiled) != COMMAND_STREAM_SUCCESS && result == MTM_SUCCESS){
+        result = MTM_CANNOT_OPEN_FILE;
+    }
+    return result;
 }
 
 /**
- * readAndExecuteFile: reads lines from file and executes relevant functions
- * receives courseManager and input/output file
+ * executeStream: executes the commands of a command stream file. a damaged or cut
+ * stream is found when it's loaded, so none of its commands are executed.
  * @return
+ * MTM_CANNOT_OPEN_FILE - the stream file can't be read, or isn't a whole command stream
+ * MTM_OUT_OF_MEMORY - memory problem occurred
+ * MTM_SUCCESS - the stream was executed
  */
-MtmErrorCode readAndExecuteFile(CourseManager courseManager,FILE* input_file,FILE* output_file){
-    char *line = malloc(MAX_LEN+1);//will get line of command
-    if(line == NULL){
-        mtmPrintErrorMessage(stderr,MTM_OUT_OF_MEMORY);
-        freeNexit(courseManager);//memory problem - exit
-        return MTM_OUT_OF_MEMORY;
-    }
-    while(fgets(line,MAX_LEN+1,input_file) != NULL){
-        executeLine(courseManager,line,output_file);
-        strcpy(line,"");//clear line for next line to receive
-    }
-    free(line);
+MtmErrorCode executeStream(CourseManager courseManager,const char* stream_path,FILE* output_file){
+    CommandStream stream;
+    CommandStreamResult loaded = commandStreamLoad(stream_path,&stream);
+    if(loaded != COMMAND_STREAM_SUCCESS){
+        return loaded == COMMAND_STREAM_OUT_OF_MEMORY ? MTM_OUT_OF_MEMORY :
+               MTM_CANNOT_OPEN_FILE;
+    }
+    Command command;
+    while(commandStreamNext(stream,&command)){
+        executeCommand(courseManager,&command,output_file);
+    }
+    commandStreamDestroy(stream);
     return MTM_SUCCESS;
 }
 
 int main(int argc,char **argv){
-    FILE* input_file;
-    FILE* output_file;//will receive the relevant output and input files
+    FILE* input_file = stdin;
+    FILE* output_file = stdout;//will receive the relevant output and input files
     MtmErrorCode errorCode;//will receive all error codes from program run
     CourseManager courseManager;//will create course manager
-    int input_flag = 0, output_flag = 0;
-    courseManagerCreate(&courseManager);
-    if(courseManager == NULL){
-        mtmPrintErrorMessage(stderr,MTM_OUT_OF_MEMORY);
-        freeNexit(courseManager);
-        return 0;
-    }
-    errorCode = checkCommandLine(argc,argv,&input_flag,&output_flag);
+    int input_flag = 0, output_flag = 0, compile_flag = 0, stream_flag = 0;
+    int load_flag = 0, save_flag = 0, journal_flag = 0;
+    errorCode = checkCommandLine(argc,argv,&input_flag,&output_flag,&compile_flag,
+                                 &stream_flag,&load_flag,&save_flag,&journal_flag);
     if(errorCode != MTM_SUCCESS){
         mtmPrintErrorMessage(stderr,errorCode);
-        freeNexit(courseManager);
         return 0;//exit program
     }
+    if(journal_flag != 0){//start from the saved system and its journal
+        errorCode = courseManagerRecover(argv[load_flag],argv[journal_flag],&courseManager);
+    } else if(load_flag != 0){//start from the saved system
+        errorCode = courseManagerLoad(argv[load_flag],&courseManager);
+    } else {
+        errorCode = courseManagerCreate(&courseManager);
+    }
+    if(errorCode != MTM_SUCCESS){
+        mtmPrintErrorMessage(stderr,errorCode);
+        return 0;
+    }
     if(input_flag != 0) {
         input_file = fopen(argv[input_flag], "r");
         if (input_file == NULL) {
@@ -583,39 +709,24 @@ int main(int argc,char **argv){
             return MTM_CANNOT_OPEN_FILE;
         }
     }
+    if(stream_flag != 0){//run a compiled script
+        errorCode = executeStream(courseManager,argv[stream_flag],output_file);
+    } else if(compile_flag != 0){//only compile the script
+        errorCode = compileFile(input_file,argv[compile_flag]);
+    } else {
+        errorCode = readAndExecuteFile(courseManager,input_file,output_file,NULL);
+    }
+    if(errorCode == MTM_SUCCESS && save_flag != 0){
+        errorCode = courseManagerSave(courseManager,argv[save_flag]);
+    }
+    if(errorCode != MTM_SUCCESS){
+        mtmPrintErrorMessage(stderr,errorCode);
+    }
     if(input_flag != 0){
-        if(output_flag != 0){//both are actuall files
-            if(readAndExecuteFile(courseManager,input_file,output_file)!=MTM_SUCCESS){
-                freeNexit(courseManager);
-                fclose(input_file);
-                fclose(output_file);
-                return 0;
-            }
-            fclose(input_file);
-            fclose(output_file);
-        }
-        else{//input is a file and output stdout
-            if(readAndExecuteFile(courseManager,input_file,stdout)!=MTM_SUCCESS){
-                freeNexit(courseManager);
-                fclose(input_file);
-                return 0;
-            }
-            fclose(input_file);
-        }
+        fclose(input_file);
     }
-    else{
-        if(output_flag != 0){//input file is stdin and output file is a file
-            if(readAndExecuteFile(courseManager,stdin,output_file)!=MTM_SUCCESS){
-                freeNexit(courseManager);
-                fclose(output_file);
-                return 0;
-            }
-            fclose(output_file);
-        }
-            if(readAndExecuteFile(courseManager,stdin,stdout)!=MTM_SUCCESS){
-                freeNexit(courseManager);
-                return 0;
-            }
+    if(output_flag != 0){
+        fclose(output_file);
     }
     freeNexit(courseManager);
     return 0;
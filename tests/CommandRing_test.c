@@ -0,0 +1,196 @@
+#define _POSIX_C_SOURCE 200112L//nanosleep
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include "../test_utilities.h"
+#include "../CommandRing.h"
+
+#define CAPACITY 4
+#define MANY_LINES 100000
+#define WAIT_NANOSECONDS 50000000//long enough for a thread that isn't blocked to get on
+
+//a side of the ring running in a thread of its own, counting the entries it passed
+typedef struct RingSide_t {
+    CommandRing ring;
+    int lines;
+    int passed;
+    bool in_order;
+    pthread_mutex_t lock;
+    pthread_t thread;
+} RingSide;
+
+static void waitAWhile(){
+    struct timespec time = {0,WAIT_NANOSECONDS};
+    nanosleep(&time,NULL);
+}
+
+static int getPassed(RingSide* side){
+    pthread_mutex_lock(&side->lock);
+    int passed = side->passed;
+    pthread_mutex_unlock(&side->lock);
+    return passed;
+}
+
+static void* readLines(void* data){
+    RingSide* side = data;
+    for(int i = 0; i < side->lines; i++){
+        CommandLineEntry* entry = commandRingReserve(side->ring);
+        entry->count = i;
+        commandRingPublish(side->ring);
+        pthread_mutex_lock(&side->lock);
+        side->passed++;
+        pthread_mutex_unlock(&side->lock);
+    }
+    commandRingFinish(side->ring);
+    return NULL;
+}
+
+static void* executeLines(void* data){
+    RingSide* side = data;
+    CommandLineEntry* entry;
+    while((entry = commandRingPeek(side->ring)) != NULL){
+        side->in_order = side->in_order && entry->count == getPassed(side);
+        commandRingRelease(side->ring);
+        pthread_mutex_lock(&side->lock);
+        side->passed++;
+        pthread_mutex_unlock(&side->lock);
+    }
+    return NULL;
+}
+
+static bool startSide(RingSide* side, CommandRing ring, int lines, void* (*run)(void*)){
+    side->ring = ring;
+    side->lines = lines;
+    side->passed = 0;
+    side->in_order = true;
+    pthread_mutex_init(&side->lock,NULL);
+    return pthread_create(&side->thread,NULL,run,side) == 0;
+}
+
+static void joinSide(RingSide* side){
+    pthread_join(side->thread,NULL);
+    pthread_mutex_destroy(&side->lock);
+}
+
+//a single thread going around the ring many times gets the lines in order
+static bool testCommandRingWraparound(){
+    CommandRing ring;
+    ASSERT_TEST(commandRingCreate(CAPACITY - 1,&ring) == COMMAND_RING_SUCCESS);
+    int next_read = 0, next_executed = 0;
+    for(int round = 0; round < 1000; round++){
+        //fill up to the capacity (rounded up to a power of 2) without waiting
+        int fill = round % CAPACITY + 1;
+        for(int i = 0; i < fill; i++){
+            CommandLineEntry* entry = commandRingReserve(ring);
+            ASSERT_TEST(entry != NULL);
+            entry->count = next_read++;
+            commandRingPublish(ring);
+        }
+        for(int i = 0; i < fill; i++){
+            CommandLineEntry* entry = commandRingPeek(ring);
+            ASSERT_TEST(entry != NULL && entry->count == next_executed++);
+            commandRingRelease(ring);
+        }
+    }
+    commandRingFinish(ring);
+    ASSERT_TEST(commandRingPeek(ring) == NULL);
+    commandRingDestroy(ring);
+    return true;
+}
+
+//the entries published before the reader finished are still executed,
+//a reserved entry that wasn't published is dropped
+static bool testCommandRingFinish(){
+    CommandRing ring;
+    ASSERT_TEST(commandRingCreate(CAPACITY,&ring) == COMMAND_RING_SUCCESS);
+    for(int i = 0; i < 2; i++){
+        commandRingReserve(ring)->count = i;
+        commandRingPublish(ring);
+    }
+    commandRingReserve(ring)->count = 2;
+    commandRingFinish(ring);
+    for(int i = 0; i < 2; i++){
+        CommandLineEntry* entry = commandRingPeek(ring);
+        ASSERT_TEST(entry != NULL && entry->count == i);
+        commandRingRelease(ring);
+    }
+    ASSERT_TEST(commandRingPeek(ring) == NULL);
+    ASSERT_TEST(commandRingPeek(ring) == NULL);
+    commandRingDestroy(ring);
+    return true;
+}
+
+//a reader on a full ring waits for the executor to release an entry
+static bool testCommandRingBlocksWhenFull(){
+    CommandRing ring;
+    ASSERT_TEST(commandRingCreate(CAPACITY,&ring) == COMMAND_RING_SUCCESS);
+    RingSide reader;
+    ASSERT_TEST(startSide(&reader,ring,CAPACITY + 2,readLines));
+    waitAWhile();
+    ASSERT_TEST(getPassed(&reader) == CAPACITY);
+    for(int i = 0; i < 2; i++){
+        CommandLineEntry* entry = commandRingPeek(ring);
+        ASSERT_TEST(entry != NULL && entry->count == i);
+        commandRingRelease(ring);
+        waitAWhile();
+        ASSERT_TEST(getPassed(&reader) == CAPACITY + i + 1);
+    }
+    joinSide(&reader);
+    for(int i = 2; i < CAPACITY + 2; i++){
+        CommandLineEntry* entry = commandRingPeek(ring);
+        ASSERT_TEST(entry != NULL && entry->count == i);
+        commandRingRelease(ring);
+    }
+    ASSERT_TEST(commandRingPeek(ring) == NULL);
+    commandRingDestroy(ring);
+    return true;
+}
+
+//an executor on an empty ring waits for the reader to publish an entry or finish
+static bool testCommandRingBlocksWhenEmpty(){
+    CommandRing ring;
+    ASSERT_TEST(commandRingCreate(CAPACITY,&ring) == COMMAND_RING_SUCCESS);
+    RingSide executor;
+    ASSERT_TEST(startSide(&executor,ring,0,executeLines));
+    waitAWhile();
+    ASSERT_TEST(getPassed(&executor) == 0);
+    for(int i = 0; i < 3; i++){
+        commandRingReserve(ring)->count = i;
+        //reserved isn't passed on yet
+        waitAWhile();
+        ASSERT_TEST(getPassed(&executor) == i);
+        commandRingPublish(ring);
+        waitAWhile();
+        ASSERT_TEST(getPassed(&executor) == i + 1);
+    }
+    commandRingFinish(ring);
+    joinSide(&executor);
+    ASSERT_TEST(executor.in_order && executor.passed == 3);
+    commandRingDestroy(ring);
+    return true;
+}
+
+//many lines through a small ring, each side in a thread of its own
+static bool testCommandRingThreads(){
+    CommandRing ring;
+    ASSERT_TEST(commandRingCreate(CAPACITY,&ring) == COMMAND_RING_SUCCESS);
+    RingSide reader, executor;
+    ASSERT_TEST(startSide(&executor,ring,0,executeLines));
+    ASSERT_TEST(startSide(&reader,ring,MANY_LINES,readLines));
+    joinSide(&reader);
+    joinSide(&executor);
+    ASSERT_TEST(executor.in_order && executor.passed == MANY_LINES);
+    commandRingDestroy(ring);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testCommandRingWraparound);
+    RUN_TEST(testCommandRingFinish);
+    RUN_TEST(testCommandRingBlocksWhenFull);
+    RUN_TEST(testCommandRingBlocksWhenEmpty);
+    RUN_TEST(testCommandRingThreads);
+    return 0;
+}
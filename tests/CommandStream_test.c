@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../test_utilities.h"
+#include "../CommandStream.h"
+
+#define STREAM_PATH "CommandStream_test.stream"
+#define HEADER_SIZE 24
+#define MANY_COMMANDS 5000
+
+static long fileSize(const char* path){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return -1;
+    }
+    fseek(file,0,SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+//flips a byte of the file in place
+static bool damageFile(const char* path, long place){
+    FILE* file = fopen(path,"r+b");
+    if(file == NULL){
+        return false;
+    }
+    fseek(file,place,SEEK_SET);
+    int byte = fgetc(file);
+    fseek(file,place,SEEK_SET);
+    fputc(byte ^ 0x5a,file);
+    fclose(file);
+    return true;
+}
+
+//cuts the end of the file, as a crash in the middle of a write would
+static bool cutFile(const char* path, long size){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return false;
+    }
+    char* data = malloc(size + 1);
+    bool read = data != NULL && fread(data,1,size,file) == (size_t)size;
+    fclose(file);
+    file = read ? fopen(path,"wb") : NULL;
+    if(file != NULL){
+        read = fwrite(data,1,size,file) == (size_t)size;
+        fclose(file);
+    }
+    free(data);
+    return read && file != NULL;
+}
+
+static bool isSameCommand(const Command* first, const Command* second){
+    if(first->type != second->type){
+        return false;
+    }
+    for(int i = 0; i < commandGetNumbersCount(first->type); i++){
+        if(first->numbers[i] != second->numbers[i]){
+            return false;
+        }
+    }
+    for(int i = 0; i < commandGetStringsCount(first->type); i++){
+        if(strcmp(first->strings[i],second->strings[i]) != 0){
+            return false;
+        }
+    }
+    return true;
+}
+
+//a command of every type, some of them with the same strings
+static Command commands[] = {
+    {COMMAND_STUDENT_ADD,{1234},{"Moshe","Cohen"}},
+    {COMMAND_STUDENT_ADD,{5678},{"Cohen","Moshe"}},
+    {COMMAND_STUDENT_REMOVE,{5678},{NULL}},
+    {COMMAND_STUDENT_LOGIN,{1234},{NULL}},
+    {COMMAND_STUDENT_LOGOUT,{0},{NULL}},
+    {COMMAND_STUDENT_FRIEND_REQUEST,{5678},{NULL}},
+    {COMMAND_STUDENT_HANDLE_REQUEST,{5678,0},{"accept"}},
+    {COMMAND_STUDENT_UNFRIEND,{5678},{NULL}},
+    {COMMAND_GRADE_SHEET_ADD,{1,234118,-100},{"3.5"}},
+    {COMMAND_GRADE_SHEET_REMOVE,{1,234118},{NULL}},
+    {COMMAND_GRADE_SHEET_UPDATE,{234118,100},{NULL}},
+    {COMMAND_REPORT_FULL,{0},{NULL}},
+    {COMMAND_REPORT_CLEAN,{0},{NULL}},
+    {COMMAND_REPORT_BEST,{3},{NULL}},
+    {COMMAND_REPORT_WORST,{0},{NULL}},
+    {COMMAND_REPORT_REFERENCE,{234118,2},{NULL}},
+    {COMMAND_REPORT_FACULTY_REQUEST,{234118},{"register_course"}},
+    {COMMAND_GRADE_SHEET_ADD,{8,104031,0},{""}},
+    {COMMAND_STUDENT_HANDLE_REQUEST,{1234},{"accept"}}
+};
+#define COMMANDS_COUNT (int)(sizeof(commands)/sizeof(commands[0]))
+
+static bool writeCommands(){
+    CommandStream stream;
+    if(commandStreamCreate(STREAM_PATH,&stream) != COMMAND_STREAM_SUCCESS){
+        return false;
+    }
+    bool written = true;
+    for(int i = 0; i < COMMANDS_COUNT && written; i++){
+        written = commandStreamWrite(stream,&commands[i]) == COMMAND_STREAM_SUCCESS;
+    }
+    return commandStreamClose(stream) == COMMAND_STREAM_SUCCESS && written;
+}
+
+static bool testCommandStreamRoundTrip(){
+    ASSERT_TEST(writeCommands());
+    CommandStream stream;
+    ASSERT_TEST(commandStreamLoad(STREAM_PATH,&stream) == COMMAND_STREAM_SUCCESS);
+    Command command;
+    for(int i = 0; i < COMMANDS_COUNT; i++){
+        ASSERT_TEST(commandStreamNext(stream,&command));
+        ASSERT_TEST(isSameCommand(&command,&commands[i]));
+    }
+    ASSERT_TEST(!commandStreamNext(stream,&command));
+    ASSERT_TEST(!commandStreamNext(stream,&command));
+    commandStreamDestroy(stream);
+    remove(STREAM_PATH);
+    return true;
+}
+
+static bool testCommandStreamEmpty(){
+    CommandStream stream;
+    ASSERT_TEST(commandStreamCreate(STREAM_PATH,&stream) == COMMAND_STREAM_SUCCESS);
+    ASSERT_TEST(commandStreamClose(stream) == COMMAND_STREAM_SUCCESS);
+    ASSERT_TEST(fileSize(STREAM_PATH) == HEADER_SIZE);
+    ASSERT_TEST(commandStreamLoad(STREAM_PATH,&stream) == COMMAND_STREAM_SUCCESS);
+    Command command;
+    ASSERT_TEST(!commandStreamNext(stream,&command));
+    commandStreamDestroy(stream);
+    remove(STREAM_PATH);
+    ASSERT_TEST(commandStreamLoad(STREAM_PATH,&stream) == COMMAND_STREAM_CANNOT_OPEN_FILE);
+    return true;
+}
+
+//the strings are kept once, so many commands with the same words stay small
+static bool testCommandStreamMany(){
+    CommandStream stream;
+    ASSERT_TEST(commandStreamCreate(STREAM_PATH,&stream) == COMMAND_STREAM_SUCCESS);
+    char points[16];
+    for(int i = 0; i < MANY_COMMANDS; i++){
+        sprintf(points,"%d.5",i % 10);
+        Command command = {COMMAND_GRADE_SHEET_ADD,{i % 8 + 1,i,i % 101},{points}};
+        ASSERT_TEST(commandStreamWrite(stream,&command) == COMMAND_STREAM_SUCCESS);
+    }
+    ASSERT_TEST(commandStreamClose(stream) == COMMAND_STREAM_SUCCESS);
+    ASSERT_TEST(fileSize(STREAM_PATH) < HEADER_SIZE + MANY_COMMANDS*17 + 100);
+    ASSERT_TEST(commandStreamLoad(STREAM_PATH,&stream) == COMMAND_STREAM_SUCCESS);
+    for(int i = 0; i < MANY_COMMANDS; i++){
+        Command command;
+        ASSERT_TEST(commandStreamNext(stream,&command));
+        sprintf(points,"%d.5",i % 10);
+        Command expected = {COMMAND_GRADE_SHEET_ADD,{i % 8 + 1,i,i % 101},{points}};
+        ASSERT_TEST(isSameCommand(&command,&expected));
+    }
+    commandStreamDestroy(stream);
+    remove(STREAM_PATH);
+    return true;
+}
+
+//a stream cut anywhere isn't loaded at all, instead of running up to the cut
+static bool testCommandStreamCut(){
+    ASSERT_TEST(writeCommands());
+    long size = fileSize(STREAM_PATH);
+    for(long cut = size - 1; cut >= 0; cut--){
+        ASSERT_TEST(cutFile(STREAM_PATH,cut));
+        CommandStream stream;
+        ASSERT_TEST(commandStreamLoad(STREAM_PATH,&stream) == COMMAND_STREAM_BAD_FORMAT);
+    }
+    remove(STREAM_PATH);
+    return true;
+}
+
+static bool testCommandStreamDamaged(){
+    //the magic, the version, the number of commands and of strings, the strings
+    //offset, the type and a string index of the first command, and the length
+    //of the last string (the empty one, so its length is the end of the file)
+    ASSERT_TEST(writeCommands());
+    long size = fileSize(STREAM_PATH);
+    long places[] = {0,3,4,8,12,16,20,HEADER_SIZE,HEADER_SIZE + 5,size - 1};
+    for(int i = 0; i < (int)(sizeof(places)/sizeof(places[0])); i++){
+        ASSERT_TEST(writeCommands());
+        ASSERT_TEST(damageFile(STREAM_PATH,places[i]));
+        CommandStream stream;
+        ASSERT_TEST(commandStreamLoad(STREAM_PATH,&stream) == COMMAND_STREAM_BAD_FORMAT);
+    }
+    //a damaged number is still a number, and is read as it is
+    ASSERT_TEST(writeCommands());
+    ASSERT_TEST(damageFile(STREAM_PATH,HEADER_SIZE + 1));
+    CommandStream stream;
+    ASSERT_TEST(commandStreamLoad(STREAM_PATH,&stream) == COMMAND_STREAM_SUCCESS);
+    Command command;
+    ASSERT_TEST(commandStreamNext(stream,&command));
+    ASSERT_TEST(command.type == COMMAND_STUDENT_ADD && command.numbers[0] == (1234 ^ 0x5a));
+    commandStreamDestroy(stream);
+    remove(STREAM_PATH);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testCommandStreamRoundTrip);
+    RUN_TEST(testCommandStreamEmpty);
+    RUN_TEST(testCommandStreamMany);
+    RUN_TEST(testCommandStreamCut);
+    RUN_TEST(testCommandStreamDamaged);
+    return 0;
+}
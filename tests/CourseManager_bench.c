@@ -0,0 +1,177 @@
+#define _POSIX_C_SOURCE 200112L//clock_gettime and rand_r
+/**
+ * CourseManager_bench - how the throughput of the course manager scales with
+ * the number of threads calling it at once.
+ *
+ * every thread serves the sessions of its own students, and runs a mix of grade
+ * sheet changes, friend requests and reports on them (reports go to /dev/null).
+ * a thread of its own now and then adds a student, logs it in and removes it,
+ * which takes the whole system. the run is repeated for 1, 2, 4, 8 and 16
+ * threads, each on a new system, and the operations per second of every run are
+ * printed with their speedup over a single thread.
+ *
+ * build and run (the speedup needs a machine with as many cores as threads):
+ *   make CourseManager_bench
+ *   ./CourseManager_bench [max threads] [operations per thread] [journal]
+ * with a third argument the changes are also journaled, in CourseManager_bench.journal.
+ * the last results, and where the threads wait, are in CourseManager_bench.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include "../Student.h"
+#include "../CourseManager.h"
+#define  MTM_SUCCESS -1
+
+#define STUDENTS 1024
+#define SESSIONS_PER_THREAD 16
+#define COURSES 50
+#define JOURNAL_PATH "CourseManager_bench.journal"
+#define SNAPSHOT_PATH "CourseManager_bench.snapshot"
+
+typedef struct BenchThread_t {
+    CourseManager courseManager;
+    int number;
+    int threads;
+    int operations;
+    FILE* sink;
+    pthread_t thread;
+} BenchThread;
+
+static void* runSessions(void* data){
+    BenchThread* bench = data;
+    unsigned seed = bench->number*7919 + 1;
+    Session sessions[SESSIONS_PER_THREAD];
+    int count = 0;
+    for(int id = bench->number + 1; id <= STUDENTS && count < SESSIONS_PER_THREAD;
+        id += bench->threads){
+        if(sessionOpen(bench->courseManager,id,&sessions[count]) == MTM_SUCCESS){
+            count++;
+        }
+    }
+    for(int i = 0; i < bench->operations && count > 0; i++){
+        Session session = sessions[rand_r(&seed) % count];
+        int other_id = rand_r(&seed) % STUDENTS + 1;
+        int course_id = rand_r(&seed) % COURSES + 1;
+        switch(rand_r(&seed) % 8){
+            case 0:
+                sessionGradeSheetAdd(session,rand_r(&seed) % 8 + 1,course_id,"3",
+                                     rand_r(&seed) % 101);
+                break;
+            case 1:
+                sessionGradeSheetUpdate(session,course_id,rand_r(&seed) % 101);
+                break;
+            case 2:
+                sessionGradeSheetRemove(session,rand_r(&seed) % 8 + 1,course_id);
+                break;
+            case 3:
+                sessionFriendRequest(session,other_id);
+                break;
+            case 4:
+                sessionHandleRequest(session,other_id,"accept");
+                break;
+            case 5:
+                sessionReportReference(session,bench->sink,course_id,5);
+                break;
+            case 6:
+                sessionReportBest(session,bench->sink,3);
+                break;
+            default://the full report also writes the last name to stdout
+                sessionReportClean(session,bench->sink);
+                break;
+        }
+        //the changes that take the whole system
+        if(bench->number == 0 && i % 1000 == 0){
+            int id = STUDENTS + 1 + i;
+            addStudent(bench->courseManager,id,"Bench","Student");
+            studentLogIn(bench->courseManager,id);
+            studentLogOut(bench->courseManager);
+            removeStudent(bench->courseManager,id);
+        }
+    }
+    for(int i = 0; i < count; i++){
+        sessionClose(sessions[i]);
+    }
+    return NULL;
+}
+
+static double now(){
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC,&time);
+    return time.tv_sec + time.tv_nsec/1e9;
+}
+
+//runs the benchmark with the given number of threads, returns the operations per second
+static double runBench(int threads, int operations, bool journal, FILE* sink){
+    CourseManager courseManager;
+    remove(JOURNAL_PATH);
+    remove(SNAPSHOT_PATH);
+    MtmErrorCode result = journal ?
+            courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) :
+            courseManagerCreate(&courseManager);
+    if(result != MTM_SUCCESS){
+        return -1;
+    }
+    for(int id = 1; id <= STUDENTS; id++){
+        addStudent(courseManager,id,"Bench","Student");
+    }
+    BenchThread* benches = malloc(sizeof(BenchThread)*threads);
+    if(benches == NULL){
+        courseManagerDestroy(courseManager);
+        return -1;
+    }
+    double start = now();
+    int started = 0;
+    for(; started < threads; started++){
+        BenchThread bench = {courseManager,started,threads,operations,sink};
+        benches[started] = bench;
+        if(pthread_create(&benches[started].thread,NULL,runSessions,
+                          &benches[started]) != 0){
+            break;
+        }
+    }
+    for(int i = 0; i < started; i++){
+        pthread_join(benches[i].thread,NULL);
+    }
+    double seconds = now() - start;
+    free(benches);
+    courseManagerDestroy(courseManager);
+    remove(JOURNAL_PATH);
+    remove(JOURNAL_PATH ".old");
+    remove(SNAPSHOT_PATH);
+    if(started < threads){
+        return -1;
+    }
+    return (double)threads*operations/seconds;
+}
+
+int main(int argc, char** argv){
+    int max_threads = argc > 1 ? atoi(argv[1]) : 16;
+    int operations = argc > 2 ? atoi(argv[2]) : 20000;
+    bool journal = argc > 3;
+    FILE* sink = fopen("/dev/null","w");
+    if(max_threads <= 0 || operations <= 0 || sink == NULL){
+        fprintf(stderr,"usage: %s [max threads] [operations per thread] [journal]\n",argv[0]);
+        return 1;
+    }
+    printf("%8s %12s %10s %14s %8s\n","threads","operations","seconds","operations/s","speedup");
+    double single = 0;
+    for(int threads = 1; threads <= max_threads; threads *= 2){
+        double throughput = runBench(threads,operations,journal,sink);
+        if(throughput < 0){
+            fprintf(stderr,"the run with %d threads failed\n",threads);
+            fclose(sink);
+            return 1;
+        }
+        if(threads == 1){
+            single = throughput;
+        }
+        printf("%8d %12d %10.3f %14.0f %8.2f\n",threads,threads*operations,
+               threads*operations/throughput,throughput,throughput/single);
+    }
+    fclose(sink);
+    return 0;
+}
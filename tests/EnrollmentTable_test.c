@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../test_utilities.h"
+#include "../EnrollmentTable.h"
+
+#define MANY_STUDENTS 500
+#define MANY_COURSES 40
+
+//the students of the course are exactly ids[0..count-1], sorted by id
+static bool isCourse(EnrollmentTable table, int course_id, const int* ids, int count){
+    int course_count;
+    const Enrollment* enrollments = enrollmentTableGetCourse(table,course_id,&course_count);
+    if(course_count != count || (count == 0) != (enrollments == NULL)){
+        return false;
+    }
+    for(int i = 0; i < count; i++){
+        if(enrollments[i].student_id != ids[i]){
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool testEnrollmentTableSet(){
+    EnrollmentTable table;
+    ASSERT_TEST(enrollmentTableCreate(&table) == ENROLLMENT_TABLE_SUCCESS);
+    ASSERT_TEST(enrollmentTableGetBestGrade(table,234118,1) == -1);
+    ASSERT_TEST(isCourse(table,234118,NULL,0));
+    ASSERT_TEST(enrollmentTableSet(table,234118,1,80) == ENROLLMENT_TABLE_SUCCESS);
+    ASSERT_TEST(enrollmentTableGetBestGrade(table,234118,1) == 80);
+    ASSERT_TEST(enrollmentTableGetBestGrade(table,234118,2) == -1);
+    ASSERT_TEST(enrollmentTableGetBestGrade(table,234119,1) == -1);
+    //setting again replaces the best grade, a grade of 0 is a grade
+    ASSERT_TEST(enrollmentTableSet(table,234118,1,0) == ENROLLMENT_TABLE_SUCCESS);
+    ASSERT_TEST(enrollmentTableGetBestGrade(table,234118,1) == 0);
+    //a negative grade takes the student out of the course, the course goes with its last student
+    ASSERT_TEST(enrollmentTableSet(table,234118,1,-1) == ENROLLMENT_TABLE_SUCCESS);
+    ASSERT_TEST(enrollmentTableGetBestGrade(table,234118,1) == -1);
+    ASSERT_TEST(isCourse(table,234118,NULL,0));
+    ASSERT_TEST(enrollmentTableSet(table,234118,1,-1) == ENROLLMENT_TABLE_SUCCESS);
+    ASSERT_TEST(enrollmentTableSet(NULL,234118,1,80) == ENROLLMENT_TABLE_NULL_ARGUMENT);
+    enrollmentTableDestroy(table);
+    return true;
+}
+
+static bool testEnrollmentTableSorted(){
+    EnrollmentTable table;
+    ASSERT_TEST(enrollmentTableCreate(&table) == ENROLLMENT_TABLE_SUCCESS);
+    int inserted[] = {50,3,9000,17,1,400};
+    for(int i = 0; i < 6; i++){
+        ASSERT_TEST(enrollmentTableSet(table,104031,inserted[i],inserted[i] % 101) ==
+                    ENROLLMENT_TABLE_SUCCESS);
+    }
+    int sorted[] = {1,3,17,50,400,9000};
+    ASSERT_TEST(isCourse(table,104031,sorted,6));
+    int count;
+    const Enrollment* enrollments = enrollmentTableGetCourse(table,104031,&count);
+    for(int i = 0; i < count; i++){
+        ASSERT_TEST(enrollments[i].best_grade == enrollments[i].student_id % 101);
+    }
+    ASSERT_TEST(enrollmentTableSet(table,104031,17,-1) == ENROLLMENT_TABLE_SUCCESS);
+    int removed[] = {1,3,50,400,9000};
+    ASSERT_TEST(isCourse(table,104031,removed,5));
+    enrollmentTableDestroy(table);
+    return true;
+}
+
+static bool testEnrollmentTableRemoveStudent(){
+    EnrollmentTable table;
+    ASSERT_TEST(enrollmentTableCreate(&table) == ENROLLMENT_TABLE_SUCCESS);
+    for(int course = 1; course <= MANY_COURSES; course++){
+        for(int student = course % 3 + 1; student <= MANY_STUDENTS; student += 3){
+            ASSERT_TEST(enrollmentTableSet(table,course*1000,student,(course + student) % 101) ==
+                        ENROLLMENT_TABLE_SUCCESS);
+        }
+    }
+    for(int student = 1; student <= MANY_STUDENTS; student += 2){
+        enrollmentTableRemoveStudent(table,student);
+    }
+    enrollmentTableRemoveStudent(table,MANY_STUDENTS + 1);
+    for(int course = 1; course <= MANY_COURSES; course++){
+        int count;
+        const Enrollment* enrollments = enrollmentTableGetCourse(table,course*1000,&count);
+        int expected = 0;
+        for(int student = 1; student <= MANY_STUDENTS; student++){
+            bool enrolled = (student - 1) % 3 == course % 3 && student % 2 == 0;
+            int grade = enrollmentTableGetBestGrade(table,course*1000,student);
+            ASSERT_TEST(grade == (enrolled ? (course + student) % 101 : -1));
+            if(enrolled){
+                ASSERT_TEST(expected < count && enrollments[expected].student_id == student);
+                expected++;
+            }
+        }
+        ASSERT_TEST(count == expected);
+    }
+    enrollmentTableDestroy(table);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testEnrollmentTableSet);
+    RUN_TEST(testEnrollmentTableSorted);
+    RUN_TEST(testEnrollmentTableRemoveStudent);
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../test_utilities.h"
+#include "../GradeRanking.h"
+
+#define MANY_ELEMENTS 1000
+
+typedef struct Graded_t {
+    int grade;
+    int tie;
+    int added;//the order it was added in
+} Graded;
+
+//does a come before b in a ranking of the given order
+static bool isBefore(const Graded* a, const Graded* b, GradeRankingOrder order){
+    if(a->grade != b->grade){
+        return order == GRADE_RANKING_DESCENDING ? a->grade > b->grade : a->grade < b->grade;
+    }
+    if(a->tie != b->tie){
+        return a->tie < b->tie;
+    }
+    return a->added < b->added;
+}
+
+//adds the elements, sorts, and checks the ranking holds the first limit of them in order
+static bool isRanked(Graded* elements, int count, GradeRankingOrder order, int ties, int limit){
+    GradeRanking ranking;
+    if(gradeRankingCreate(order,ties,limit,&ranking) != GRADE_RANKING_SUCCESS){
+        return false;
+    }
+    bool ranked = true;
+    for(int i = 0; i < count && ranked; i++){
+        ranked = gradeRankingAdd(ranking,elements[i].grade,elements[i].tie,&elements[i]) ==
+                 GRADE_RANKING_SUCCESS && gradeRankingGetSize(ranking) <= 2*limit;
+    }
+    ranked = ranked && gradeRankingSort(ranking) == GRADE_RANKING_SUCCESS &&
+             gradeRankingGetSize(ranking) == (count < limit ? count : limit);
+    for(int place = 0; ranked && place < gradeRankingGetSize(ranking); place++){
+        Graded* element = gradeRankingGet(ranking,place);
+        //nothing added is before it but the places before it
+        int before = 0;
+        for(int i = 0; i < count; i++){
+            before += isBefore(&elements[i],element,order);
+        }
+        ranked = before == place;
+    }
+    gradeRankingDestroy(ranking);
+    return ranked;
+}
+
+static void fillElements(Graded* elements, int count, int grades, int ties, unsigned seed){
+    for(int i = 0; i < count; i++){
+        seed = seed*1103515245 + 12345;
+        elements[i].grade = (seed >> 8) % grades;
+        elements[i].tie = (seed >> 20) % ties;
+        elements[i].added = i;
+    }
+}
+
+static bool testGradeRankingInvalid(){
+    GradeRanking ranking;
+    ASSERT_TEST(gradeRankingCreate(GRADE_RANKING_ASCENDING,0,5,&ranking) ==
+                GRADE_RANKING_INVALID_PARAMETERS);
+    ASSERT_TEST(gradeRankingCreate(GRADE_RANKING_ASCENDING,1,0,&ranking) ==
+                GRADE_RANKING_INVALID_PARAMETERS);
+    ASSERT_TEST(gradeRankingCreate(GRADE_RANKING_ASCENDING,2,5,&ranking) == GRADE_RANKING_SUCCESS);
+    int element = 0;
+    ASSERT_TEST(gradeRankingAdd(ranking,-1,0,&element) == GRADE_RANKING_INVALID_PARAMETERS);
+    ASSERT_TEST(gradeRankingAdd(ranking,101,0,&element) == GRADE_RANKING_INVALID_PARAMETERS);
+    ASSERT_TEST(gradeRankingAdd(ranking,50,2,&element) == GRADE_RANKING_INVALID_PARAMETERS);
+    ASSERT_TEST(gradeRankingAdd(ranking,50,-1,&element) == GRADE_RANKING_INVALID_PARAMETERS);
+    ASSERT_TEST(gradeRankingGetSize(ranking) == 0);
+    ASSERT_TEST(gradeRankingSort(ranking) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingGet(ranking,0) == NULL);
+    ASSERT_TEST(gradeRankingAdd(ranking,0,1,&element) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingAdd(ranking,100,0,&element) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingGet(ranking,2) == NULL);
+    ASSERT_TEST(gradeRankingGet(ranking,-1) == NULL);
+    ASSERT_TEST(gradeRankingGetSize(NULL) == -1);
+    ASSERT_TEST(gradeRankingAdd(NULL,50,0,&element) == GRADE_RANKING_INVALID_PARAMETERS);
+    gradeRankingDestroy(ranking);
+    return true;
+}
+
+static bool testGradeRankingOrder(){
+    Graded elements[] = {{70,0,0},{90,0,1},{70,0,2},{100,0,3},{0,0,4},{90,0,5}};
+    GradeRanking ranking;
+    ASSERT_TEST(gradeRankingCreate(GRADE_RANKING_DESCENDING,1,10,&ranking) ==
+                GRADE_RANKING_SUCCESS);
+    for(int i = 0; i < 6; i++){
+        ASSERT_TEST(gradeRankingAdd(ranking,elements[i].grade,0,&elements[i]) ==
+                    GRADE_RANKING_SUCCESS);
+    }
+    ASSERT_TEST(gradeRankingSort(ranking) == GRADE_RANKING_SUCCESS);
+    int descending[] = {3,1,5,0,2,4};
+    for(int place = 0; place < 6; place++){
+        ASSERT_TEST(gradeRankingGet(ranking,place) == &elements[descending[place]]);
+    }
+    gradeRankingDestroy(ranking);
+    //ascending keeps the order of addition within a grade too, it isn't the reverse
+    ASSERT_TEST(gradeRankingCreate(GRADE_RANKING_ASCENDING,1,10,&ranking) ==
+                GRADE_RANKING_SUCCESS);
+    for(int i = 0; i < 6; i++){
+        ASSERT_TEST(gradeRankingAdd(ranking,elements[i].grade,0,&elements[i]) ==
+                    GRADE_RANKING_SUCCESS);
+    }
+    ASSERT_TEST(gradeRankingSort(ranking) == GRADE_RANKING_SUCCESS);
+    int ascending[] = {4,0,2,1,5,3};
+    for(int place = 0; place < 6; place++){
+        ASSERT_TEST(gradeRankingGet(ranking,place) == &elements[ascending[place]]);
+    }
+    gradeRankingDestroy(ranking);
+    return true;
+}
+
+static bool testGradeRankingTies(){
+    //the same grade is ordered by tie group, and within it by the order of addition
+    Graded elements[] = {{80,2,0},{80,0,1},{80,1,2},{80,0,3},{95,2,4},{80,2,5}};
+    GradeRanking ranking;
+    ASSERT_TEST(gradeRankingCreate(GRADE_RANKING_DESCENDING,3,10,&ranking) ==
+                GRADE_RANKING_SUCCESS);
+    for(int i = 0; i < 6; i++){
+        ASSERT_TEST(gradeRankingAdd(ranking,elements[i].grade,elements[i].tie,&elements[i]) ==
+                    GRADE_RANKING_SUCCESS);
+    }
+    ASSERT_TEST(gradeRankingSort(ranking) == GRADE_RANKING_SUCCESS);
+    int expected[] = {4,1,3,2,0,5};
+    for(int place = 0; place < 6; place++){
+        ASSERT_TEST(gradeRankingGet(ranking,place) == &elements[expected[place]]);
+    }
+    gradeRankingDestroy(ranking);
+    Graded many[MANY_ELEMENTS];
+    fillElements(many,MANY_ELEMENTS,5,4,7);
+    ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_ASCENDING,4,MANY_ELEMENTS));
+    ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_DESCENDING,4,MANY_ELEMENTS));
+    return true;
+}
+
+//the ranking is cut to its limit every time it reaches twice the limit,
+//the first places must be the same as if it was never cut
+static bool testGradeRankingCut(){
+    Graded many[MANY_ELEMENTS];
+    int limits[] = {1,2,3,7,64,MANY_ELEMENTS/2 - 1,MANY_ELEMENTS/2,MANY_ELEMENTS};
+    for(int i = 0; i < 8; i++){
+        fillElements(many,MANY_ELEMENTS,101,1,limits[i]);
+        ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_DESCENDING,1,limits[i]));
+        ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_ASCENDING,1,limits[i]));
+        fillElements(many,MANY_ELEMENTS,3,3,limits[i]);
+        ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_DESCENDING,3,limits[i]));
+        ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_ASCENDING,3,limits[i]));
+    }
+    //the best elements come last, after many cuts
+    for(int i = 0; i < MANY_ELEMENTS; i++){
+        many[i].grade = i / 10;
+        many[i].tie = 0;
+        many[i].added = i;
+    }
+    ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_DESCENDING,1,5));
+    ASSERT_TEST(isRanked(many,MANY_ELEMENTS,GRADE_RANKING_ASCENDING,1,5));
+    //a sorted ranking can be added to and sorted again
+    GradeRanking ranking;
+    ASSERT_TEST(gradeRankingCreate(GRADE_RANKING_DESCENDING,1,2,&ranking) ==
+                GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingAdd(ranking,50,0,&many[0]) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingAdd(ranking,60,0,&many[1]) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingAdd(ranking,40,0,&many[2]) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingSort(ranking) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingGetSize(ranking) == 2);
+    ASSERT_TEST(gradeRankingAdd(ranking,55,0,&many[3]) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingSort(ranking) == GRADE_RANKING_SUCCESS);
+    ASSERT_TEST(gradeRankingGet(ranking,0) == &many[1]);
+    ASSERT_TEST(gradeRankingGet(ranking,1) == &many[3]);
+    ASSERT_TEST(gradeRankingGetSize(ranking) == 2);
+    gradeRankingDestroy(ranking);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testGradeRankingInvalid);
+    RUN_TEST(testGradeRankingOrder);
+    RUN_TEST(testGradeRankingTies);
+    RUN_TEST(testGradeRankingCut);
+    return 0;
+}
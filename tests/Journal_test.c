@@ -0,0 +1,333 @@
+#define _POSIX_C_SOURCE 200112L//setrlimit, so writing to the journal fails
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include "../test_utilities.h"
+#include "../CommandStream.h"
+#include "../Journal.h"
+#include "../Student.h"
+#include "../CourseManager.h"
+#define  MTM_SUCCESS -1
+
+#define JOURNAL_PATH "Journal_test.journal"
+#define SNAPSHOT_PATH "Journal_test.snapshot"
+
+static void removeFiles(){
+    remove(JOURNAL_PATH);
+    remove(JOURNAL_PATH ".old");
+    remove(SNAPSHOT_PATH);
+}
+
+static long fileSize(const char* path){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return -1;
+    }
+    fseek(file,0,SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+//flips a byte of the file in place
+static bool damageFile(const char* path, long place){
+    FILE* file = fopen(path,"r+b");
+    if(file == NULL){
+        return false;
+    }
+    fseek(file,place,SEEK_SET);
+    int byte = fgetc(file);
+    fseek(file,place,SEEK_SET);
+    fputc(byte ^ 0x5a,file);
+    fclose(file);
+    return true;
+}
+
+//cuts the end of the file, as a crash in the middle of a write would
+static bool cutFile(const char* path, long size){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return false;
+    }
+    char* data = malloc(size);
+    bool read = data != NULL && fread(data,1,size,file) == (size_t)size;
+    fclose(file);
+    file = read ? fopen(path,"wb") : NULL;
+    if(file != NULL){
+        read = fwrite(data,1,size,file) == (size_t)size;
+        fclose(file);
+    }
+    free(data);
+    return read && file != NULL;
+}
+
+//makes writing past size bytes of any file fail (instead of killing the test)
+static void limitFiles(long size){
+    struct rlimit limit;
+    getrlimit(RLIMIT_FSIZE,&limit);
+    limit.rlim_cur = size < 0 ? limit.rlim_max : (rlim_t)size;
+    setrlimit(RLIMIT_FSIZE,&limit);
+}
+
+static bool appendRemove(Journal journal, int semester, int course_id){
+    Command change = {COMMAND_GRADE_SHEET_REMOVE,{semester,course_id,0},{NULL,NULL}};
+    return journalAppend(journal,7,&change) == JOURNAL_SUCCESS;
+}
+
+static bool testJournalReplay(){
+    removeFiles();
+    Journal journal;
+    ASSERT_TEST(journalCreate(JOURNAL_PATH,5,&journal) == JOURNAL_SUCCESS);
+    Command add = {COMMAND_STUDENT_ADD,{1234,0,0},{"Moshe","Cohen"}};
+    ASSERT_TEST(journalAppend(journal,0,&add) == JOURNAL_SUCCESS);
+    Command grade = {COMMAND_GRADE_SHEET_ADD,{3,234118,95},{"3.5",NULL}};
+    ASSERT_TEST(journalAppend(journal,1234,&grade) == JOURNAL_SUCCESS);
+    ASSERT_TEST(appendRemove(journal,3,234118));
+    ASSERT_TEST(journalGetSize(journal) == 3);
+    journalClose(journal);
+
+    ASSERT_TEST(journalLoad(JOURNAL_PATH,false,&journal) == JOURNAL_SUCCESS);
+    Command change;
+    int student, sequence;
+    ASSERT_TEST(journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(change.type == COMMAND_STUDENT_ADD && student == 0 && sequence == 5);
+    ASSERT_TEST(change.numbers[0] == 1234);
+    ASSERT_TEST(strcmp(change.strings[0],"Moshe") == 0);
+    ASSERT_TEST(strcmp(change.strings[1],"Cohen") == 0);
+    ASSERT_TEST(journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(change.type == COMMAND_GRADE_SHEET_ADD && student == 1234 && sequence == 6);
+    ASSERT_TEST(change.numbers[0] == 3 && change.numbers[1] == 234118);
+    ASSERT_TEST(change.numbers[2] == 95 && strcmp(change.strings[0],"3.5") == 0);
+    ASSERT_TEST(journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(change.type == COMMAND_GRADE_SHEET_REMOVE && student == 7 && sequence == 7);
+    ASSERT_TEST(!journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(!journalIsDamaged(journal));
+    journalDestroy(journal);
+    removeFiles();
+    return true;
+}
+
+//a journal of two commands
+static bool writeTwoCommands(){
+    removeFiles();
+    Journal journal;
+    if(journalCreate(JOURNAL_PATH,1,&journal) != JOURNAL_SUCCESS){
+        return false;
+    }
+    bool written = appendRemove(journal,1,100) && appendRemove(journal,1,200);
+    journalClose(journal);
+    return written;
+}
+
+static bool testJournalCutAtTheEnd(){
+    ASSERT_TEST(writeTwoCommands());
+    long size = fileSize(JOURNAL_PATH);
+    long record = (size - 12)/2;
+    //every cut of the last command leaves only the first one
+    for(long cut = 1; cut < record; cut++){
+        ASSERT_TEST(writeTwoCommands());
+        ASSERT_TEST(cutFile(JOURNAL_PATH,size - cut));
+        Journal journal;
+        ASSERT_TEST(journalLoad(JOURNAL_PATH,false,&journal) == JOURNAL_SUCCESS);
+        Command change;
+        int student, sequence;
+        ASSERT_TEST(journalNext(journal,&change,&student,&sequence));
+        ASSERT_TEST(change.numbers[1] == 100 && sequence == 1);
+        ASSERT_TEST(!journalNext(journal,&change,&student,&sequence));
+        ASSERT_TEST(!journalIsDamaged(journal));
+        journalDestroy(journal);
+    }
+    removeFiles();
+    return true;
+}
+
+static bool testJournalDamaged(){
+    removeFiles();
+    Journal journal;
+    ASSERT_TEST(journalCreate(JOURNAL_PATH,1,&journal) == JOURNAL_SUCCESS);
+    ASSERT_TEST(appendRemove(journal,1,100));
+    ASSERT_TEST(appendRemove(journal,1,200));
+    ASSERT_TEST(appendRemove(journal,1,300));
+    journalClose(journal);
+    //the student of the second command, which a whole command follows
+    long record = (fileSize(JOURNAL_PATH) - 12)/3;
+    ASSERT_TEST(damageFile(JOURNAL_PATH,12 + record + 1));
+    ASSERT_TEST(journalLoad(JOURNAL_PATH,false,&journal) == JOURNAL_SUCCESS);
+    Command change;
+    int student, sequence;
+    ASSERT_TEST(journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(change.numbers[1] == 100);
+    ASSERT_TEST(!journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(journalIsDamaged(journal));
+    journalDestroy(journal);
+    removeFiles();
+    return true;
+}
+
+static bool testJournalFailedAppend(){
+    removeFiles();
+    Journal journal;
+    ASSERT_TEST(journalCreate(JOURNAL_PATH,1,&journal) == JOURNAL_SUCCESS);
+    ASSERT_TEST(appendRemove(journal,1,100));
+    //only part of the next command fits
+    limitFiles(fileSize(JOURNAL_PATH) + 10);
+    ASSERT_TEST(!appendRemove(journal,1,200));
+    limitFiles(-1);
+    //nothing is appended behind the part written, even when there's room again
+    ASSERT_TEST(!appendRemove(journal,1,300));
+    ASSERT_TEST(journalGetSize(journal) == 1);
+    journalClose(journal);
+    ASSERT_TEST(journalLoad(JOURNAL_PATH,false,&journal) == JOURNAL_SUCCESS);
+    Command change;
+    int student, sequence;
+    ASSERT_TEST(journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(change.numbers[1] == 100);
+    ASSERT_TEST(!journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(!journalIsDamaged(journal));
+    journalDestroy(journal);
+    removeFiles();
+    return true;
+}
+
+static bool testJournalRestart(){
+    removeFiles();
+    Journal journal;
+    ASSERT_TEST(journalCreate(JOURNAL_PATH,1,&journal) == JOURNAL_SUCCESS);
+    ASSERT_TEST(appendRemove(journal,1,100));
+    limitFiles(fileSize(JOURNAL_PATH) + 10);
+    ASSERT_TEST(!appendRemove(journal,1,200));
+    limitFiles(-1);
+    ASSERT_TEST(journalRestart(journal,2) == JOURNAL_SUCCESS);
+    ASSERT_TEST(journalGetSize(journal) == 0);
+    ASSERT_TEST(appendRemove(journal,1,300));
+    journalClose(journal);
+    ASSERT_TEST(journalLoad(JOURNAL_PATH,false,&journal) == JOURNAL_SUCCESS);
+    Command change;
+    int student, sequence;
+    ASSERT_TEST(journalNext(journal,&change,&student,&sequence));
+    ASSERT_TEST(change.numbers[1] == 300 && sequence == 2);
+    ASSERT_TEST(!journalNext(journal,&change,&student,&sequence));
+    journalDestroy(journal);
+    removeFiles();
+    return true;
+}
+
+static bool testRecoverReplay(){
+    removeFiles();
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,1234,"Moshe","Cohen") == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,5678,"Dana","Levi") == MTM_SUCCESS);
+    ASSERT_TEST(studentLogIn(courseManager,1234) == MTM_SUCCESS);
+    ASSERT_TEST(studentFriendRequest(courseManager,5678) == MTM_SUCCESS);
+    ASSERT_TEST(removeStudent(courseManager,5678) == MTM_SUCCESS);
+    courseManagerDestroy(courseManager);//the changes are only in the journal
+
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,1234,"Moshe","Cohen") == MTM_STUDENT_ALREADY_EXISTS);
+    ASSERT_TEST(removeStudent(courseManager,5678) == MTM_STUDENT_DOES_NOT_EXIST);
+    ASSERT_TEST(studentLogIn(courseManager,1234) == MTM_ALREADY_LOGGED_IN);
+    courseManagerDestroy(courseManager);
+    removeFiles();
+    return true;
+}
+
+static bool testRecoverDamagedJournal(){
+    removeFiles();
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,1001,"Moshe","Cohen") == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,1002,"Moshe","Cohen") == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,1003,"Moshe","Cohen") == MTM_SUCCESS);
+    courseManagerDestroy(courseManager);
+    long record = (fileSize(JOURNAL_PATH) - 12)/3;
+    ASSERT_TEST(damageFile(JOURNAL_PATH,12 + record + 1));
+    //the third student can't be recovered, so nothing is
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) ==
+                MTM_CANNOT_OPEN_FILE);
+    ASSERT_TEST(courseManager == NULL);
+    removeFiles();
+    return true;
+}
+
+static bool testRecoverFailedAppend(){
+    removeFiles();
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,1,"Moshe","Cohen") == MTM_SUCCESS);
+    //the journal (and the snapshot) fill up in the middle of the changes
+    limitFiles(fileSize(JOURNAL_PATH) + 100);
+    bool added[40] = {false};
+    int failed = 0;
+    for(int id = 2; id < 40; id++){
+        MtmErrorCode result = addStudent(courseManager,id,"Moshe","Cohen");
+        ASSERT_TEST(result == MTM_SUCCESS || result == MTM_CANNOT_OPEN_FILE);
+        added[id] = result == MTM_SUCCESS;
+        failed += !added[id];
+    }
+    limitFiles(-1);
+    ASSERT_TEST(failed > 0);
+    courseManagerDestroy(courseManager);
+    //exactly the students that were added are recovered
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) == MTM_SUCCESS);
+    for(int id = 2; id < 40; id++){
+        ASSERT_TEST((removeStudent(courseManager,id) == MTM_SUCCESS) == added[id]);
+    }
+    courseManagerDestroy(courseManager);
+    removeFiles();
+    return true;
+}
+
+static bool testRecordOnlyChangesMade(){
+    removeFiles();
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,1234,"Moshe","Cohen") == MTM_SUCCESS);
+    ASSERT_TEST(addStudent(courseManager,5678,"Dana","Levi") == MTM_SUCCESS);
+    ASSERT_TEST(studentLogIn(courseManager,1234) == MTM_SUCCESS);
+    ASSERT_TEST(grade_sheet_add(courseManager,1,234118,"3",80) == MTM_SUCCESS);
+    long size = fileSize(JOURNAL_PATH);
+    //the changes that fail change nothing, so they aren't recorded
+    ASSERT_TEST(grade_sheet_remove(courseManager,2,234118) == MTM_COURSE_DOES_NOT_EXIST);
+    ASSERT_TEST(grade_sheet_remove(courseManager,1,234122) == MTM_COURSE_DOES_NOT_EXIST);
+    ASSERT_TEST(grade_sheet_update(courseManager,234122,90) == MTM_COURSE_DOES_NOT_EXIST);
+    ASSERT_TEST(grade_sheet_update(courseManager,234118,101) == MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(studentHandleRequest(courseManager,5678,"accept") == MTM_NOT_REQUESTED);
+    ASSERT_TEST(studentHandleRequest(courseManager,5678,"maybe") == MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(fileSize(JOURNAL_PATH) == size);
+    //an action that isn't valid still drops the request
+    ASSERT_TEST(studentLogOut(courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(studentLogIn(courseManager,5678) == MTM_SUCCESS);
+    ASSERT_TEST(studentFriendRequest(courseManager,1234) == MTM_SUCCESS);
+    ASSERT_TEST(studentLogOut(courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(studentLogIn(courseManager,1234) == MTM_SUCCESS);
+    ASSERT_TEST(grade_sheet_update(courseManager,234118,90) == MTM_SUCCESS);
+    ASSERT_TEST(studentHandleRequest(courseManager,5678,"maybe") == MTM_INVALID_PARAMETERS);
+    courseManagerDestroy(courseManager);
+
+    ASSERT_TEST(courseManagerRecover(SNAPSHOT_PATH,JOURNAL_PATH,&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(studentHandleRequest(courseManager,5678,"accept") == MTM_NOT_REQUESTED);
+    ASSERT_TEST(grade_sheet_update(courseManager,234118,101) == MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(grade_sheet_remove(courseManager,1,234118) == MTM_SUCCESS);
+    ASSERT_TEST(grade_sheet_remove(courseManager,1,234118) == MTM_COURSE_DOES_NOT_EXIST);
+    courseManagerDestroy(courseManager);
+    removeFiles();
+    return true;
+}
+
+int main(){
+    signal(SIGXFSZ,SIG_IGN);//a write past the limit fails instead
+    RUN_TEST(testJournalReplay);
+    RUN_TEST(testJournalCutAtTheEnd);
+    RUN_TEST(testJournalDamaged);
+    RUN_TEST(testJournalFailedAppend);
+    RUN_TEST(testJournalRestart);
+    RUN_TEST(testRecoverReplay);
+    RUN_TEST(testRecoverDamagedJournal);
+    RUN_TEST(testRecoverFailedAppend);
+    RUN_TEST(testRecordOnlyChangesMade);
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../test_utilities.h"
+#include "../Snapshot.h"
+#include "../RequestTable.h"
+
+#define SNAPSHOT_PATH "RequestTable_test.snapshot"
+#define MANY_STUDENTS 300
+
+static bool approveAll(int id_asking, int id_asked, void* data){
+    return true;
+}
+
+//approves only the requests asked of the student data points to
+static bool approveAsked(int id_asking, int id_asked, void* data){
+    return id_asked == *(int*)data;
+}
+
+static bool testRequestTableAddRemove(){
+    RequestTable table;
+    ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(!requestTableContains(table,1,2));
+    ASSERT_TEST(requestTableAdd(table,1,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,1,2) == REQUEST_TABLE_ALREADY_EXISTS);
+    ASSERT_TEST(requestTableContains(table,1,2));
+    //a request has a direction
+    ASSERT_TEST(!requestTableContains(table,2,1));
+    ASSERT_TEST(requestTableAdd(table,2,1) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableRemove(table,1,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableRemove(table,1,2) == REQUEST_TABLE_NOT_EXISTS);
+    ASSERT_TEST(!requestTableContains(table,1,2));
+    ASSERT_TEST(requestTableContains(table,2,1));
+    //a removed request can be made again
+    ASSERT_TEST(requestTableAdd(table,1,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableContains(table,1,2));
+    ASSERT_TEST(requestTableAdd(NULL,1,2) == REQUEST_TABLE_NULL_ARGUMENT);
+    ASSERT_TEST(requestTableRemove(NULL,1,2) == REQUEST_TABLE_NULL_ARGUMENT);
+    ASSERT_TEST(requestTableRemoveStudent(NULL,1) == REQUEST_TABLE_NULL_ARGUMENT);
+    requestTableDestroy(table);
+    return true;
+}
+
+static bool testRequestTableRemoveStudent(){
+    RequestTable table;
+    ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,1,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,3,1) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,2,3) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,4,2) == REQUEST_TABLE_SUCCESS);
+    //the requests the student made and the ones made to him go, the rest stay
+    ASSERT_TEST(requestTableRemoveStudent(table,1) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(!requestTableContains(table,1,2));
+    ASSERT_TEST(!requestTableContains(table,3,1));
+    ASSERT_TEST(requestTableContains(table,2,3));
+    ASSERT_TEST(requestTableContains(table,4,2));
+    ASSERT_TEST(requestTableRemoveStudent(table,1) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableRemoveStudent(table,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(!requestTableContains(table,2,3));
+    ASSERT_TEST(!requestTableContains(table,4,2));
+    //the student can make requests again
+    ASSERT_TEST(requestTableAdd(table,1,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableContains(table,1,2));
+    requestTableDestroy(table);
+    return true;
+}
+
+static bool testRequestTableMany(){
+    RequestTable table;
+    ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+    for(int asking = 1; asking <= MANY_STUDENTS; asking++){
+        for(int asked = asking % 7 + 1; asked <= MANY_STUDENTS; asked += 7){
+            if(asked != asking){
+                ASSERT_TEST(requestTableAdd(table,asking,asked) == REQUEST_TABLE_SUCCESS);
+            }
+        }
+    }
+    for(int student = 1; student <= MANY_STUDENTS; student += 2){
+        ASSERT_TEST(requestTableRemoveStudent(table,student) == REQUEST_TABLE_SUCCESS);
+    }
+    for(int asking = 1; asking <= MANY_STUDENTS; asking++){
+        for(int asked = 1; asked <= MANY_STUDENTS; asked++){
+            bool added = asked != asking && (asked - 1) % 7 == asking % 7;
+            bool removed = asking % 2 == 1 || asked % 2 == 1;
+            ASSERT_TEST(requestTableContains(table,asking,asked) == (added && !removed));
+        }
+    }
+    requestTableDestroy(table);
+    return true;
+}
+
+static bool testRequestTableSaveLoad(){
+    RequestTable table;
+    ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,1,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,3,2) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,2,4) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableAdd(table,5,6) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(requestTableRemove(table,5,6) == REQUEST_TABLE_SUCCESS);
+    Snapshot snapshot;
+    ASSERT_TEST(snapshotCreate(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    requestTableSave(table,snapshot);
+    ASSERT_TEST(snapshotClose(snapshot) == SNAPSHOT_SUCCESS);
+    requestTableDestroy(table);
+
+    ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    ASSERT_TEST(requestTableLoad(table,snapshot,approveAll,NULL) == SNAPSHOT_SUCCESS);
+    ASSERT_TEST(snapshotIsAtEnd(snapshot));
+    snapshotDestroy(snapshot);
+    ASSERT_TEST(requestTableContains(table,1,2));
+    ASSERT_TEST(requestTableContains(table,3,2));
+    ASSERT_TEST(requestTableContains(table,2,4));
+    ASSERT_TEST(!requestTableContains(table,5,6));
+    ASSERT_TEST(!requestTableContains(table,2,1));
+    requestTableDestroy(table);
+
+    //a request the rest of the system doesn't approve fails the load
+    int asked = 2;
+    ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    ASSERT_TEST(requestTableLoad(table,snapshot,approveAsked,&asked) == SNAPSHOT_BAD_FORMAT);
+    snapshotDestroy(snapshot);
+    requestTableDestroy(table);
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+
+//a request of a student to himself, or of an id that isn't positive, isn't loaded
+static bool testRequestTableLoadInvalid(){
+    int requests[][2] = {{7,7},{0,3},{3,-1}};
+    for(int i = 0; i < 3; i++){
+        Snapshot snapshot;
+        ASSERT_TEST(snapshotCreate(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+        snapshotWriteNumber(snapshot,2);
+        snapshotWriteNumber(snapshot,1);
+        snapshotWriteNumber(snapshot,2);
+        snapshotWriteNumber(snapshot,requests[i][0]);
+        snapshotWriteNumber(snapshot,requests[i][1]);
+        ASSERT_TEST(snapshotClose(snapshot) == SNAPSHOT_SUCCESS);
+        RequestTable table;
+        ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+        ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+        ASSERT_TEST(requestTableLoad(table,snapshot,approveAll,NULL) == SNAPSHOT_BAD_FORMAT);
+        snapshotDestroy(snapshot);
+        requestTableDestroy(table);
+    }
+    //a count of more requests than there are
+    Snapshot snapshot;
+    ASSERT_TEST(snapshotCreate(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    snapshotWriteNumber(snapshot,3);
+    snapshotWriteNumber(snapshot,1);
+    snapshotWriteNumber(snapshot,2);
+    ASSERT_TEST(snapshotClose(snapshot) == SNAPSHOT_SUCCESS);
+    RequestTable table;
+    ASSERT_TEST(requestTableCreate(&table) == REQUEST_TABLE_SUCCESS);
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    ASSERT_TEST(requestTableLoad(table,snapshot,approveAll,NULL) == SNAPSHOT_BAD_FORMAT);
+    snapshotDestroy(snapshot);
+    requestTableDestroy(table);
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testRequestTableAddRemove);
+    RUN_TEST(testRequestTableRemoveStudent);
+    RUN_TEST(testRequestTableMany);
+    RUN_TEST(testRequestTableSaveLoad);
+    RUN_TEST(testRequestTableLoadInvalid);
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include "../test_utilities.h"
+#include "../Student.h"
+#include "../CourseManager.h"
+#define  MTM_SUCCESS -1
+
+#define THREADS 4
+#define GRADES_PER_THREAD 200
+#define REPORT_SIZE 4096
+
+//what a report writes, read back from a temporary file
+static bool readReport(FILE* file, char* report){
+    long size = ftell(file);
+    rewind(file);
+    bool read = size >= 0 && size < REPORT_SIZE && fread(report,1,size,file) == (size_t)size;
+    if(read){
+        report[size] = '\0';
+    }
+    fclose(file);
+    return read;
+}
+
+static bool buildSystem(CourseManager courseManager){
+    return addStudent(courseManager,1234,"Moshe","Cohen") == MTM_SUCCESS &&
+           addStudent(courseManager,5678,"Dana","Levi") == MTM_SUCCESS &&
+           addStudent(courseManager,9012,"Avi","Ron") == MTM_SUCCESS;
+}
+
+static bool testSessionOpen(){
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(buildSystem(courseManager));
+    Session session;
+    ASSERT_TEST(sessionOpen(courseManager,4444,&session) == MTM_STUDENT_DOES_NOT_EXIST);
+    ASSERT_TEST(sessionOpen(courseManager,1234,&session) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGetStudentId(session) == 1234);
+    //a session isn't a log in, and doesn't change who's logged in
+    ASSERT_TEST(sessionGradeSheetAdd(session,1,234118,"3",90) == MTM_SUCCESS);
+    ASSERT_TEST(getLoggedInStudentId(courseManager) == -1);
+    ASSERT_TEST(studentLogIn(courseManager,5678) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetUpdate(session,234118,95) == MTM_SUCCESS);
+    ASSERT_TEST(getLoggedInStudentId(courseManager) == 5678);
+    ASSERT_TEST(grade_sheet_update(courseManager,234118,95) == MTM_COURSE_DOES_NOT_EXIST);
+    //two sessions of the same student see the same sheet
+    Session same;
+    ASSERT_TEST(sessionOpen(courseManager,1234,&same) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetRemove(same,1,234118) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetRemove(session,1,234118) == MTM_COURSE_DOES_NOT_EXIST);
+    sessionClose(same);
+    sessionClose(session);
+    sessionClose(NULL);
+    courseManagerDestroy(courseManager);
+    return true;
+}
+
+static bool testSessionFriends(){
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(buildSystem(courseManager));
+    Session moshe, dana;
+    ASSERT_TEST(sessionOpen(courseManager,1234,&moshe) == MTM_SUCCESS);
+    ASSERT_TEST(sessionOpen(courseManager,5678,&dana) == MTM_SUCCESS);
+    ASSERT_TEST(sessionFriendRequest(moshe,4444) == MTM_STUDENT_DOES_NOT_EXIST);
+    ASSERT_TEST(sessionFriendRequest(moshe,5678) == MTM_SUCCESS);
+    ASSERT_TEST(sessionFriendRequest(moshe,5678) == MTM_ALREADY_REQUESTED);
+    ASSERT_TEST(sessionHandleRequest(dana,1234,"maybe") == MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(sessionHandleRequest(dana,9012,"accept") == MTM_NOT_REQUESTED);
+    ASSERT_TEST(sessionFriendRequest(moshe,5678) == MTM_SUCCESS);
+    ASSERT_TEST(sessionHandleRequest(dana,1234,"accept") == MTM_SUCCESS);
+    ASSERT_TEST(sessionFriendRequest(dana,1234) == MTM_ALREADY_FRIEND);
+    ASSERT_TEST(sessionHandleRequest(dana,1234,"accept") == MTM_ALREADY_FRIEND);
+    //the friendship is the same one the logged in student sees
+    ASSERT_TEST(studentLogIn(courseManager,1234) == MTM_SUCCESS);
+    ASSERT_TEST(studentUnFriend(courseManager,5678) == MTM_SUCCESS);
+    ASSERT_TEST(studentLogOut(courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(sessionUnFriend(dana,1234) == MTM_NOT_FRIEND);
+    ASSERT_TEST(sessionUnFriend(dana,4444) == MTM_STUDENT_DOES_NOT_EXIST);
+    sessionClose(moshe);
+    sessionClose(dana);
+    courseManagerDestroy(courseManager);
+    return true;
+}
+
+//a report of a session is the report of the same student logged in
+static bool testSessionReports(){
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(buildSystem(courseManager));
+    Session moshe, dana;
+    ASSERT_TEST(sessionOpen(courseManager,1234,&moshe) == MTM_SUCCESS);
+    ASSERT_TEST(sessionOpen(courseManager,5678,&dana) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetAdd(moshe,1,234118,"3",55) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetAdd(moshe,2,234118,"3",85) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetAdd(moshe,2,104031,"5.5",70) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetAdd(moshe,3,234122,"3",40) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetAdd(dana,1,234118,"3",92) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGradeSheetAdd(moshe,1,234118,"three",92) == MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(sessionFriendRequest(moshe,5678) == MTM_SUCCESS);
+    ASSERT_TEST(sessionHandleRequest(dana,1234,"accept") == MTM_SUCCESS);
+    ASSERT_TEST(sessionReportBest(moshe,stdout,0) == MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(sessionReportWorst(moshe,stdout,-1) == MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(sessionReportFacultyRequest(moshe,stdout,234118,"maybe") ==
+                MTM_INVALID_PARAMETERS);
+    ASSERT_TEST(studentLogIn(courseManager,1234) == MTM_SUCCESS);
+    for(int report = 0; report < 5; report++){
+        FILE* of_session = tmpfile();
+        FILE* logged_in = tmpfile();
+        ASSERT_TEST(of_session != NULL && logged_in != NULL);
+        switch(report){
+            case 0:
+                ASSERT_TEST(sessionReportClean(moshe,of_session) == MTM_SUCCESS);
+                ASSERT_TEST(reportClean(courseManager,logged_in) == MTM_SUCCESS);
+                break;
+            case 1:
+                ASSERT_TEST(sessionReportBest(moshe,of_session,2) == MTM_SUCCESS);
+                ASSERT_TEST(reportBest(courseManager,logged_in,2) == MTM_SUCCESS);
+                break;
+            case 2:
+                ASSERT_TEST(sessionReportWorst(moshe,of_session,3) == MTM_SUCCESS);
+                ASSERT_TEST(reportWorst(courseManager,logged_in,3) == MTM_SUCCESS);
+                break;
+            case 3:
+                ASSERT_TEST(sessionReportReference(moshe,of_session,234118,2) == MTM_SUCCESS);
+                ASSERT_TEST(reportReference(courseManager,logged_in,234118,2) == MTM_SUCCESS);
+                break;
+            default:
+                ASSERT_TEST(sessionReportFacultyRequest(moshe,of_session,234118,
+                                                        "remove_course") == MTM_SUCCESS);
+                ASSERT_TEST(reportFacultyRequest(courseManager,logged_in,234118,
+                                                 "remove_course") == MTM_SUCCESS);
+                break;
+        }
+        char session_report[REPORT_SIZE], logged_in_report[REPORT_SIZE];
+        ASSERT_TEST(readReport(of_session,session_report));
+        ASSERT_TEST(readReport(logged_in,logged_in_report));
+        ASSERT_TEST(strlen(session_report) > 0);
+        ASSERT_TEST(strcmp(session_report,logged_in_report) == 0);
+    }
+    sessionClose(moshe);
+    sessionClose(dana);
+    courseManagerDestroy(courseManager);
+    return true;
+}
+
+//removing the student ends the sessions of the student, and only them
+static bool testSessionStudentRemoved(){
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(buildSystem(courseManager));
+    Session moshe, dana;
+    ASSERT_TEST(sessionOpen(courseManager,1234,&moshe) == MTM_SUCCESS);
+    ASSERT_TEST(sessionOpen(courseManager,5678,&dana) == MTM_SUCCESS);
+    ASSERT_TEST(sessionFriendRequest(moshe,5678) == MTM_SUCCESS);
+    ASSERT_TEST(removeStudent(courseManager,1234) == MTM_SUCCESS);
+    ASSERT_TEST(sessionGetStudentId(moshe) == -1);
+    ASSERT_TEST(sessionGradeSheetAdd(moshe,1,234118,"3",90) == MTM_NOT_LOGGED_IN);
+    ASSERT_TEST(sessionFriendRequest(moshe,5678) == MTM_NOT_LOGGED_IN);
+    ASSERT_TEST(sessionReportClean(moshe,stdout) == MTM_NOT_LOGGED_IN);
+    ASSERT_TEST(sessionReportBest(moshe,stdout,1) == MTM_NOT_LOGGED_IN);
+    ASSERT_TEST(sessionGetStudentId(dana) == 5678);
+    ASSERT_TEST(sessionHandleRequest(dana,1234,"accept") == MTM_STUDENT_DOES_NOT_EXIST);
+    //a student added again with the same id doesn't bring the session back
+    ASSERT_TEST(addStudent(courseManager,1234,"Moshe","Cohen") == MTM_SUCCESS);
+    ASSERT_TEST(sessionGetStudentId(moshe) == -1);
+    ASSERT_TEST(sessionGradeSheetAdd(moshe,1,234118,"3",90) == MTM_NOT_LOGGED_IN);
+    sessionClose(moshe);
+    sessionClose(dana);
+    //a session that is still open when the system is destroyed goes with it
+    ASSERT_TEST(sessionOpen(courseManager,9012,&dana) == MTM_SUCCESS);
+    courseManagerDestroy(courseManager);
+    return true;
+}
+
+typedef struct SessionThread_t {
+    CourseManager courseManager;
+    int student_id;
+    int added;
+    pthread_t thread;
+} SessionThread;
+
+static void* addGrades(void* data){
+    SessionThread* thread = data;
+    Session session;
+    if(sessionOpen(thread->courseManager,thread->student_id,&session) != MTM_SUCCESS){
+        return NULL;
+    }
+    for(int i = 0; i < GRADES_PER_THREAD; i++){
+        thread->added += sessionGradeSheetAdd(session,i % 8 + 1,100000 + i,"3",i % 101) ==
+                         MTM_SUCCESS;
+        //friend requests lock the other student too
+        sessionFriendRequest(session,thread->student_id % THREADS + 1);
+    }
+    sessionClose(session);
+    return NULL;
+}
+
+//sessions of different students change the system at the same time
+static bool testSessionThreads(){
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    SessionThread threads[THREADS];
+    for(int i = 0; i < THREADS; i++){
+        ASSERT_TEST(addStudent(courseManager,i + 1,"Thread","Student") == MTM_SUCCESS);
+    }
+    for(int i = 0; i < THREADS; i++){
+        threads[i].courseManager = courseManager;
+        threads[i].student_id = i + 1;
+        threads[i].added = 0;
+        ASSERT_TEST(pthread_create(&threads[i].thread,NULL,addGrades,&threads[i]) == 0);
+    }
+    for(int i = 0; i < THREADS; i++){
+        pthread_join(threads[i].thread,NULL);
+    }
+    for(int i = 0; i < THREADS; i++){
+        ASSERT_TEST(threads[i].added == GRADES_PER_THREAD);
+        Session session;
+        ASSERT_TEST(sessionOpen(courseManager,i + 1,&session) == MTM_SUCCESS);
+        for(int grade = 0; grade < GRADES_PER_THREAD; grade++){
+            ASSERT_TEST(sessionGradeSheetRemove(session,grade % 8 + 1,100000 + grade) ==
+                        MTM_SUCCESS);
+        }
+        ASSERT_TEST(sessionFriendRequest(session,(i + 1) % THREADS + 1) ==
+                    MTM_ALREADY_REQUESTED);
+        sessionClose(session);
+    }
+    courseManagerDestroy(courseManager);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testSessionOpen);
+    RUN_TEST(testSessionFriends);
+    RUN_TEST(testSessionReports);
+    RUN_TEST(testSessionStudentRemoved);
+    RUN_TEST(testSessionThreads);
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../test_utilities.h"
+#include "../Snapshot.h"
+#include "../Student.h"
+#include "../CourseManager.h"
+#define  MTM_SUCCESS -1
+
+#define SNAPSHOT_PATH "Snapshot_test.snapshot"
+#define SECOND_PATH "Snapshot_test.second"
+#define HEADER_SIZE 8
+
+static long fileSize(const char* path){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return -1;
+    }
+    fseek(file,0,SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+//writes a number over 4 bytes of the file, little endian
+static bool writeAt(const char* path, long place, int number){
+    FILE* file = fopen(path,"r+b");
+    if(file == NULL){
+        return false;
+    }
+    fseek(file,place,SEEK_SET);
+    for(int i = 0; i < 4; i++){
+        fputc((number >> (8*i)) & 0xff,file);
+    }
+    fclose(file);
+    return true;
+}
+
+//cuts the end of the file, as a crash in the middle of a write would
+static bool cutFile(const char* path, long size){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return false;
+    }
+    char* data = malloc(size + 1);
+    bool read = data != NULL && fread(data,1,size,file) == (size_t)size;
+    fclose(file);
+    file = read ? fopen(path,"wb") : NULL;
+    if(file != NULL){
+        read = fwrite(data,1,size,file) == (size_t)size;
+        fclose(file);
+    }
+    free(data);
+    return read && file != NULL;
+}
+
+static bool isSameFile(const char* first_path, const char* second_path){
+    FILE* first = fopen(first_path,"rb");
+    FILE* second = fopen(second_path,"rb");
+    bool same = first != NULL && second != NULL;
+    while(same){
+        int first_byte = fgetc(first), second_byte = fgetc(second);
+        same = first_byte == second_byte;
+        if(first_byte == EOF){
+            break;
+        }
+    }
+    if(first != NULL){
+        fclose(first);
+    }
+    if(second != NULL){
+        fclose(second);
+    }
+    return same;
+}
+
+static bool writeSnapshot(){
+    Snapshot snapshot;
+    if(snapshotCreate(SNAPSHOT_PATH,&snapshot) != SNAPSHOT_SUCCESS){
+        return false;
+    }
+    snapshotWriteNumber(snapshot,0);
+    snapshotWriteNumber(snapshot,-1);
+    snapshotWriteNumber(snapshot,2147483647);
+    snapshotWriteString(snapshot,"Moshe");
+    snapshotWriteString(snapshot,"");
+    snapshotWriteNumber(snapshot,234118);
+    return snapshotClose(snapshot) == SNAPSHOT_SUCCESS;
+}
+
+static bool testSnapshotRoundTrip(){
+    ASSERT_TEST(writeSnapshot());
+    Snapshot snapshot;
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    int number;
+    ASSERT_TEST(snapshotReadNumber(snapshot,&number) && number == 0);
+    ASSERT_TEST(snapshotReadNumber(snapshot,&number) && number == -1);
+    ASSERT_TEST(snapshotReadNumber(snapshot,&number) && number == 2147483647);
+    ASSERT_TEST(strcmp(snapshotReadString(snapshot),"Moshe") == 0);
+    ASSERT_TEST(strcmp(snapshotReadString(snapshot),"") == 0);
+    ASSERT_TEST(!snapshotIsAtEnd(snapshot));
+    ASSERT_TEST(snapshotGetRemaining(snapshot) == 4);
+    ASSERT_TEST(snapshotReadNumber(snapshot,&number) && number == 234118);
+    ASSERT_TEST(snapshotIsAtEnd(snapshot));
+    ASSERT_TEST(!snapshotReadNumber(snapshot,&number));
+    ASSERT_TEST(snapshotReadString(snapshot) == NULL);
+    snapshotDestroy(snapshot);
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+
+static bool testSnapshotBadVersion(){
+    Snapshot snapshot;
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_CANNOT_OPEN_FILE);
+    //an older version, a newer one and a file that isn't a snapshot
+    int versions[] = {SNAPSHOT_VERSION - 1,SNAPSHOT_VERSION + 1,0};
+    for(int i = 0; i < 3; i++){
+        ASSERT_TEST(writeSnapshot());
+        ASSERT_TEST(writeAt(SNAPSHOT_PATH,4,versions[i]));
+        ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_BAD_FORMAT);
+    }
+    ASSERT_TEST(writeSnapshot());
+    ASSERT_TEST(writeAt(SNAPSHOT_PATH,0,0x3e3e3e3e));
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_BAD_FORMAT);
+    ASSERT_TEST(writeSnapshot());
+    ASSERT_TEST(cutFile(SNAPSHOT_PATH,HEADER_SIZE - 1));
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_BAD_FORMAT);
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+
+static bool testSnapshotDamagedString(){
+    Snapshot snapshot;
+    //the string "Moshe" starts after the header and three numbers
+    long length_place = HEADER_SIZE + 12;
+    int lengths[] = {4,6,1000,-1};
+    for(int i = 0; i < 4; i++){
+        ASSERT_TEST(writeSnapshot());
+        ASSERT_TEST(writeAt(SNAPSHOT_PATH,length_place,lengths[i]));
+        ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+        int number;
+        for(int j = 0; j < 3; j++){
+            ASSERT_TEST(snapshotReadNumber(snapshot,&number));
+        }
+        ASSERT_TEST(snapshotReadString(snapshot) == NULL);
+        snapshotDestroy(snapshot);
+    }
+    //cut in the middle of a number
+    ASSERT_TEST(writeSnapshot());
+    ASSERT_TEST(cutFile(SNAPSHOT_PATH,fileSize(SNAPSHOT_PATH) - 1));
+    ASSERT_TEST(snapshotLoad(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    int number;
+    for(int j = 0; j < 3; j++){
+        ASSERT_TEST(snapshotReadNumber(snapshot,&number));
+    }
+    ASSERT_TEST(snapshotReadString(snapshot) != NULL && snapshotReadString(snapshot) != NULL);
+    ASSERT_TEST(!snapshotReadNumber(snapshot,&number));
+    snapshotDestroy(snapshot);
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+
+//a snapshot that can't be written leaves the file before it as it was
+static bool testSnapshotFailedClose(){
+    ASSERT_TEST(writeSnapshot());
+    long size = fileSize(SNAPSHOT_PATH);
+    Snapshot snapshot;
+    ASSERT_TEST(snapshotCreate("no_such_directory/" SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    snapshotWriteNumber(snapshot,1);
+    ASSERT_TEST(snapshotClose(snapshot) == SNAPSHOT_CANNOT_OPEN_FILE);
+    //a snapshot that isn't closed is never written
+    ASSERT_TEST(snapshotCreate(SNAPSHOT_PATH,&snapshot) == SNAPSHOT_SUCCESS);
+    snapshotWriteString(snapshot,"never written");
+    snapshotDestroy(snapshot);
+    ASSERT_TEST(fileSize(SNAPSHOT_PATH) == size);
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+
+static bool buildSystem(CourseManager courseManager){
+    return addStudent(courseManager,1234,"Moshe","Cohen") == MTM_SUCCESS &&
+           addStudent(courseManager,5678,"Dana","Levi") == MTM_SUCCESS &&
+           addStudent(courseManager,9012,"Avi","Ron") == MTM_SUCCESS &&
+           studentLogIn(courseManager,1234) == MTM_SUCCESS &&
+           grade_sheet_add(courseManager,1,234118,"3",55) == MTM_SUCCESS &&
+           grade_sheet_add(courseManager,2,234118,"3",85) == MTM_SUCCESS &&
+           grade_sheet_add(courseManager,2,104031,"5.5",70) == MTM_SUCCESS &&
+           studentFriendRequest(courseManager,5678) == MTM_SUCCESS &&
+           studentFriendRequest(courseManager,9012) == MTM_SUCCESS &&
+           studentLogOut(courseManager) == MTM_SUCCESS &&
+           studentLogIn(courseManager,5678) == MTM_SUCCESS &&
+           studentHandleRequest(courseManager,1234,"accept") == MTM_SUCCESS &&
+           grade_sheet_add(courseManager,1,234118,"3",92) == MTM_SUCCESS &&
+           studentLogOut(courseManager) == MTM_SUCCESS;
+}
+
+static bool testCourseManagerSaveLoad(){
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(buildSystem(courseManager));
+    ASSERT_TEST(courseManagerSave(courseManager,SNAPSHOT_PATH) == MTM_SUCCESS);
+    courseManagerDestroy(courseManager);
+
+    ASSERT_TEST(courseManagerLoad(SNAPSHOT_PATH,&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(courseManagerSave(courseManager,SECOND_PATH) == MTM_SUCCESS);
+    ASSERT_TEST(isSameFile(SNAPSHOT_PATH,SECOND_PATH));
+    //the students, their friends, the pending requests and the grades came back
+    ASSERT_TEST(addStudent(courseManager,1234,"Moshe","Cohen") == MTM_STUDENT_ALREADY_EXISTS);
+    ASSERT_TEST(studentLogIn(courseManager,1234) == MTM_SUCCESS);
+    ASSERT_TEST(studentFriendRequest(courseManager,5678) == MTM_ALREADY_FRIEND);
+    ASSERT_TEST(studentFriendRequest(courseManager,9012) == MTM_ALREADY_REQUESTED);
+    ASSERT_TEST(grade_sheet_remove(courseManager,2,104031) == MTM_SUCCESS);
+    ASSERT_TEST(grade_sheet_remove(courseManager,2,104031) == MTM_COURSE_DOES_NOT_EXIST);
+    ASSERT_TEST(studentLogOut(courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(studentLogIn(courseManager,9012) == MTM_SUCCESS);
+    ASSERT_TEST(studentHandleRequest(courseManager,1234,"accept") == MTM_SUCCESS);
+    courseManagerDestroy(courseManager);
+    remove(SNAPSHOT_PATH);
+    remove(SECOND_PATH);
+    return true;
+}
+
+static bool testCourseManagerLoadBad(){
+    CourseManager courseManager;
+    ASSERT_TEST(courseManagerLoad(SNAPSHOT_PATH,&courseManager) == MTM_CANNOT_OPEN_FILE);
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(buildSystem(courseManager));
+    ASSERT_TEST(courseManagerSave(courseManager,SNAPSHOT_PATH) == MTM_SUCCESS);
+    courseManagerDestroy(courseManager);
+    //a snapshot of an older version isn't loaded
+    ASSERT_TEST(writeAt(SNAPSHOT_PATH,4,SNAPSHOT_VERSION - 1));
+    ASSERT_TEST(courseManagerLoad(SNAPSHOT_PATH,&courseManager) == MTM_CANNOT_OPEN_FILE);
+    //nor a cut one, wherever it was cut
+    ASSERT_TEST(courseManagerCreate(&courseManager) == MTM_SUCCESS);
+    ASSERT_TEST(buildSystem(courseManager));
+    ASSERT_TEST(courseManagerSave(courseManager,SECOND_PATH) == MTM_SUCCESS);
+    courseManagerDestroy(courseManager);
+    for(long cut = fileSize(SECOND_PATH) - 1; cut >= 0; cut--){
+        ASSERT_TEST(cutFile(SECOND_PATH,cut));
+        ASSERT_TEST(courseManagerLoad(SECOND_PATH,&courseManager) == MTM_CANNOT_OPEN_FILE);
+    }
+    remove(SNAPSHOT_PATH);
+    remove(SECOND_PATH);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testSnapshotRoundTrip);
+    RUN_TEST(testSnapshotBadVersion);
+    RUN_TEST(testSnapshotDamagedString);
+    RUN_TEST(testSnapshotFailedClose);
+    RUN_TEST(testCourseManagerSaveLoad);
+    RUN_TEST(testCourseManagerLoadBad);
+    return 0;
+}
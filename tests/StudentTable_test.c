@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../test_utilities.h"
+#include "../Student.h"
+#include "../StudentTable.h"
+
+#define MANY_STUDENTS 1000
+
+static bool insertStudent(StudentTable table, int id){
+    Student student;
+    if(studentCreate(id,"First","Last",&student) != STUDENT_SUCCESS){
+        return false;
+    }
+    StudentTableResult result = studentTableInsert(table,student);
+    if(result != STUDENT_TABLE_SUCCESS){
+        studentDestroy(student);
+    }
+    return result == STUDENT_TABLE_SUCCESS;
+}
+
+//the ids of the table in iteration order are ids[0..count-1]
+static bool isInOrder(StudentTable table, const int* ids, int count){
+    int i = 0;
+    STUDENT_TABLE_FOREACH(student,table){
+        if(i >= count || studentGetStudentId(student) != ids[i]){
+            return false;
+        }
+        i++;
+    }
+    return i == count && studentTableGetSize(table) == count;
+}
+
+static bool testStudentTableInsertFind(){
+    StudentTable table;
+    ASSERT_TEST(studentTableCreate(&table) == STUDENT_TABLE_SUCCESS);
+    ASSERT_TEST(studentTableGetSize(table) == 0);
+    ASSERT_TEST(studentTableGetFirst(table) == NULL);
+    ASSERT_TEST(studentTableFind(table,1234) == NULL);
+    ASSERT_TEST(insertStudent(table,1234));
+    ASSERT_TEST(insertStudent(table,5678));
+    ASSERT_TEST(!insertStudent(table,1234));
+    ASSERT_TEST(studentTableInsert(table,NULL) == STUDENT_TABLE_NULL_ARGUMENT);
+    ASSERT_TEST(studentTableGetSize(table) == 2);
+    ASSERT_TEST(studentGetStudentId(studentTableFind(table,1234)) == 1234);
+    ASSERT_TEST(studentGetStudentId(studentTableFind(table,5678)) == 5678);
+    ASSERT_TEST(studentTableFind(table,9999) == NULL);
+    ASSERT_TEST(studentTableGetSize(NULL) == -1);
+    ASSERT_TEST(studentTableFind(NULL,1234) == NULL);
+    studentTableDestroy(table);
+    return true;
+}
+
+//a removed student leaves a tombstone: the students probed past it must still be found
+static bool testStudentTableTombstones(){
+    StudentTable table;
+    ASSERT_TEST(studentTableCreate(&table) == STUDENT_TABLE_SUCCESS);
+    for(int i = 1; i <= 6; i++){
+        ASSERT_TEST(insertStudent(table,i*1024));
+    }
+    //whichever of them is removed, the others are still found
+    for(int removed = 1; removed <= 6; removed++){
+        ASSERT_TEST(studentTableRemove(table,removed*1024) == STUDENT_TABLE_SUCCESS);
+        for(int i = 1; i <= 6; i++){
+            ASSERT_TEST((studentTableFind(table,i*1024) == NULL) == (i == removed));
+        }
+        ASSERT_TEST(insertStudent(table,removed*1024));
+    }
+    ASSERT_TEST(studentTableRemove(table,2*1024) == STUDENT_TABLE_SUCCESS);
+    ASSERT_TEST(studentTableRemove(table,2*1024) == STUDENT_TABLE_NOT_EXISTS);
+    ASSERT_TEST(studentTableRemove(NULL,1024) == STUDENT_TABLE_NULL_ARGUMENT);
+    ASSERT_TEST(studentTableFind(table,2*1024) == NULL);
+    //the id comes back into the table after the tombstone, once
+    ASSERT_TEST(insertStudent(table,2*1024));
+    ASSERT_TEST(!insertStudent(table,2*1024));
+    ASSERT_TEST(studentTableGetSize(table) == 6);
+    //many removals and insertions fill the table with tombstones and make it rebuild
+    for(int round = 0; round < 50; round++){
+        ASSERT_TEST(studentTableRemove(table,3*1024) == STUDENT_TABLE_SUCCESS);
+        ASSERT_TEST(insertStudent(table,3*1024));
+    }
+    for(int i = 1; i <= 6; i++){
+        ASSERT_TEST(studentGetStudentId(studentTableFind(table,i*1024)) == i*1024);
+    }
+    ASSERT_TEST(studentTableGetSize(table) == 6);
+    studentTableDestroy(table);
+    return true;
+}
+
+static bool testStudentTableRehash(){
+    StudentTable table;
+    ASSERT_TEST(studentTableCreate(&table) == STUDENT_TABLE_SUCCESS);
+    for(int id = 1; id <= MANY_STUDENTS; id++){
+        ASSERT_TEST(insertStudent(table,id*7));
+    }
+    ASSERT_TEST(studentTableGetSize(table) == MANY_STUDENTS);
+    for(int id = 1; id <= MANY_STUDENTS; id++){
+        ASSERT_TEST(studentGetStudentId(studentTableFind(table,id*7)) == id*7);
+        ASSERT_TEST(studentTableFind(table,id*7+1) == NULL);
+    }
+    //removing most of them closes the holes, the rest are still found
+    for(int id = 1; id <= MANY_STUDENTS; id++){
+        if(id % 10 != 0){
+            ASSERT_TEST(studentTableRemove(table,id*7) == STUDENT_TABLE_SUCCESS);
+        }
+    }
+    ASSERT_TEST(studentTableGetSize(table) == MANY_STUDENTS/10);
+    for(int id = 1; id <= MANY_STUDENTS; id++){
+        ASSERT_TEST((studentTableFind(table,id*7) != NULL) == (id % 10 == 0));
+    }
+    studentTableDestroy(table);
+    return true;
+}
+
+static bool testStudentTableOrder(){
+    StudentTable table;
+    ASSERT_TEST(studentTableCreate(&table) == STUDENT_TABLE_SUCCESS);
+    int inserted[] = {50,3,9000,17,1,400};
+    for(int i = 0; i < 6; i++){
+        ASSERT_TEST(insertStudent(table,inserted[i]));
+    }
+    ASSERT_TEST(isInOrder(table,inserted,6));
+    //a removed student is skipped, a student inserted again goes to the end
+    ASSERT_TEST(studentTableRemove(table,50) == STUDENT_TABLE_SUCCESS);
+    ASSERT_TEST(studentTableRemove(table,17) == STUDENT_TABLE_SUCCESS);
+    ASSERT_TEST(insertStudent(table,50));
+    int after_removal[] = {3,9000,1,400,50};
+    ASSERT_TEST(isInOrder(table,after_removal,5));
+    //the order is kept when the holes are closed
+    for(int id = 10000; id < 10000 + MANY_STUDENTS; id++){
+        ASSERT_TEST(insertStudent(table,id));
+    }
+    for(int id = 10000; id < 10000 + MANY_STUDENTS; id++){
+        ASSERT_TEST(studentTableRemove(table,id) == STUDENT_TABLE_SUCCESS);
+    }
+    ASSERT_TEST(isInOrder(table,after_removal,5));
+    ASSERT_TEST(studentTableGetNext(table) == NULL);
+    studentTableDestroy(table);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testStudentTableInsertFind);
+    RUN_TEST(testStudentTableTombstones);
+    RUN_TEST(testStudentTableRehash);
+    RUN_TEST(testStudentTableOrder);
+    return 0;
+}
@@ -0,0 +1,139 @@
+#define _POSIX_C_SOURCE 200112L//clock_gettime and setenv
+/**
+ * mtm_cm_bench - how fast ./mtm_cm reads a script given with -i, which is mapped
+ * and read in place, against the same script given on the standard input, which
+ * is read a line at a time into a buffer.
+ *
+ * a replay script of the given number of lines is written, of many students
+ * logging in and changing their grade sheets, with reports, remarks and blank
+ * lines between, and the same script without the logins, in which the changes
+ * fail at once and reading the lines is most of the work. every way of reading
+ * a script is run once to have the file in the page cache, then the given
+ * number of times, and the best of the runs is printed in lines and megabytes
+ * per second. the output goes to /dev/null.
+ *
+ * build and run (after ./mtm_cm is built):
+ *   make mtm_cm_bench
+ *   ./mtm_cm_bench [lines] [runs] [pipeline]
+ * the pipeline is forced off (MTM_PIPELINE=0) unless a third argument is given,
+ * so both ways of reading go through the same loop.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define SCRIPT_PATH "mtm_cm_bench.script"
+#define STUDENTS 1000
+#define COURSES 200
+
+//writes the replay script, returns its size in bytes or -1. without the logins
+//every change fails at once, so the time is mostly reading and parsing the lines
+static long writeScript(long lines, bool logins){
+    FILE* script = fopen(SCRIPT_PATH,"w");
+    if(script == NULL){
+        return -1;
+    }
+    unsigned seed = 1;
+    for(int id = 1; id <= STUDENTS && id <= lines; id++){
+        fprintf(script,"student add %d Bench%d Student\n",id,id);
+    }
+    for(long line = STUDENTS; line < lines; line++){
+        seed = seed*1103515245 + 12345;
+        unsigned random = seed >> 8;
+        int id = random % STUDENTS + 1;
+        int course_id = 100000 + random % COURSES;
+        switch(random % 10){
+            case 0:
+                //a student logs in only once the one before logged out
+                fprintf(script,"student logout\n");
+                if(logins && ++line < lines){
+                    fprintf(script,"student login %d\n",id);
+                }
+                break;
+            case 1:
+                fprintf(script,"# replayed from the registration of semester %u\n",
+                        random % 8 + 1);
+                break;
+            case 2:
+                fprintf(script,"\n");
+                break;
+            case 3:
+                fprintf(script,"grade_sheet update %d %u\n",course_id,random % 101);
+                break;
+            case 4:
+                fprintf(script,"grade_sheet remove %u %d\n",random % 8 + 1,course_id);
+                break;
+            case 5:
+                fprintf(script,"report reference %d %u\n",course_id,random % 5);
+                break;
+            default:
+                fprintf(script,"grade_sheet add %u %d %u.5 %u\n",random % 8 + 1,
+                        course_id,random % 6,random % 101);
+                break;
+        }
+    }
+    long size = ftell(script);
+    return fclose(script) == 0 ? size : -1;
+}
+
+static double now(){
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC,&time);
+    return time.tv_sec + time.tv_nsec/1e9;
+}
+
+//runs ./mtm_cm on the script, returns the seconds it took or -1
+static double runMtmCm(const char* command){
+    double start = now();
+    if(system(command) != 0){
+        return -1;
+    }
+    return now() - start;
+}
+
+//the best time of the runs, after a run that isn't counted
+static double bestTime(const char* command, int runs){
+    double best = runMtmCm(command);
+    for(int i = 0; i < runs && best >= 0; i++){
+        double seconds = runMtmCm(command);
+        best = seconds < 0 ? -1 : seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+int main(int argc, char** argv){
+    long lines = argc > 1 ? atol(argv[1]) : 1000000;
+    int runs = argc > 2 ? atoi(argv[2]) : 3;
+    bool pipeline = argc > 3;
+    if(lines <= 0 || runs <= 0 || setenv("MTM_PIPELINE",pipeline ? "1" : "0",1) != 0){
+        fprintf(stderr,"usage: %s [lines] [runs] [pipeline]\n",argv[0]);
+        return 1;
+    }
+    const char* names[] = {"-i (mapped)","stdin (read)"};
+    const char* commands[] = {
+            "./mtm_cm -i " SCRIPT_PATH " -o /dev/null 2> /dev/null",
+            "./mtm_cm -o /dev/null < " SCRIPT_PATH " 2> /dev/null"};
+    printf("%ld lines, pipeline %s, best of %d runs\n",lines,pipeline ? "on" : "off",runs);
+    printf("%10s %14s %10s %14s %8s\n","script","input","seconds","lines/s","MB/s");
+    for(int logins = 1; logins >= 0; logins--){
+        long size = writeScript(lines,logins);
+        if(size < 0){
+            fprintf(stderr,"can't write %s\n",SCRIPT_PATH);
+            return 1;
+        }
+        for(int i = 0; i < 2; i++){
+            double seconds = bestTime(commands[i],runs);
+            if(seconds <= 0){
+                fprintf(stderr,"%s failed\n",commands[i]);
+                remove(SCRIPT_PATH);
+                return 1;
+            }
+            printf("%10s %14s %10.3f %14.0f %8.1f\n",logins ? "replay" : "no logins",
+                   names[i],seconds,lines/seconds,size/1e6/seconds);
+        }
+    }
+    remove(SCRIPT_PATH);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#define _POSIX_C_SOURCE 200112L
+/**
+ * mtm_cm_test - runs ./mtm_cm (build it first) on the same script with the
+ * pipeline forced off and on (MTM_PIPELINE), and checks that both runs write
+ * the same standard output, output file and errors.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../test_utilities.h"
+
+#define SCRIPT_PATH "mtm_cm_test.script"
+#define OUTPUT_PATH "mtm_cm_test.output"
+#define STDOUT_PATH "mtm_cm_test.stdout"
+#define STDERR_PATH "mtm_cm_test.stderr"
+#define SCRIPT_ROUNDS 400//rounds of the script, enough lines to go around the ring
+
+static const char* suffixes[] = {".0",".1"};
+
+static void removeFiles(){
+    remove(SCRIPT_PATH);
+    for(int mode = 0; mode < 2; mode++){
+        const char* paths[] = {OUTPUT_PATH,STDOUT_PATH,STDERR_PATH};
+        for(int i = 0; i < 3; i++){
+            char path[64];
+            sprintf(path,"%s%s",paths[i],suffixes[mode]);
+            remove(path);
+        }
+    }
+}
+
+//a script of every command, with valid and invalid arguments, comments and blank lines
+static bool writeScript(){
+    FILE* script = fopen(SCRIPT_PATH,"w");
+    if(script == NULL){
+        return false;
+    }
+    for(int round = 0; round < SCRIPT_ROUNDS; round++){
+        int id = round % 37 + 1;
+        int other_id = round % 41 + 1;
+        int course_id = 234100 + round % 13;
+        fprintf(script,"student add %d First%d Last%d\n",id,id,id);
+        fprintf(script,"student add %d Again Again\n",other_id);
+        fprintf(script,"# round %d\n\n",round);
+        fprintf(script,"student login %d\n",id);
+        fprintf(script,"grade_sheet add %d %d %d.5 %d\n",round % 8 + 1,course_id,
+                round % 5,round % 103);
+        fprintf(script,"grade_sheet add %d %d 3 %d\n",round % 3 + 1,course_id + 1,
+                round % 97);
+        fprintf(script,"grade_sheet update %d %d\n",course_id,round % 110);
+        fprintf(script,"student friend_request %d\n",other_id);
+        fprintf(script,"report reference %d %d\n",course_id,round % 4);
+        fprintf(script,"report full\n");
+        fprintf(script,"student logout\n");
+        fprintf(script,"student login %d\n",other_id);
+        fprintf(script,"student handle_request %d %s\n",id,
+                round % 3 == 0 ? "accept" : round % 3 == 1 ? "reject" : "maybe");
+        fprintf(script,"grade_sheet remove %d %d\n",round % 8 + 1,course_id);
+        fprintf(script,"report best %d\n",round % 5);
+        fprintf(script,"report worst %d\n",round % 4);
+        fprintf(script,"report clean\n");
+        fprintf(script,"report faculty_request %d %s\n",course_id,
+                round % 2 ? "cancel_course" : "register_course");
+        fprintf(script,"student unfriend %d\n",id);
+        fprintf(script,"student logout\n");
+        if(round % 11 == 10){
+            fprintf(script,"student remove %d\n",id);
+        }
+    }
+    return fclose(script) == 0;
+}
+
+//runs ./mtm_cm on the script with the pipeline forced by mode, reading it
+//with -i (mapped) or from the standard input
+static bool runMtmCm(int mode, bool mapped){
+    char command[512];
+    sprintf(command,"MTM_PIPELINE=%d ./mtm_cm %s " SCRIPT_PATH " -o " OUTPUT_PATH "%s"
+            " > " STDOUT_PATH "%s 2> " STDERR_PATH "%s",
+            mode,mapped ? "-i" : "<",suffixes[mode],suffixes[mode],suffixes[mode]);
+    return system(command) == 0;
+}
+
+static bool isSameFile(const char* path){
+    char first_path[64], second_path[64];
+    sprintf(first_path,"%s%s",path,suffixes[0]);
+    sprintf(second_path,"%s%s",path,suffixes[1]);
+    FILE* first = fopen(first_path,"rb");
+    FILE* second = fopen(second_path,"rb");
+    bool same = first != NULL && second != NULL;
+    while(same){
+        int first_byte = fgetc(first), second_byte = fgetc(second);
+        same = first_byte == second_byte;
+        if(first_byte == EOF){
+            break;
+        }
+    }
+    if(first != NULL){
+        fclose(first);
+    }
+    if(second != NULL){
+        fclose(second);
+    }
+    return same;
+}
+
+static long fileSize(const char* path){
+    FILE* file = fopen(path,"rb");
+    if(file == NULL){
+        return -1;
+    }
+    fseek(file,0,SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static bool testSameOutputMapped(){
+    ASSERT_TEST(writeScript());
+    ASSERT_TEST(runMtmCm(0,true));
+    ASSERT_TEST(runMtmCm(1,true));
+    ASSERT_TEST(fileSize(OUTPUT_PATH ".0") > 0);
+    ASSERT_TEST(fileSize(STDERR_PATH ".0") > 0);
+    ASSERT_TEST(isSameFile(OUTPUT_PATH));
+    ASSERT_TEST(isSameFile(STDOUT_PATH));
+    ASSERT_TEST(isSameFile(STDERR_PATH));
+    removeFiles();
+    return true;
+}
+
+static bool testSameOutputRead(){
+    ASSERT_TEST(writeScript());
+    ASSERT_TEST(runMtmCm(0,false));
+    ASSERT_TEST(runMtmCm(1,false));
+    ASSERT_TEST(fileSize(OUTPUT_PATH ".0") > 0);
+    ASSERT_TEST(fileSize(STDERR_PATH ".0") > 0);
+    ASSERT_TEST(isSameFile(OUTPUT_PATH));
+    ASSERT_TEST(isSameFile(STDOUT_PATH));
+    ASSERT_TEST(isSameFile(STDERR_PATH));
+    removeFiles();
+    return true;
+}
+
+int main(){
+    RUN_TEST(testSameOutputMapped);
+    RUN_TEST(testSameOutputRead);
+    return 0;
+}